@@ -0,0 +1,166 @@
+import argparse
+import glob
+import os
+
+# summarizes the decision telemetry of a match.
+#
+# the players write one record per decision cycle into
+# <dir>/<team>-<unum>.telemetry when they are started with --telemetry-dir:
+#
+#   cycle stopped play_on kickable planner_msec chain_count chain_length category
+#
+# each file is streamed line by line and only fixed size counters are kept,
+# so the memory usage does not depend on the match length. the planner time
+# percentiles are computed from a histogram with HIST_STEP resolution.
+
+HIST_STEP = 0.1  # [ms]
+HIST_SIZE = 5000  # the last bin holds all values over HIST_STEP * (HIST_SIZE - 1)
+
+CATEGORIES = ['pre', 'hold', 'dribble', 'pass', 'shoot', 'clear', 'move', 'none']
+
+
+class Stats:
+    def __init__(self, name):
+        self.name = name
+        self.decisions = 0
+        self.play_on = 0
+        self.missed = 0
+        self.searches = 0
+        self.planner_sum = 0.0
+        self.planner_max = 0.0
+        self.planner_hist = [0] * HIST_SIZE
+        self.chain_sum = 0
+        self.chain_max = 0
+        self.kickable = 0
+        self.length_counts = {}
+        self.category_counts = {}
+
+    def add(self, play_on, kickable, msec, chain_count, chain_length, category):
+        self.decisions += 1
+        if play_on:
+            self.play_on += 1
+        if kickable:
+            # the action category mix of the ball holder
+            self.category_counts[category] = self.category_counts.get(category, 0) + 1
+        if category == 'pre':
+            return
+        self.searches += 1
+        self.planner_sum += msec
+        self.planner_max = max(self.planner_max, msec)
+        self.planner_hist[min(int(msec / HIST_STEP), HIST_SIZE - 1)] += 1
+        self.chain_sum += chain_count
+        self.chain_max = max(self.chain_max, chain_count)
+        if kickable:
+            # the chain length is meaningful only when the player can kick
+            self.kickable += 1
+            self.length_counts[chain_length] = self.length_counts.get(chain_length, 0) + 1
+
+    def merge(self, other):
+        self.decisions += other.decisions
+        self.play_on += other.play_on
+        self.missed += other.missed
+        self.searches += other.searches
+        self.planner_sum += other.planner_sum
+        self.planner_max = max(self.planner_max, other.planner_max)
+        self.planner_hist = [a + b for a, b in zip(self.planner_hist, other.planner_hist)]
+        self.chain_sum += other.chain_sum
+        self.chain_max = max(self.chain_max, other.chain_max)
+        self.kickable += other.kickable
+        for k, v in other.length_counts.items():
+            self.length_counts[k] = self.length_counts.get(k, 0) + v
+        for k, v in other.category_counts.items():
+            self.category_counts[k] = self.category_counts.get(k, 0) + v
+
+    def percentile(self, p):
+        if self.searches == 0:
+            return 0.0
+        target = self.searches * p
+        n = 0
+        for i, count in enumerate(self.planner_hist):
+            n += count
+            if n >= target:
+                return (i + 1) * HIST_STEP
+        return self.planner_max
+
+
+def file_order(file_path):
+    # <team>-<unum>.telemetry
+    team, _, unum = os.path.basename(file_path).rsplit('.', 1)[0].rpartition('-')
+    return (team, int(unum) if unum.isdigit() else 0)
+
+
+def read_file(file_path):
+    stats = Stats(os.path.basename(file_path).rsplit('.', 1)[0])
+    last_cycle = -1
+    with open(file_path, 'r') as file:
+        for line in file:
+            if line.startswith('#'):
+                continue
+            row = line.split()
+            if len(row) != 8:
+                continue
+            cycle = int(row[0])
+            play_on = row[2] == '1' and row[1] == '0'
+            stats.add(play_on, row[3] == '1', float(row[4]), int(row[5]), int(row[6]), row[7])
+            if play_on:
+                if last_cycle >= 0 and cycle > last_cycle + 1:
+                    stats.missed += cycle - last_cycle - 1
+                last_cycle = cycle
+            else:
+                last_cycle = -1
+    return stats
+
+
+def print_table(all_stats, total):
+    print('%-16s %7s %7s %6s %9s %9s %9s %9s %8s %8s'
+          % ('player', 'cycles', 'play_on', 'missed', 'plan_avg', 'plan_p50', 'plan_p95', 'plan_max',
+             'eval_avg', 'eval_max'))
+    for s in all_stats + [total]:
+        print('%-16s %7d %7d %6d %9.3f %9.3f %9.3f %9.3f %8.1f %8d'
+              % (s.name, s.decisions, s.play_on, s.missed,
+                 s.planner_sum / s.searches if s.searches > 0 else 0.0,
+                 s.percentile(0.5), s.percentile(0.95), s.planner_max,
+                 s.chain_sum / s.searches if s.searches > 0 else 0.0, s.chain_max))
+
+    print()
+    lengths = sorted(total.length_counts.keys())
+    print('%-16s %8s ' % ('player', 'kickable') + ' '.join('len%-4d' % k for k in lengths))
+    for s in all_stats + [total]:
+        print('%-16s %8d ' % (s.name, s.kickable)
+              + ' '.join('%7d' % s.length_counts.get(k, 0) for k in lengths))
+
+    print()
+    categories = CATEGORIES + sorted(k for k in total.category_counts.keys() if k not in CATEGORIES)
+    print('%-16s ' % 'kickable' + ' '.join('%7s' % c for c in categories))
+    for s in all_stats + [total]:
+        print('%-16s ' % s.name
+              + ' '.join('%7d' % s.category_counts.get(c, 0) for c in categories))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='summarize the decision telemetry written by --telemetry-dir')
+    parser.add_argument('paths', nargs='+', help='telemetry files or directories that contain them')
+    args = parser.parse_args()
+
+    files = []
+    for p in args.paths:
+        if os.path.isdir(p):
+            files += sorted(glob.glob(os.path.join(p, '*.telemetry')), key=file_order)
+        else:
+            files.append(p)
+    if not files:
+        print('no telemetry file found.')
+        return
+
+    total = Stats('total')
+    all_stats = []
+    for f in files:
+        stats = read_file(f)
+        total.merge(stats)
+        all_stats.append(stats)
+
+    print_table(all_stats, total)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,216 @@
+import argparse
+import hashlib
+import json
+import multiprocessing
+import os
+import pathlib
+import random
+import shutil
+import subprocess
+
+import numpy as np
+
+# generates the training data of the unmark model by self-play.
+#
+# each match is run by start-match.sh against its own rcssserver port with
+# its own random seed. the players write the pass decisions as CSV files
+# (--data-extractor-dir), which are converted into a raw float32 shard as
+# soon as the match is finished. finally all shards are deduplicated and
+# shuffled in a streaming pass, and a manifest is written for
+# ReadDataPack.read_manifest().
+
+DTYPE = np.float32
+
+
+def read_csv_header(file_path):
+    with open(file_path, 'r') as file:
+        return file.readline().rstrip('\n').split(',')[:-1]
+
+
+def csv_to_shard(csv_dir, shard_path, batch_rows=10000):
+    # converts all CSV files of one match into one raw shard without loading them at once.
+    columns = None
+    rows = 0
+    with open(shard_path, 'wb') as out:
+        for f in sorted(os.listdir(csv_dir)):
+            if not f.endswith('csv'):
+                continue
+            file_path = os.path.join(csv_dir, f)
+            header = read_csv_header(file_path)
+            if columns is None:
+                columns = header
+            elif header != columns:
+                print('skip', file_path, ': different header')
+                continue
+            batch = []
+            with open(file_path, 'r') as file:
+                file.readline()
+                for line in file:
+                    row = line.split(',')
+                    if len(row) != len(columns):
+                        continue
+                    try:
+                        batch.append([float(r) for r in row])
+                    except ValueError:
+                        continue
+                    if len(batch) >= batch_rows:
+                        np.array(batch, dtype=DTYPE).tofile(out)
+                        rows += len(batch)
+                        batch = []
+            if batch:
+                np.array(batch, dtype=DTYPE).tofile(out)
+                rows += len(batch)
+    return columns, rows
+
+
+def run_match(args):
+    config, match, slot = args
+    seed = config['seed'] + match
+    port = config['port'] + slot * 10
+    match_dir = os.path.join(config['work_dir'], 'match-' + str(seed))
+    csv_dir = os.path.join(match_dir, 'csv')
+    shard_path = os.path.join(config['work_dir'], 'raw', 'raw-' + str(seed) + '.bin')
+    pathlib.Path(csv_dir).mkdir(parents=True, exist_ok=True)
+
+    command = [config['start_match'],
+               '--left', config['team_dir'],
+               '--right', config['opponent_dir'],
+               '--left-name', 'Extract',
+               '--right-name', 'Opponent',
+               '--left-opt', '--data-extractor-dir ' + os.path.abspath(csv_dir),
+               '--port', str(port),
+               '--seed', str(seed),
+               '--games', '1',
+               '--half-time', str(config['half_time']),
+               '--log-dir', match_dir,
+               '--server', config['server']]
+    if config['cpus_per_match'] > 0:
+        # each job owns its own CPU range, like its own port
+        first_cpu = config['first_cpu'] + slot * config['cpus_per_match']
+        command += ['--cpus', str(first_cpu) + '-' + str(first_cpu + config['cpus_per_match'] - 1)]
+    with open(os.path.join(match_dir, 'match.out'), 'w') as out:
+        subprocess.run(command, stdout=out, stderr=subprocess.STDOUT)
+
+    columns, rows = csv_to_shard(csv_dir, shard_path)
+    if not config['keep_csv']:
+        shutil.rmtree(csv_dir, ignore_errors=True)
+    print('match', match, 'seed', seed, 'rows', rows)
+    return shard_path, columns, rows
+
+
+def shuffle_shards(raw_shards, columns, output_dir, rows_per_shard, seed):
+    # pass 1: drop duplicated rows and scatter the rest into random buckets.
+    # pass 2: shuffle each bucket in memory and write it as an output shard.
+    row_bytes = len(columns) * np.dtype(DTYPE).itemsize
+    total_rows = sum(rows for _, rows in raw_shards)
+    bucket_number = max(1, (total_rows + rows_per_shard - 1) // rows_per_shard)
+    rng = random.Random(seed)
+
+    bucket_paths = [os.path.join(output_dir, 'bucket-' + str(b) + '.tmp') for b in range(bucket_number)]
+    buckets = [open(p, 'wb') for p in bucket_paths]
+    seen = set()
+    duplicates = 0
+    for shard_path, rows in raw_shards:
+        with open(shard_path, 'rb') as file:
+            while True:
+                row = file.read(row_bytes)
+                if len(row) < row_bytes:
+                    break
+                key = hashlib.blake2b(row, digest_size=8).digest()
+                if key in seen:
+                    duplicates += 1
+                    continue
+                seen.add(key)
+                buckets[rng.randrange(bucket_number)].write(row)
+    for b in buckets:
+        b.close()
+    del seen
+
+    shards = []
+    np_rng = np.random.default_rng(seed)
+    for b, bucket_path in enumerate(bucket_paths):
+        data = np.fromfile(bucket_path, dtype=DTYPE).reshape(-1, len(columns))
+        np_rng.shuffle(data)
+        name = 'shard-' + str(b).zfill(5) + '.bin'
+        data.tofile(os.path.join(output_dir, name))
+        shards.append({'file': name, 'rows': int(data.shape[0])})
+        os.remove(bucket_path)
+
+    manifest = {'columns': columns,
+                'dtype': np.dtype(DTYPE).str,
+                'rows': sum(s['rows'] for s in shards),
+                'duplicates': duplicates,
+                'seed': seed,
+                'shards': shards}
+    with open(os.path.join(output_dir, 'manifest.json'), 'w') as file:
+        json.dump(manifest, file, indent=1)
+    return manifest
+
+
+def main():
+    parser = argparse.ArgumentParser(description='self-play data generation for the unmark model')
+    parser.add_argument('--team-dir', required=True, help='directory of the team build (contains start.sh)')
+    parser.add_argument('--opponent-dir', default=None, help='directory of the opponent build (default: --team-dir)')
+    parser.add_argument('--start-match', default=None, help='start-match.sh (default: TEAM_DIR/start-match.sh)')
+    parser.add_argument('--server', default='rcssserver')
+    parser.add_argument('--matches', type=int, default=10)
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(), help='the number of parallel matches')
+    parser.add_argument('--seed', type=int, default=1, help='the seed of the first match')
+    parser.add_argument('--port', type=int, default=6000, help='the server port of the first job')
+    parser.add_argument('--half-time', type=int, default=3000)
+    parser.add_argument('--cpus-per-match', type=int, default=0,
+                        help='pin the players of each job to their own CPUs (0: no pinning)')
+    parser.add_argument('--first-cpu', type=int, default=0, help='the first CPU of the first job')
+    parser.add_argument('--rows-per-shard', type=int, default=200000)
+    parser.add_argument('--work-dir', default='./data-work')
+    parser.add_argument('--output-dir', default='./data')
+    parser.add_argument('--keep-csv', action='store_true')
+    args = parser.parse_args()
+
+    config = {'team_dir': os.path.abspath(args.team_dir),
+              'opponent_dir': os.path.abspath(args.opponent_dir if args.opponent_dir else args.team_dir),
+              'start_match': os.path.abspath(args.start_match if args.start_match
+                                             else os.path.join(args.team_dir, 'start-match.sh')),
+              'server': args.server,
+              'seed': args.seed,
+              'port': args.port,
+              'half_time': args.half_time,
+              'cpus_per_match': args.cpus_per_match,
+              'first_cpu': args.first_cpu,
+              'work_dir': os.path.abspath(args.work_dir),
+              'keep_csv': args.keep_csv}
+    pathlib.Path(os.path.join(config['work_dir'], 'raw')).mkdir(parents=True, exist_ok=True)
+    pathlib.Path(args.output_dir).mkdir(parents=True, exist_ok=True)
+
+    # each job keeps its own port, so the number of servers never exceeds --jobs
+    jobs = max(1, min(args.jobs, args.matches))
+    manager = multiprocessing.Manager()
+    slots = manager.Queue()
+    for s in range(jobs):
+        slots.put(s)
+
+    with multiprocessing.Pool(processes=jobs) as pool:
+        results = pool.map(run_slot, [(config, m, slots) for m in range(args.matches)], chunksize=1)
+
+    # all matches run the same build, so the first header is used for all shards
+    columns = next((c for _, c, _ in results if c is not None), None)
+    if columns is None:
+        print('no data was extracted. check', config['work_dir'])
+        return
+    raw_shards = [(p, rows) for p, c, rows in results if c == columns]
+
+    manifest = shuffle_shards(raw_shards, columns, args.output_dir, args.rows_per_shard, args.seed)
+    print('rows', manifest['rows'], 'duplicates', manifest['duplicates'], 'shards', len(manifest['shards']))
+
+
+def run_slot(args):
+    config, match, slots = args
+    slot = slots.get()
+    try:
+        return run_match((config, match, slot))
+    finally:
+        slots.put(slot)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,6 +1,7 @@
 from numpy import array, random
 import numpy as np
 import multiprocessing
+import json
 import os
 
 
@@ -12,6 +13,7 @@ class ReadDataPack:
         self.pack_number = None
         self.counts_file = None
         self.input_data_path = None
+        self.input_manifest_path = None
         self.train_features = None
         self.train_labels = None
         self.test_features = None
@@ -142,13 +144,39 @@ class ReadDataPack:
                   data_y.shape)
         return all_data_x, all_data_y
 
+    def read_manifest(self, manifest_path):
+        # reads the shuffled shards written by generate_data.py
+        with open(manifest_path, 'r') as file:
+            manifest = json.load(file)
+        print(manifest_path)
+        print('shard_numbers', len(manifest['shards']), 'rows', manifest['rows'])
+        columns = manifest['columns']
+        header_name_to_num = {}
+        for c in range(len(columns)):
+            header_name_to_num[columns[c]] = c
+        array_cols = array(self.get_col_x(header_name_to_num))
+        array_cols_numb_y = array(self.get_col_y(header_name_to_num))
+        data_dir = os.path.dirname(manifest_path)
+        all_data_x = []
+        all_data_y = []
+        for shard in manifest['shards']:
+            data = np.fromfile(os.path.join(data_dir, shard['file']), dtype=manifest['dtype'])
+            data = data.reshape(-1, len(columns))
+            all_data_x.append(data[:, array_cols[:]])
+            all_data_y.append(data[:, array_cols_numb_y[:]])
+            del data
+        return np.concatenate(all_data_x, axis=0), np.concatenate(all_data_y, axis=0)
+
     def read_and_separate_data(self):
         self.train_features = None
         self.train_labels = None
         self.test_features = None
         self.test_labels = None
         print('#'*100, 'start reading')
-        data_x, data_y = self.read_files(self.input_data_path)
+        if self.input_manifest_path:
+            data_x, data_y = self.read_manifest(self.input_manifest_path)
+        else:
+            data_x, data_y = self.read_files(self.input_data_path)
         data_size = data_x.shape[0]
         train_size = int(data_size * 0.8)
 
@@ -15,6 +15,8 @@ import pathlib
 from read_data_pack import ReadDataPack
 
 input_data_path = '/home/nader/workspace/robo/Cyrus2DBase/data/'
+# manifest.json written by generate_data.py. input_data_path is used if None.
+input_manifest_path = None
 output_path = './res/'
 rdp = ReadDataPack()
 rdp.data_label = 'unum'
@@ -24,6 +26,7 @@ rdp.pack_number = 20
 rdp.use_cluster = True
 rdp.counts_file = None
 rdp.input_data_path = input_data_path
+rdp.input_manifest_path = input_manifest_path
 model_name = 'cyrus2d'
 pathlib.Path(output_path).mkdir(parents=True, exist_ok=True)
 k_best = 1
@@ -0,0 +1,214 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_model.cpp
+  \brief online opponent model of the coach Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "opponent_model.h"
+
+#include <rcsc/coach/coach_world_model.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/game_mode.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+//! the weight of the new sample. about the last 100 samples are effective.
+const double UPDATE_RATE = 0.01;
+
+//! the number of samples required before broadcasting
+const int MIN_COUNT = 100;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+OpponentModel::OpponentModel()
+    : M_update_time( -1, 0 )
+{
+    for ( int i = 0; i < VALUE_SIZE; ++i )
+    {
+        M_value[i] = 0.0;
+        M_count[i] = 0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OpponentModel::updateValue( const Value v,
+                            const double sample )
+{
+    // plain average until the moving average becomes stable
+    ++M_count[v];
+    const double rate = std::max( UPDATE_RATE, 1.0 / M_count[v] );
+    M_value[v] += ( sample - M_value[v] ) * rate;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+OpponentModel::isReliable() const
+{
+    for ( int i = 0; i < VALUE_SIZE; ++i )
+    {
+        if ( M_count[i] < MIN_COUNT )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OpponentModel::update( const CoachWorldModel & wm )
+{
+    if ( M_update_time == wm.time() )
+    {
+        return;
+    }
+    M_update_time = wm.time();
+
+    if ( wm.gameMode().type() != GameMode::PlayOn )
+    {
+        return;
+    }
+
+    // the coach sees the field in the left team's coordinates
+    const double reverse = ( wm.ourSide() == RIGHT ? -1.0 : 1.0 );
+
+    //
+    // formation
+    //
+    double sum_x = 0.0, sum_y = 0.0;
+    double sum_x2 = 0.0, sum_y2 = 0.0;
+    double line_x = -ServerParam::i().pitchHalfLength();
+    int n = 0;
+
+    for ( const CoachPlayerObject * p : wm.opponents() )
+    {
+        if ( p->goalie() ) continue;
+
+        const double x = p->pos().x * reverse;
+        const double y = p->pos().y * reverse;
+        sum_x += x;
+        sum_y += y;
+        sum_x2 += x * x;
+        sum_y2 += y * y;
+        line_x = std::max( line_x, x );
+        ++n;
+    }
+
+    if ( n > 0 )
+    {
+        const double mean_x = sum_x / n;
+        const double mean_y = sum_y / n;
+        updateValue( CENTROID_X, mean_x );
+        updateValue( CENTROID_Y, mean_y );
+        updateValue( SPREAD_X, std::sqrt( std::max( 0.0, sum_x2 / n - mean_x * mean_x ) ) );
+        updateValue( SPREAD_Y, std::sqrt( std::max( 0.0, sum_y2 / n - mean_y * mean_y ) ) );
+        updateValue( DEFENSE_LINE_X, line_x );
+    }
+
+    //
+    // ball owner side
+    //
+    const Vector2D ball_pos = wm.ball().pos();
+    double mate_dist2 = 1000000.0;
+    double opp_dist2 = 1000000.0;
+    const CoachPlayerObject * nearest_opponent = static_cast< const CoachPlayerObject * >( 0 );
+
+    for ( const CoachPlayerObject * p : wm.teammates() )
+    {
+        mate_dist2 = std::min( mate_dist2, p->pos().dist2( ball_pos ) );
+    }
+
+    for ( const CoachPlayerObject * p : wm.opponents() )
+    {
+        const double d2 = p->pos().dist2( ball_pos );
+        if ( d2 < opp_dist2 )
+        {
+            opp_dist2 = d2;
+            nearest_opponent = p;
+        }
+    }
+
+    //
+    // marking in our possession
+    //
+    if ( mate_dist2 < opp_dist2
+         && ! wm.opponents().empty() )
+    {
+        double sum_dist = 0.0;
+        int n_mate = 0;
+        for ( const CoachPlayerObject * t : wm.teammates() )
+        {
+            if ( t->goalie() ) continue;
+
+            double min_dist2 = 1000000.0;
+            for ( const CoachPlayerObject * o : wm.opponents() )
+            {
+                min_dist2 = std::min( min_dist2, o->pos().dist2( t->pos() ) );
+            }
+            sum_dist += std::sqrt( min_dist2 );
+            ++n_mate;
+        }
+
+        if ( n_mate > 0 )
+        {
+            updateValue( MARK_DIST, sum_dist / n_mate );
+        }
+    }
+
+    //
+    // chase of a moving ball, e.g. our passes
+    //
+    if ( nearest_opponent
+         && wm.ball().vel().r() > 1.0 )
+    {
+        updateValue( CHASE_SPEED, nearest_opponent->vel().r() );
+    }
+}
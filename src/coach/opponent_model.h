@@ -0,0 +1,109 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_model.h
+  \brief online opponent model of the coach Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef OPPONENT_MODEL_H
+#define OPPONENT_MODEL_H
+
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+class CoachWorldModel;
+}
+
+/*!
+  \class OpponentModel
+  \brief constant memory statistics of the opponent team computed from
+  the noise free coach view.
+
+  Each value is an exponential moving average updated in play_on, so the
+  model follows the changes of the opponent tactics without storing any
+  history. All positions are in our team's coordinates.
+ */
+class OpponentModel {
+public:
+
+    /*!
+      \brief the values broadcast to the players, in the message order
+     */
+    enum Value {
+        CENTROID_X,     //!< formation centroid of the field players
+        CENTROID_Y,
+        SPREAD_X,       //!< standard deviation of the field player positions
+        SPREAD_Y,
+        DEFENSE_LINE_X, //!< x of the deepest field player
+        MARK_DIST,      //!< distance from our field players to the nearest opponents in our possession
+        CHASE_SPEED,    //!< speed of the opponent nearest to a moving ball
+        VALUE_SIZE
+    };
+
+private:
+
+    rcsc::GameTime M_update_time;
+
+    double M_value[VALUE_SIZE];
+    //! the number of updates of each value
+    int M_count[VALUE_SIZE];
+
+    // not used
+    OpponentModel( const OpponentModel & );
+    const OpponentModel & operator=( const OpponentModel & );
+public:
+
+    OpponentModel();
+
+    /*!
+      \brief update the statistics. nothing is done except in play_on.
+      \param wm coach world model
+     */
+    void update( const rcsc::CoachWorldModel & wm );
+
+    double value( const Value v ) const
+      {
+          return M_value[v];
+      }
+
+    int count( const Value v ) const
+      {
+          return M_count[v];
+      }
+
+    /*!
+      \brief check if all values have enough samples to be broadcast
+     */
+    bool isReliable() const;
+
+private:
+
+    void updateValue( const Value v,
+                      const double sample );
+};
+
+#endif
@@ -0,0 +1,244 @@
+// -*-c++-*-
+
+/*!
+  \file player_type_assignment.cpp
+  \brief optimal player type assignment Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_type_assignment.h"
+
+#include <rcsc/common/player_type.h>
+#include <rcsc/types.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief minimum cost assignment of n rows to m columns (n <= m).
+  \param cost row major n x m matrix
+  \return the assigned column of each row
+ */
+std::vector< int >
+hungarian( const std::vector< double > & cost,
+           const int n,
+           const int m )
+{
+    const double inf = std::numeric_limits< double >::max();
+
+    // 1-indexed potentials and matching. p[j] is the row matched to column j.
+    std::vector< double > u( n + 1, 0.0 ), v( m + 1, 0.0 );
+    std::vector< int > p( m + 1, 0 ), way( m + 1, 0 );
+
+    for ( int i = 1; i <= n; ++i )
+    {
+        p[0] = i;
+        int j0 = 0;
+        std::vector< double > min_v( m + 1, inf );
+        std::vector< char > used( m + 1, 0 );
+
+        do
+        {
+            used[j0] = 1;
+            const int i0 = p[j0];
+            double delta = inf;
+            int j1 = 0;
+
+            for ( int j = 1; j <= m; ++j )
+            {
+                if ( used[j] ) continue;
+
+                const double cur = cost[( i0 - 1 ) * m + ( j - 1 )] - u[i0] - v[j];
+                if ( cur < min_v[j] )
+                {
+                    min_v[j] = cur;
+                    way[j] = j0;
+                }
+                if ( min_v[j] < delta )
+                {
+                    delta = min_v[j];
+                    j1 = j;
+                }
+            }
+
+            for ( int j = 0; j <= m; ++j )
+            {
+                if ( used[j] )
+                {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                {
+                    min_v[j] -= delta;
+                }
+            }
+
+            j0 = j1;
+        } while ( p[j0] != 0 );
+
+        do
+        {
+            const int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while ( j0 != 0 );
+    }
+
+    std::vector< int > result( n, -1 );
+    for ( int j = 1; j <= m; ++j )
+    {
+        if ( p[j] != 0 )
+        {
+            result[p[j] - 1] = j - 1;
+        }
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief normalize the value into [0, 1] in the range of all candidates
+ */
+double
+normalize( const double value,
+           const double min_value,
+           const double max_value )
+{
+    if ( max_value - min_value < 1.0e-6 )
+    {
+        return 1.0;
+    }
+    return ( value - min_value ) / ( max_value - min_value );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerTypeAssignment::Weight
+PlayerTypeAssignment::role_weight( const int unum )
+{
+    // the former greedy order (11, 2, 3, 10, 9, 6, 4, 5, 7, 8) is kept as
+    // the overall scale of each role.
+    //                    speed accel stamina kickable
+    static const Weight s_weight[12] = {
+        { 0.0, 0.0, 0.0, 0.0 }, // not used
+        { 0.0, 0.0, 0.0, 0.0 }, // goalie. always the default type
+        { 1.0, 0.6, 0.2, 0.4 }, // center back
+        { 1.0, 0.6, 0.2, 0.4 }, // center back
+        { 0.8, 0.3, 0.5, 0.2 }, // side back
+        { 0.8, 0.3, 0.5, 0.2 }, // side back
+        { 0.8, 0.4, 0.5, 0.3 }, // center half
+        { 0.7, 0.3, 0.6, 0.3 }, // defensive half
+        { 0.7, 0.3, 0.6, 0.3 }, // defensive half
+        { 0.9, 0.4, 0.5, 0.2 }, // side half
+        { 0.9, 0.4, 0.5, 0.2 }, // side half
+        { 1.2, 0.6, 0.2, 0.3 }, // center forward
+    };
+
+    if ( unum < 1 || 11 < unum )
+    {
+        return s_weight[0];
+    }
+    return s_weight[unum];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< int >
+PlayerTypeAssignment::solve( const std::vector< int > & unums,
+                             const std::vector< const PlayerType * > & candidates )
+{
+    const int n = static_cast< int >( unums.size() );
+    std::vector< int > result( n, Hetero_Unknown );
+
+    if ( n == 0 || candidates.empty() )
+    {
+        return result;
+    }
+
+    double min_speed = +1000.0, max_speed = -1000.0;
+    double min_accel = +1000.0, max_accel = -1000.0;
+    double min_stamina = +1000.0, max_stamina = -1000.0;
+    double min_kickable = +1000.0, max_kickable = -1000.0;
+
+    for ( const PlayerType * t : candidates )
+    {
+        min_speed = std::min( min_speed, t->realSpeedMax() );
+        max_speed = std::max( max_speed, t->realSpeedMax() );
+        min_accel = std::min( min_accel, -static_cast< double >( t->cyclesToReachMaxSpeed() ) );
+        max_accel = std::max( max_accel, -static_cast< double >( t->cyclesToReachMaxSpeed() ) );
+        min_stamina = std::min( min_stamina, -t->getOneStepStaminaComsumption() );
+        max_stamina = std::max( max_stamina, -t->getOneStepStaminaComsumption() );
+        min_kickable = std::min( min_kickable, t->kickableArea() );
+        max_kickable = std::max( max_kickable, t->kickableArea() );
+    }
+
+    // dummy columns with zero utility when there are not enough candidates
+    const int m = std::max( n, static_cast< int >( candidates.size() ) );
+
+    std::vector< double > cost( n * m, 0.0 );
+    for ( int i = 0; i < n; ++i )
+    {
+        const Weight w = role_weight( unums[i] );
+        for ( size_t j = 0; j < candidates.size(); ++j )
+        {
+            const PlayerType * t = candidates[j];
+            const double utility
+                = w.speed_ * normalize( t->realSpeedMax(), min_speed, max_speed )
+                + w.accel_ * normalize( -t->cyclesToReachMaxSpeed(), min_accel, max_accel )
+                + w.stamina_ * normalize( -t->getOneStepStaminaComsumption(), min_stamina, max_stamina )
+                + w.kickable_ * normalize( t->kickableArea(), min_kickable, max_kickable );
+            // a small positive value so that a real type is preferred over a dummy column
+            cost[i * m + j] = -( utility + 1.0e-3 );
+        }
+    }
+
+    const std::vector< int > col = hungarian( cost, n, m );
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( 0 <= col[i] && col[i] < static_cast< int >( candidates.size() ) )
+        {
+            result[i] = candidates[col[i]]->id();
+        }
+    }
+
+    return result;
+}
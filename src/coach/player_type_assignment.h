@@ -0,0 +1,82 @@
+// -*-c++-*-
+
+/*!
+  \file player_type_assignment.h
+  \brief optimal player type assignment Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef PLAYER_TYPE_ASSIGNMENT_H
+#define PLAYER_TYPE_ASSIGNMENT_H
+
+#include <vector>
+
+namespace rcsc {
+class PlayerType;
+}
+
+/*!
+  \class PlayerTypeAssignment
+  \brief assigns player types to uniform numbers maximizing the sum of
+  the role weighted utilities.
+
+  The candidate list contains each player type as many times as it can
+  be used, so the ptMax limit is a plain one-to-one constraint and the
+  problem is solved exactly by the Hungarian method in O(n^2 m).
+  With at most 11 players and some tens of candidates, a solve takes
+  only microseconds and can be repeated at every dead ball.
+ */
+class PlayerTypeAssignment {
+public:
+
+    /*!
+      \brief the importance of each player type property for a role
+     */
+    struct Weight {
+        double speed_;    //!< real max speed
+        double accel_;    //!< cycles to reach the max speed
+        double stamina_;  //!< stamina consumption to keep the max speed
+        double kickable_; //!< kickable area
+    };
+
+    /*!
+      \brief get the weight of the role of the uniform number
+     */
+    static
+    Weight role_weight( const int unum );
+
+    /*!
+      \brief solve the assignment
+      \param unums uniform numbers to be assigned
+      \param candidates available player types. the same type can appear several times.
+      \return the assigned type id for each of unums. Hetero_Unknown if not assigned.
+     */
+    static
+    std::vector< int > solve( const std::vector< int > & unums,
+                              const std::vector< const rcsc::PlayerType * > & candidates );
+};
+
+#endif
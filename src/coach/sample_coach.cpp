@@ -31,6 +31,7 @@
 #include "sample_coach.h"
 
 #include "sample_freeform_message.h"
+#include "player_type_assignment.h"
 
 #include <rcsc/coach/coach_command.h>
 #include <rcsc/coach/coach_config.h>
@@ -59,24 +60,6 @@
 using namespace rcsc;
 
 
-struct RealSpeedMaxCmp
-    : public std::binary_function< const PlayerType *,
-                                   const PlayerType *,
-                                   bool > {
-
-    result_type operator()( first_argument_type lhs,
-                            second_argument_type rhs ) const
-      {
-          if ( std::fabs( lhs->realSpeedMax() - rhs->realSpeedMax() ) < 0.005 )
-          {
-              return lhs->cyclesToReachMaxSpeed() < rhs->cyclesToReachMaxSpeed();
-          }
-
-          return lhs->realSpeedMax() > rhs->realSpeedMax();
-      }
-
-};
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -219,8 +202,11 @@ SampleCoach::actionImpl()
         sendTeamGraphic();
     }
 
+    M_opponent_model.update( world() );
+
     doSubstitute();
     sayPlayerTypes();
+    sayOpponentModel();
 }
 
 /*-------------------------------------------------------------------*/
@@ -419,6 +405,9 @@ SampleCoach::doFirstSubstitute()
     // change field players
     //
 
+    std::vector< int > field_unum;
+    field_unum.reserve( ordered_unum.size() );
+
     for ( std::vector< int >::iterator unum = ordered_unum.begin();
           unum != ordered_unum.end();
           ++unum )
@@ -435,10 +424,16 @@ SampleCoach::doFirstSubstitute()
             continue;
         }
 
-        int type = getFastestType( candidates );
-        if ( type != Hetero_Unknown )
+        field_unum.push_back( *unum );
+    }
+
+    const std::vector< int > types = PlayerTypeAssignment::solve( field_unum, candidates );
+
+    for ( size_t i = 0; i < field_unum.size(); ++i )
+    {
+        if ( types[i] != Hetero_Unknown )
         {
-            substituteTo( *unum, type );
+            substituteTo( field_unum[i], types[i] );
         }
     }
 }
@@ -524,23 +519,23 @@ SampleCoach::doSubstituteTiredPlayers()
     }
 
     //
-    // try substitution
+    // try substitution.
+    // only the tired players are assigned again. the others keep their types.
     //
 
+    if ( static_cast< int >( tired_teammate_unum.size() )
+         > PlayerParam::i().subsMax() - substitute_count )
+    {
+        tired_teammate_unum.resize( PlayerParam::i().subsMax() - substitute_count );
+    }
 
-    for ( std::vector< int >::iterator unum = tired_teammate_unum.begin();
-          unum != tired_teammate_unum.end();
-          ++unum )
+    const std::vector< int > types = PlayerTypeAssignment::solve( tired_teammate_unum, candidates );
+
+    for ( size_t i = 0; i < tired_teammate_unum.size(); ++i )
     {
-        int type = getFastestType( candidates );
-        if ( type != Hetero_Unknown )
+        if ( types[i] != Hetero_Unknown )
         {
-            substituteTo( *unum, type );
-            if ( ++substitute_count >= PlayerParam::i().subsMax() )
-            {
-                // over the maximum substitution
-                break;
-            }
+            substituteTo( tired_teammate_unum[i], types[i] );
         }
     }
 }
@@ -586,73 +581,6 @@ SampleCoach::substituteTo( const int unum,
               << std::endl;
 }
 
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-int
-SampleCoach::getFastestType( PlayerTypePtrCont & candidates )
-{
-    if ( candidates.empty() )
-    {
-        return Hetero_Unknown;
-    }
-
-    // sort by max speed
-    std::sort( candidates.begin(),
-               candidates.end(),
-               RealSpeedMaxCmp() );
-
-//     std::cerr << "getFastestType candidate = ";
-//     for ( PlayerTypePtrCont::iterator it = candidates.begin();
-//           it != candidates.end();
-//           ++it )
-//     {
-//         std::cerr << (*it)->id() << ' ';
-//     }
-//     std::cerr << std::endl;
-
-    PlayerTypePtrCont::iterator best_type = candidates.end();
-    double max_speed = 0.0;
-    int min_cycle = 100;
-    for ( PlayerTypePtrCont::iterator it = candidates.begin();
-          it != candidates.end();
-          ++it )
-    {
-        if ( (*it)->realSpeedMax() < max_speed - 0.01 )
-        {
-            break;
-        }
-
-        if ( (*it)->cyclesToReachMaxSpeed() < min_cycle )
-        {
-            best_type = it;
-            max_speed = (*best_type)->realSpeedMax();
-            min_cycle = (*best_type)->cyclesToReachMaxSpeed();
-            continue;
-        }
-
-        if ( (*it)->cyclesToReachMaxSpeed() == min_cycle )
-        {
-            if ( (*it)->getOneStepStaminaComsumption()
-                 < (*best_type)->getOneStepStaminaComsumption() )
-            {
-                best_type = it;
-                max_speed = (*best_type)->realSpeedMax();
-            }
-        }
-    }
-
-    if ( best_type != candidates.end() )
-    {
-        int id = (*best_type)->id();
-        candidates.erase( best_type );
-        return id;
-    }
-
-    return Hetero_Unknown;
-}
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -741,6 +669,50 @@ SampleCoach::sayPlayerTypes()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+SampleCoach::sayOpponentModel()
+{
+    /*
+      format:
+      "(om <one character for each OpponentModel::Value>)"
+    */
+
+    static const int SEND_INTERVAL = 300;
+
+    static GameTime s_last_send_time( -SEND_INTERVAL, 0 );
+
+    if ( ! config().useFreeform()
+         || ! world().canSendFreeform()
+         || ! M_opponent_model.isReliable()
+         || world().time().cycle() - s_last_send_time.cycle() < SEND_INTERVAL )
+    {
+        return;
+    }
+
+    std::shared_ptr< FreeformMessage > ptr( new OpponentModelMessage( M_opponent_model ) );
+
+    this->addFreeformMessage( ptr );
+
+    s_last_send_time = world().time();
+
+    std::cout << config().teamName()
+              << " coach: "
+              << world().time()
+              << " sent opponent model:"
+              << " centroid=(" << M_opponent_model.value( OpponentModel::CENTROID_X )
+              << ' ' << M_opponent_model.value( OpponentModel::CENTROID_Y ) << ')'
+              << " spread=(" << M_opponent_model.value( OpponentModel::SPREAD_X )
+              << ' ' << M_opponent_model.value( OpponentModel::SPREAD_Y ) << ')'
+              << " line=" << M_opponent_model.value( OpponentModel::DEFENSE_LINE_X )
+              << " mark=" << M_opponent_model.value( OpponentModel::MARK_DIST )
+              << " chase=" << M_opponent_model.value( OpponentModel::CHASE_SPEED )
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 SampleCoach::sendTeamGraphic()
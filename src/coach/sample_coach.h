@@ -27,6 +27,8 @@
 #ifndef SAMPLE_COACH_H
 #define SAMPLE_COACH_H
 
+#include "opponent_model.h"
+
 #include <rcsc/coach/coach_agent.h>
 #include <rcsc/types.h>
 
@@ -46,6 +48,8 @@ private:
 
     int M_opponent_player_types[11];
 
+    OpponentModel M_opponent_model;
+
     rcsc::TeamGraphic M_team_graphic;
 
 public:
@@ -89,10 +93,10 @@ private:
     void substituteTo( const int unum,
                        const int type );
 
-    int getFastestType( PlayerTypePtrCont & candidates );
-
     void sayPlayerTypes();
 
+    void sayOpponentModel();
+
     void sendTeamGraphic();
 
 };
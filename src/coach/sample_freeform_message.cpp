@@ -35,9 +35,14 @@
 
 #include "sample_freeform_message.h"
 
+#include "opponent_model.h"
+#include "opponent_model_codec.h"
+
 #include <rcsc/common/player_param.h>
 #include <rcsc/types.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 using namespace rcsc;
@@ -158,3 +163,51 @@ OpponentPlayerTypeMessage::printDebug( std::ostream & os ) const
     os << "[PlayerType]";
     return os;
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+OpponentModelMessage::OpponentModelMessage( const OpponentModel & model )
+    : FreeformMessage( "om" )
+{
+    static_assert( OpponentModelCodec::VALUE_SIZE == OpponentModel::VALUE_SIZE,
+                   "OpponentModelCodec does not match OpponentModel::Value" );
+
+    for ( int i = 0; i < OpponentModel::VALUE_SIZE; ++i )
+    {
+        M_message += OpponentModelCodec::encode( i, model.value( static_cast< OpponentModel::Value >( i ) ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+OpponentModelMessage::append( std::string & to ) const
+{
+    if ( M_message.empty() )
+    {
+        return false;
+    }
+
+    to += '(';
+    to += this->type();
+    to += ' ';
+    to += M_message;
+    to += ')';
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+OpponentModelMessage::printDebug( std::ostream & os ) const
+{
+    os << "[OpponentModel]";
+    return os;
+}
@@ -29,6 +29,8 @@
 
 #include <rcsc/common/freeform_message.h>
 
+class OpponentModel;
+
 /*-------------------------------------------------------------------*/
 
 /*!
@@ -110,4 +112,54 @@ public:
     std::ostream & printDebug( std::ostream & os ) const;
 };
 
+/*-------------------------------------------------------------------*/
+
+/*!
+  \class OpponentModelMessage
+  \brief summary of the coach's opponent model.
+
+  format: "(om <values>)"
+  each value of OpponentModel::Value is quantized into one character.
+  the value ranges must be the same as OpponentModelMessageParser.
+*/
+class OpponentModelMessage
+    : public rcsc::FreeformMessage {
+private:
+
+    //! built message string
+    std::string M_message;
+
+public:
+
+    /*!
+      \brief construct with the current model values
+      \param model coach's opponent model
+     */
+    explicit
+    OpponentModelMessage( const OpponentModel & model );
+
+    /*!
+      \brief get the length of this message
+      \return the length of encoded message
+    */
+    int length() const
+      {
+          return M_message.length();
+      }
+
+    /*!
+      \brief append the freeform message to 'to'.
+      \param to reference to the result message string.
+      \return result of message appending.
+    */
+    bool append( std::string & to ) const;
+
+    /*!
+      \brief output a debug message.
+      \param os reference to the output stream.
+      \return reference to the output stream.
+     */
+    std::ostream & printDebug( std::ostream & os ) const;
+};
+
 #endif
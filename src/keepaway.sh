@@ -59,6 +59,9 @@ offline_logging=""
 offline_mode=""
 fullstateopt=""
 
+benchmark_dir=""
+episodes=0
+
 usage()
 {
   (echo "Usage: $0 [options]"
@@ -79,7 +82,9 @@ usage()
    echo "  --log-dir DIRECTORY          specifies debug log directory (default: /tmp)"
    echo "  --debug-log-ext EXTENSION    specifies debug log file extension (default: .log)"
    echo "  --fullstate FULLSTATE_TYPE   specifies fullstate model handling"
-   echo "                               FULLSTATE_TYPE is one of [ignore|reference|override].") 1>&2
+   echo "                               FULLSTATE_TYPE is one of [ignore|reference|override]."
+   echo "  --benchmark-dir DIRECTORY    writes the episode lengths and the keepers' planner load into DIRECTORY"
+   echo "  --episodes NUMBER            finishes the match after NUMBER episodes (default: 0, unlimited)") 1>&2
 }
 
 while [ $# -gt 0 ]
@@ -216,6 +221,24 @@ do
       esac
       ;;
 
+    --benchmark-dir)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      benchmark_dir="${2}"
+      shift 1
+      ;;
+
+    --episodes)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      episodes="${2}"
+      shift 1
+      ;;
+
     *)
       echo 1>&2
       echo "invalid option \"${1}\"." 1>&2
@@ -247,6 +270,14 @@ if [ X"${debug_server_port}" = X'' ]; then
   debug_server_port=`expr ${port} + 32`
 fi
 
+keeper_opt=""
+trainer_opt="--keepaway-episodes ${episodes}"
+if [ X"${benchmark_dir}" != X'' ]; then
+  mkdir -p "${benchmark_dir}" || exit 1
+  keeper_opt="--keepaway-benchmark-dir ${benchmark_dir}"
+  trainer_opt="${trainer_opt} --keepaway-benchmark-dir ${benchmark_dir}"
+fi
+
 opt="--player-config ${player_conf}"
 opt="${opt} -h ${host} -p ${port}"
 opt="${opt} ${fullstateopt}"
@@ -262,7 +293,7 @@ while [ $i -le 3 ] ; do
     offline_number="--offline_client_number ${i}"
   fi
 
-  $player ${opt} -t ${keeper_teamname} --config_dir ${keeper_config_dir} ${offline_number} &
+  $player ${opt} -t ${keeper_teamname} --config_dir ${keeper_config_dir} ${keeper_opt} ${offline_number} &
   $sleepprog $sleeptime
   i=`expr $i + 1`
 done
@@ -282,5 +313,5 @@ while [ $i -le 2 ] ; do
 done
 
 if  [ -z "${offline_mode}" ]; then
-  $trainer -h ${host} -t ${keeper_teamname} --use_ear on
+  $trainer -h ${host} -t ${keeper_teamname} --use_ear on ${trainer_opt}
 fi
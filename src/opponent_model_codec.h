@@ -0,0 +1,130 @@
+// -*-c++-*-
+
+/*!
+  \file opponent_model_codec.h
+  \brief character codec of the opponent model freeform message shared by the coach and the players
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef OPPONENT_MODEL_CODEC_H
+#define OPPONENT_MODEL_CODEC_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/*!
+  \class OpponentModelCodec
+  \brief quantizes each opponent model value into one character.
+
+  The coach encodes with this class and the players decode with it, so
+  both sides always share the same alphabet and value ranges.
+  The value order is the same as OpponentModel::Value in the coach and
+  CoachOpponentModel::Value in the player.
+ */
+class OpponentModelCodec {
+public:
+
+    //! the number of values in one message
+    static const int VALUE_SIZE = 7;
+
+    //! the number of quantization levels of each value
+    static const int LEVELS = 62;
+
+    /*!
+      \brief get the characters used for the quantized values
+     */
+    static
+    const char * charset()
+      {
+          return "0123456789"
+              "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+              "abcdefghijklmnopqrstuvwxyz";
+      }
+
+    /*!
+      \brief get the value range
+      \param index value index [0, VALUE_SIZE)
+      \return pointer to { min, max }
+     */
+    static
+    const double * range( const int index )
+      {
+          static const double s_range[VALUE_SIZE][2] = {
+              { -52.5, 52.5 }, // CENTROID_X
+              { -34.0, 34.0 }, // CENTROID_Y
+              { 0.0, 30.0 },   // SPREAD_X
+              { 0.0, 30.0 },   // SPREAD_Y
+              { -52.5, 52.5 }, // DEFENSE_LINE_X
+              { 0.0, 15.0 },   // MARK_DIST
+              { 0.0, 1.5 },    // CHASE_SPEED
+          };
+          return s_range[index];
+      }
+
+    /*!
+      \brief encode the value into one character
+      \param index value index [0, VALUE_SIZE)
+      \param value raw value. clamped into the range.
+     */
+    static
+    char encode( const int index,
+                 const double value )
+      {
+          const double * r = range( index );
+          const double rate = ( value - r[0] ) / ( r[1] - r[0] );
+          int level = static_cast< int >( std::round( rate * ( LEVELS - 1 ) ) );
+          level = std::min( std::max( 0, level ), LEVELS - 1 );
+          return charset()[level];
+      }
+
+    /*!
+      \brief decode one character
+      \param index value index [0, VALUE_SIZE)
+      \param c encoded character
+      \param value decoded value is set
+      \return false if the character is not in the alphabet
+     */
+    static
+    bool decode( const int index,
+                 const char c,
+                 double * value )
+      {
+          const char * p = ( c == '\0' ? nullptr : std::strchr( charset(), c ) );
+          if ( ! p )
+          {
+              return false;
+          }
+
+          const double * r = range( index );
+          const int level = static_cast< int >( p - charset() );
+          *value = r[0] + ( r[1] - r[0] ) * level / ( LEVELS - 1 );
+          return true;
+      }
+};
+
+#endif
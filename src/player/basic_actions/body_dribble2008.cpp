@@ -44,6 +44,7 @@
 #include "body_kick_to_relative.h"
 #include "body_stop_ball.h"
 #include "neck_scan_field.h"
+#include "self_motion_cache.h"
 
 #include <rcsc/player/audio_sensor.h>
 #include <rcsc/player/player_agent.h>
@@ -668,15 +669,13 @@ Body_Dribble2008::doKickTurnsDashes( PlayerAgent * agent,
                                      const double & dash_power,
                                      const int n_turn )
 {
-    static std::vector< Vector2D > self_cache;
-
     const int max_dash = 5;
 
     const WorldModel & wm = agent->world();
 
-    createSelfCache( agent,
-                     target_point, dash_power,
-                     n_turn, max_dash, self_cache );
+    const std::vector< Vector2D > & self_cache = getSelfCache( wm,
+                                                               target_point, dash_power,
+                                                               n_turn, max_dash );
 
     dlog.addText( Logger::DRIBBLE,
                   __FILE__": doKickTurnsDashes() target=(%.1f %.1f) dash_power=%.1f n_turn=%d",
@@ -887,8 +886,6 @@ Body_Dribble2008::doKickDashes( PlayerAgent * agent,
                                 const double & dash_power,
                                 const int dash_count )
 {
-    static std::vector< Vector2D > self_cache;
-
     // do dribble kick. simulate next action queue.
     // kick -> dash -> dash -> ...
 
@@ -896,13 +893,12 @@ Body_Dribble2008::doKickDashes( PlayerAgent * agent,
 
     ////////////////////////////////////////////////////////
     // simulate my pos after one kick & dashes
-    createSelfCache( agent,
-                     target_point, dash_power,
-                     0, dash_count, // no turn
-                     self_cache );
+    const std::vector< Vector2D > & self_cache = getSelfCache( wm,
+                                                               target_point, dash_power,
+                                                               0, dash_count ); // no turn
 
     // my moved position after 1 kick and n dashes
-    const Vector2D my_pos = self_cache.back() - wm.self().pos();
+    const Vector2D my_pos = self_cache[dash_count] - wm.self().pos();
     const double my_move_dist = my_pos.r();
     // my move direction
     const AngleDeg my_move_dir = my_pos.th();
@@ -1131,10 +1127,8 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
                                         const int dash_count,
                                         const bool dodge_mode )
 {
-    static std::vector< Vector2D > my_state;
     static std::vector< KeepDribbleInfo > dribble_info;
 
-    my_state.clear();
     dribble_info.clear();
 
     // do dribble kick. simulate next action queue.
@@ -1147,11 +1141,11 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
     Timer timer;
 
     // estimate my move positions
-    createSelfCache( agent,
-                     target_point, dash_power,
-                     0, // no turn
-                     std::max( 12, dash_count ),
-                     my_state );
+    const int max_dash = std::max( 12, dash_count );
+    const std::vector< Vector2D > & my_state = getSelfCache( wm,
+                                                             target_point, dash_power,
+                                                             0, // no turn
+                                                             max_dash );
 
     const AngleDeg accel_angle = ( dash_power > 0.0
                                    ? wm.self().body()
@@ -1200,6 +1194,7 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
             KeepDribbleInfo info;
             if ( simulateKickDashes( wm,
                                      my_state,
+                                     max_dash,
                                      dash_count,
                                      accel_angle,
                                      first_ball_pos,
@@ -1322,38 +1317,13 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
 /*!
 
  */
-void
-Body_Dribble2008::createSelfCache( PlayerAgent * agent,
-                                   const Vector2D & target_point,
-                                   const double & dash_power,
-                                   const int turn_count,
-                                   const int dash_count,
-                                   std::vector< Vector2D > & self_cache )
+const std::vector< Vector2D > &
+Body_Dribble2008::getSelfCache( const WorldModel & wm,
+                                const Vector2D & target_point,
+                                const double & dash_power,
+                                const int turn_count,
+                                const int dash_count )
 {
-    const WorldModel & wm = agent->world();
-
-    self_cache.clear();
-    self_cache.reserve( turn_count + dash_count + 1 );
-
-    StaminaModel stamina_model = wm.self().staminaModel();
-
-    Vector2D my_pos = wm.self().pos();
-    Vector2D my_vel = wm.self().vel();
-
-    my_pos += my_vel;
-    my_vel *= wm.self().playerType().playerDecay();
-
-    self_cache.push_back( my_pos ); // first element is next cycle just after kick
-
-    for ( int i = 0; i < turn_count; ++i )
-    {
-        my_pos += my_vel;
-        my_vel *= wm.self().playerType().playerDecay();
-        self_cache.push_back( my_pos );
-    }
-
-    stamina_model.simulateWaits( wm.self().playerType(), 1 + turn_count );
-
     AngleDeg accel_angle;
     if ( turn_count == 0 )
     {
@@ -1366,46 +1336,12 @@ Body_Dribble2008::createSelfCache( PlayerAgent * agent,
         accel_angle = ( target_point - wm.self().inertiaFinalPoint() ).th();
     }
 
-    for ( int i = 0; i < dash_count; ++i )
-    {
-        double available_stamina
-            =  std::max( 0.0,
-                         stamina_model.stamina()
-                         - ServerParam::i().recoverDecThrValue()
-                         - 300.0 );
-        double consumed_stamina = ( dash_power > 0.0
-                                    ? dash_power
-                                    : dash_power * -2.0 );
-        consumed_stamina = std::min( available_stamina,
-                                     consumed_stamina );
-        double used_power = ( dash_power > 0.0
-                              ? consumed_stamina
-                              : consumed_stamina * -0.5 );
-        double max_accel_mag = ( std::fabs( used_power )
-                                 * wm.self().playerType().dashPowerRate()
-                                 * stamina_model.effort() );
-        double accel_mag = max_accel_mag;
-        if ( wm.self().playerType().normalizeAccel( my_vel,
-                                                    accel_angle,
-                                                    &accel_mag ) )
-        {
-            used_power *= accel_mag / max_accel_mag;
-        }
-
-        Vector2D dash_accel
-            = Vector2D::polar2vector( std::fabs( used_power )
-                                      * stamina_model.effort()
-                                      * wm.self().playerType().dashPowerRate(),
-                                      accel_angle );
-        my_vel += dash_accel;
-        my_pos += my_vel;
-
-        self_cache.push_back( my_pos );
-
-        my_vel *= wm.self().playerType().playerDecay();
-
-        stamina_model.simulateDash( wm.self().playerType(), used_power );
-    }
+    // first element is next cycle just after kick
+    return SelfMotionCache::instance().get( wm,
+                                            turn_count, dash_count,
+                                            dash_power, accel_angle,
+                                            ServerParam::i().recoverDecThrValue() + 300.0,
+                                            true ).pos_;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1415,6 +1351,7 @@ Body_Dribble2008::createSelfCache( PlayerAgent * agent,
 bool
 Body_Dribble2008::simulateKickDashes( const WorldModel & wm,
                                       const std::vector< Vector2D > & self_cache,
+                                      const int max_dash,
                                       const int dash_count,
                                       const AngleDeg & accel_angle,
                                       const Vector2D & first_ball_pos,
@@ -1464,7 +1401,7 @@ Body_Dribble2008::simulateKickDashes( const WorldModel & wm,
     Vector2D last_ball_rel( 0.0, 0.0 );
 
     // future state loop
-    for ( std::vector< Vector2D >::const_iterator my_pos = self_cache.begin() + 1, end = self_cache.end();
+    for ( std::vector< Vector2D >::const_iterator my_pos = self_cache.begin() + 1, end = self_cache.begin() + 1 + max_dash;
           my_pos != end;
           ++my_pos )
     {
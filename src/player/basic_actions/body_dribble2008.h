@@ -222,14 +222,14 @@ private:
                                const double & dash_power,
                                const int dash_count,
                                const bool dodge_mode );
-    void createSelfCache( rcsc::PlayerAgent * agent,
-                          const rcsc::Vector2D & target_point,
-                          const double & dash_power,
-                          const int turn_count,
-                          const int dash_count,
-                          std::vector< rcsc::Vector2D > & self_cache );
+    const std::vector< rcsc::Vector2D > & getSelfCache( const rcsc::WorldModel & wm,
+                                                        const rcsc::Vector2D & target_point,
+                                                        const double & dash_power,
+                                                        const int turn_count,
+                                                        const int dash_count );
     bool simulateKickDashes( const rcsc::WorldModel & wm,
                              const std::vector< rcsc::Vector2D > & self_cache,
+                             const int max_dash,
                              const int dash_count,
                              const rcsc::AngleDeg & accel_angle,
                              const rcsc::Vector2D & first_ball_pos,
@@ -47,6 +47,10 @@
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/geom/line_2d.h>
 
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
 using namespace rcsc;
 
 // #define DEBUG_CREATE
@@ -63,6 +67,108 @@ struct KeepPointSorter {
       }
 };
 
+/*!
+  \brief opponent values shared by all keep points in the same cycle
+ */
+struct HoldOpponent {
+    const PlayerObject * player_;
+    Vector2D next_; //!< next position
+    double body_cos_; //!< estimated body angle
+    double body_sin_;
+    double kickable_area_;
+    bool goalie_in_penalty_area_;
+    double max_penalty_; //!< upper bound of the penalty given by this opponent
+    std::vector< Vector2D > max_move_; //!< max dash accel in the opponent body coordinates
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the opponents that can interfere with the keep points.
+  the result is created once per cycle.
+ */
+const std::vector< HoldOpponent > &
+get_hold_opponents( const WorldModel & wm,
+                    const Rect2D & penalty_area )
+{
+    static GameTime s_update_time( -1, 0 );
+    static std::vector< HoldOpponent > s_opponents;
+
+    if ( s_update_time == wm.time() )
+    {
+        return s_opponents;
+    }
+    s_update_time = wm.time();
+    s_opponents.clear();
+
+    const ServerParam & SP = ServerParam::i();
+    const double consider_dist = ( SP.tackleDist()
+                                   + SP.defaultPlayerSpeedMax()
+                                   + 1.0 );
+    const double dash_angle_step = std::max( 15.0, SP.dashAngleStep() );
+    const int dash_angle_divs
+        = static_cast< int >( std::floor( ( SP.maxDashAngle() - SP.minDashAngle() )
+                                          / dash_angle_step ) );
+
+    const Vector2D my_next = wm.self().pos() + wm.self().vel();
+
+    for ( const PlayerObject * o : wm.opponentsFromBall() )
+    {
+        if ( o->distFromBall() > consider_dist ) break;
+
+        if ( o->posCount() > 10 ) continue;
+        if ( o->isGhost() ) continue;
+        if ( o->isTackling() ) continue;
+
+        const PlayerType * player_type = o->playerTypePtr();
+
+        s_opponents.push_back( HoldOpponent() );
+        HoldOpponent & opp = s_opponents.back();
+
+        opp.player_ = o;
+        opp.next_ = o->pos() + o->vel();
+        opp.kickable_area_ = player_type->kickableArea();
+        opp.goalie_in_penalty_area_ = ( o->goalie()
+                                        && penalty_area.contains( opp.next_ ) );
+
+        AngleDeg opp_body;
+        if ( o->bodyCount() == 0 )
+        {
+            opp_body = o->body();
+        }
+        else if ( o->velCount() <= 1
+                  && o->vel().r() > 0.2 )
+        {
+            opp_body = o->vel().th();
+        }
+        else
+        {
+            opp_body = ( my_next - opp.next_ ).th();
+        }
+        opp.body_cos_ = opp_body.cos();
+        opp.body_sin_ = opp_body.sin();
+
+        opp.max_move_.reserve( dash_angle_divs );
+        for ( int d = 0; d < dash_angle_divs; ++d )
+        {
+            const double dir = AngleDeg::normalize_angle( SP.minDashAngle() + ( dash_angle_step * d ) );
+            const AngleDeg dash_angle = SP.discretizeDashAngle( dir );
+            const double max_accel = ( SP.maxDashPower()
+                                       * player_type->dashPowerRate()
+                                       * player_type->effortMax()
+                                       * SP.dashDirRate( dir ) );
+            opp.max_move_.push_back( Vector2D::from_polar( max_accel, dash_angle ) );
+        }
+
+        const double max_control_area = std::max( SP.catchableArea(), opp.kickable_area_ );
+        opp.max_penalty_ = ( 200.0 // control
+                             + max_control_area * 50.0 // body line
+                             + 50.0 // tackle
+                             + 20.0 * dash_angle_divs ); // kick or tackle after dash
+    }
+
+    return s_opponents;
+}
+
 }
 
 const double Body_HoldBall2008::DEFAULT_SCORE = 100.0;
@@ -488,26 +594,29 @@ Body_HoldBall2008::evaluateKeepPoints( const WorldModel & wm,
                                        std::vector< KeepPoint > & keep_points )
 {
 #ifdef DEBUG_EVAL
-    int count = 0;
     dlog.addText( Logger::HOLD,
                   __FILE__"(evaluate) =========" );
 #endif
-    for ( KeepPoint & p : keep_points )
+
+    const std::size_t size = keep_points.size();
+
+    std::vector< double > x( size );
+    std::vector< double > y( size );
+    std::vector< double > bonus( size );
+    std::vector< double > scores( size );
+
+    for ( std::size_t i = 0; i < size; ++i )
     {
-#ifdef DEBUG_EVAL
-        dlog.addText( Logger::HOLD,
-                      "%d: (evaluate) (%.2f %.2f)",
-                      ++count, p.pos_.x, p.pos_.y );
-#endif
-        p.score_ = evaluateKeepPoint( wm, p.pos_ );
-        // if ( p.score_ < DEFAULT_SCORE - 1.0e-5 )
-        // {
-        //     p.score_ += p.pos_.dist( wm.ball().pos() ) * 0.001;
-        // }
-        // else
-        {
-            p.score_ += p.kick_rate_ * 1000.0;
-        }
+        x[i] = keep_points[i].pos_.x;
+        y[i] = keep_points[i].pos_.y;
+        bonus[i] = keep_points[i].kick_rate_ * 1000.0;
+    }
+
+    evaluateKeepPoints( wm, size, x.data(), y.data(), bonus.data(), scores.data() );
+
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        keep_points[i].score_ = scores[i];
     }
 
 #ifdef DEBUG_EVAL
@@ -520,7 +629,7 @@ Body_HoldBall2008::evaluateKeepPoints( const WorldModel & wm,
 
     dlog.addText( Logger::HOLD,
                   __FILE__"(results) =========" );
-    count = 0;
+    int count = 0;
     for ( const KeepPoint & p : keep_points )
     {
         ++count;
@@ -546,220 +655,205 @@ Body_HoldBall2008::evaluateKeepPoints( const WorldModel & wm,
 double
 Body_HoldBall2008::evaluateKeepPoint( const WorldModel & wm,
                                       const Vector2D & keep_point )
+{
+    const double bonus = 0.0;
+    double score = 0.0;
+
+    evaluateKeepPoints( wm, 1, &keep_point.x, &keep_point.y, &bonus, &score );
+
+    return score;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Body_HoldBall2008::evaluateKeepPoints( const WorldModel & wm,
+                                       const std::size_t size,
+                                       const double * x,
+                                       const double * y,
+                                       const double * bonus,
+                                       double * result )
 {
     static const Rect2D penalty_area( Vector2D( ServerParam::i().theirPenaltyAreaLineX(),
                                                 - ServerParam::i().penaltyAreaHalfWidth() ),
                                       Size2D( ServerParam::i().penaltyAreaLength(),
                                               ServerParam::i().penaltyAreaWidth() ) );
-    static const double consider_dist = ( ServerParam::i().tackleDist()
-                                          + ServerParam::i().defaultPlayerSpeedMax()
-                                          + 1.0 );
     const ServerParam & SP = ServerParam::i();
 
-    const Vector2D my_next = wm.self().pos() + wm.self().vel();
+    const std::vector< HoldOpponent > & opponents = get_hold_opponents( wm, penalty_area );
 
-    double score = DEFAULT_SCORE;
-
-    for ( const PlayerObject * o : wm.opponentsFromBall() )
+    const Vector2D my_next = wm.self().pos() + wm.self().vel();
+    const Vector2D ball_pos = wm.ball().pos();
+    const double kickable_area = wm.self().playerType().kickableArea();
+
+    const double tackle_dist = SP.tackleDist();
+    const double tackle_back_dist = SP.tackleBackDist();
+    const double tackle_width = SP.tackleWidth();
+    const double foul_exponent = SP.foulExponent();
+
+    //
+    // the score of each point is DEFAULT_SCORE minus the opponent penalties,
+    // multiplied by the keep distance rate, plus the bonus.
+    //
+
+    std::vector< double > score( size, DEFAULT_SCORE );
+    std::vector< double > rate( size, 1.0 );
+    std::vector< char > in_penalty_area( size );
+    std::vector< char > alive( size, 1 );
+
+    double remaining_penalty = 0.0;
+    for ( const HoldOpponent & opp : opponents )
     {
-        if ( o->distFromBall() > consider_dist ) break;
+        remaining_penalty += opp.max_penalty_;
+    }
 
-        if ( o->posCount() > 10 ) continue;
-        if ( o->isGhost() ) continue;
-        if ( o->isTackling() ) continue;
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        in_penalty_area[i] = penalty_area.contains( Vector2D( x[i], y[i] ) );
 
-        const PlayerType * player_type = o->playerTypePtr();
-        const Vector2D opp_next = o->pos() + o->vel();
-        const double control_area = ( ( o->goalie()
-                                        && penalty_area.contains( opp_next )
-                                        && penalty_area.contains( keep_point ) )
-                                      ? SP.catchableArea()
-                                      : player_type->kickableArea() );
-        const double opp_dist = opp_next.dist( keep_point );
-
-        if ( opp_dist < control_area * 0.5 )
+        const double ball_move_dist = std::hypot( x[i] - ball_pos.x, y[i] - ball_pos.y );
+        if ( ball_move_dist > kickable_area * 1.6 )
         {
-            score -= 200.0;
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) can control(1). score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, score );
-
-#endif
+            const double next_ball_dist = std::hypot( x[i] - my_next.x, y[i] - my_next.y );
+            const double threshold = kickable_area - 0.4;
+            rate[i] = 1.0 - 0.5 * std::max( 0.0, ( next_ball_dist - threshold ) / 0.4 );
         }
-        else if ( opp_dist < control_area + 0.1 )
-        {
-            score -= 150.0;
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) can control(2). score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, score );
+    }
 
-#endif
-        }
-        else if ( opp_dist < SP.tackleDist() - 0.2 )
+    for ( const HoldOpponent & opp : opponents )
+    {
+        remaining_penalty -= opp.max_penalty_;
+
+        for ( std::size_t i = 0; i < size; ++i )
         {
-            score -= 25.0;
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) within tackle. score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, score );
+            if ( ! alive[i] ) continue;
 
-#endif
-        }
+            const double control_area = ( opp.goalie_in_penalty_area_ && in_penalty_area[i]
+                                          ? SP.catchableArea()
+                                          : opp.kickable_area_ );
+            const double dx = x[i] - opp.next_.x;
+            const double dy = y[i] - opp.next_.y;
+            const double opp_dist = std::sqrt( dx * dx + dy * dy );
 
-        AngleDeg opp_body;
-        if ( o->bodyCount() == 0 )
-        {
-            opp_body = o->body();
-        }
-        else if ( o->velCount() <= 1
-                  && o->vel().r() > 0.2 )
-        {
-            opp_body = o->vel().th();
-        }
-        else
-        {
-            opp_body = ( my_next - opp_next ).th();
-        }
+            double penalty = 0.0;
 
-        //
-        // check opponent body line
-        //
+            if ( opp_dist < control_area * 0.5 )
+            {
+                penalty -= 200.0;
+            }
+            else if ( opp_dist < control_area + 0.1 )
+            {
+                penalty -= 150.0;
+            }
+            else if ( opp_dist < tackle_dist - 0.2 )
+            {
+                penalty -= 25.0;
+            }
 
-        const Vector2D player_2_pos = ( keep_point - opp_next ).rotatedVector( -opp_body );
+            //
+            // check opponent body line
+            //
 
-        if ( player_2_pos.absY() < control_area )
-        {
-            // if ( player_2_pos.absY() < control_area * 0.8 )
-            // {
-            //     score -= 20.0;
-            // }
-            // else
-            // {
-            //     score -= 10.0;
-            // }
+            // keep point in the opponent body coordinates
+            const double px = dx * opp.body_cos_ + dy * opp.body_sin_;
+            const double py = - dx * opp.body_sin_ + dy * opp.body_cos_;
+
+            if ( std::fabs( py ) < control_area )
+            {
+                penalty -= ( control_area - std::fabs( py ) ) * 50.0;
+            }
+
+            //
+            // check tackle probability
+            //
+            {
+                const double dist = ( px > 0.0 ? tackle_dist : tackle_back_dist );
+                if ( dist > 1.0e-5 )
+                {
+                    const double tackle_fail_prob = ( std::pow( std::fabs( px ) / dist, foul_exponent )
+                                                      + std::pow( std::fabs( py ) / tackle_width, foul_exponent ) );
+                    if ( tackle_fail_prob < 1.0 )
+                    {
+                        penalty -= ( 1.0 - tackle_fail_prob ) * 50.0;
+                    }
+                }
+            }
 
-            score -= ( control_area - player_2_pos.absY() ) * 50.0;
+            //
+            // check kick or tackle possibility after dash
+            //
+            const double next_control_area2 = std::pow( control_area + 0.1, 2 );
+            for ( const Vector2D & max_move : opp.max_move_ )
+            {
+                const double nx = px - max_move.x;
+                const double ny = py - max_move.y;
+
+                if ( nx * nx + ny * ny < next_control_area2 )
+                {
+                    penalty -= 20.0;
+                }
+                else if ( std::fabs( ny ) < tackle_width + 0.1
+                          && nx > 0.0
+                          && nx < tackle_dist + 0.1 )
+                {
+                    penalty -= 10.0;
+                }
+            }
+
+            score[i] += penalty;
 
 #ifdef DEBUG_EVAL
             dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) on body line. body=%.1f y=%.3f score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, opp_body.degree(),
-                          player_2_pos.absY(),
-                          score );
-
+                          "____ (%.2f %.2f) opp %d(%.1f %.1f) penalty=%.3f score=%.3f",
+                          x[i], y[i],
+                          opp.player_->unum(),
+                          opp.player_->pos().x, opp.player_->pos().y,
+                          penalty, score[i] );
 #endif
         }
 
-        //
-        // check tackle probability
-        //
+        if ( remaining_penalty <= 0.0 )
         {
-            double tackle_dist = ( player_2_pos.x > 0.0
-                                   ? SP.tackleDist()
-                                   : SP.tackleBackDist() );
-            if ( tackle_dist > 1.0e-5 )
-            {
-                double tackle_fail_prob = ( std::pow( player_2_pos.absX() / tackle_dist,
-                                                      SP.foulExponent() )
-                                            + std::pow( player_2_pos.absY() / SP.tackleWidth(),
-                                                        SP.foulExponent() ) );
-                if ( tackle_fail_prob < 1.0 )
-                    //&& 1.0 - tackle_fail_prob > 0.7 ) // success probability
-                {
-                    //score -= 30.0;
-                    score -= ( 1.0 - tackle_fail_prob ) * 50.0;
-#ifdef DEBUG_EVAL
-                    dlog.addText( Logger::HOLD,
-                                  "____ tackle_prob=%.3f %d(%.1f %.1f) body=%.1f score=%.3f",
-                                  1.0 - tackle_fail_prob,
-                                  o->unum(),
-                                  o->pos().x, o->pos().y,
-                                  opp_body.degree(), score );
-#endif
-                }
-            }
+            continue;
         }
 
         //
-        // check kick or tackle possibility after dash
+        // mask the points that cannot be the best any more
         //
-        const double dash_angle_step = std::max( 15.0, SP.dashAngleStep() );
-        const int dash_angle_divs
-            = static_cast< int >( std::floor( ( SP.maxDashAngle() - SP.minDashAngle() )
-                                              / dash_angle_step ) );
-
-        double next_kick_penalty = 0.0;
-        double next_tackle_penalty = 0.0;
-        for ( int d = 0; d < dash_angle_divs; ++d )
+        double best_lower = -std::numeric_limits< double >::max();
+        for ( std::size_t i = 0; i < size; ++i )
         {
-            const double dir = AngleDeg::normalize_angle( SP.minDashAngle() + ( dash_angle_step * d ) );
-            const AngleDeg dash_angle = SP.discretizeDashAngle( dir );
-            const double max_accel = ( SP.maxDashPower()
-                                       * player_type->dashPowerRate()
-                                       * player_type->effortMax()
-                                       * SP.dashDirRate( dir ) );
-            const Vector2D max_move = Vector2D::from_polar( max_accel, dash_angle );
+            if ( ! alive[i] ) continue;
 
-            const Vector2D next_player_2_pos = player_2_pos - max_move;
+            const double lower = std::min( score[i] * rate[i],
+                                           ( score[i] - remaining_penalty ) * rate[i] ) + bonus[i];
+            best_lower = std::max( best_lower, lower );
+        }
 
-            if ( next_player_2_pos.r2() < std::pow( control_area + 0.1, 2 ) )
-            {
-#ifdef DEBUG_EVAL
-                dlog.addText( Logger::HOLD,
-                              "____ next kickable %d opponent_body=%.1f dash_dir=%.0f max_accel=%.3f",
-                              o->unum(), opp_body.degree(), dir, max_accel );
-#endif
-                //next_kick_penalty = -20.0;
-                next_kick_penalty -= 20.0;
-            }
-            else if ( next_player_2_pos.absY() < SP.tackleWidth() + 0.1
-                      && next_player_2_pos.x > 0.0
-                      && next_player_2_pos.x < SP.tackleDist() + 0.1 )
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            if ( ! alive[i] ) continue;
+
+            const double upper = std::max( score[i] * rate[i],
+                                           ( score[i] - remaining_penalty ) * rate[i] ) + bonus[i];
+            if ( upper < best_lower )
             {
+                alive[i] = 0;
 #ifdef DEBUG_EVAL
                 dlog.addText( Logger::HOLD,
-                              "____ next tackle %d opponent_body=%.1f dash_dir=%.0f max_accel=%.3f",
-                              o->unum(), opp_body.degree(), dir, max_accel );
+                              "____ (%.2f %.2f) dominated. upper=%.3f best_lower=%.3f",
+                              x[i], y[i], upper, best_lower );
 #endif
-                //next_tackle_penalty = -10.0;
-                next_tackle_penalty -= 10.0;
             }
         }
-
-        score += next_kick_penalty;
-        score += next_tackle_penalty;
-#ifdef DEBUG_EVAL
-        dlog.addText( Logger::HOLD,
-                      "____ %d kick_penalty=%.1f tackle_penalty=%.1f score=%.3f",
-                      o->unum(), next_kick_penalty, next_tackle_penalty, score );
-#endif
-
     }
 
-#if 1
-    double ball_move_dist = ( keep_point - wm.ball().pos() ).r();
-    if ( ball_move_dist > wm.self().playerType().kickableArea() * 1.6 )
+    for ( std::size_t i = 0; i < size; ++i )
     {
-        double next_ball_dist = my_next.dist( keep_point );
-        double threshold = wm.self().playerType().kickableArea() - 0.4;
-        double rate = 1.0 - 0.5 * std::max( 0.0, ( next_ball_dist - threshold ) / 0.4 );
-        score *= rate;
-
-#ifdef DEBUG_EVAL
-        dlog.addText( Logger::HOLD,
-                      "__ applied keep distance threshold. ball_dist=%.3f thr=%.3f rate=%f",
-                      next_ball_dist, threshold, rate );
-#endif
+        result[i] = score[i] * rate[i] + bonus[i];
     }
-#endif
-
-    return score;
 }
 
 /*-------------------------------------------------------------------*/
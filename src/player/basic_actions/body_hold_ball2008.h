@@ -167,6 +167,25 @@ private:
     double evaluateKeepPoint( const rcsc::WorldModel & wm,
                               const rcsc::Vector2D & keep_point );
 
+    /*!
+      \brief evaluate all keep points against all nearby opponents in one pass.
+      the points whose upper bound falls below the lower bound of another
+      point are masked out and keep their partial score, which is still
+      lower than the best score.
+      \param wm const reference to the WorldModel instance
+      \param size the number of points
+      \param x x coordinates of the points
+      \param y y coordinates of the points
+      \param bonus value added to each score
+      \param result evaluated scores
+     */
+    void evaluateKeepPoints( const rcsc::WorldModel & wm,
+                             const std::size_t size,
+                             const double * x,
+                             const double * y,
+                             const double * bonus,
+                             double * result );
+
     /*!
       \brief if possible, turn to face target point
       \param agent agent pointer to agent itself
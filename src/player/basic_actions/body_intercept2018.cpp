@@ -468,7 +468,7 @@ Body_Intercept2018::get_best_intercept_player( const WorldModel & wm,
     }
     s_time = wm.time();
 
-    InterceptEvaluator::Ptr intercept_evaluator = InterceptEvaluator::create( "Default" );
+    static const InterceptEvaluator::Ptr intercept_evaluator = InterceptEvaluator::create( "Default" );
 
     if ( ! intercept_evaluator )
     {
@@ -488,15 +488,18 @@ Body_Intercept2018::get_best_intercept_player( const WorldModel & wm,
 
     int count = 0;
 
+    const std::vector< Intercept > & results = wm.interceptTable().selfResults();
+
+    std::vector< double > values;
+    intercept_evaluator->evaluateAll( wm, results, save_recovery, &values );
+
     std::vector< InterceptCandidate > candidates;
-    candidates.reserve( wm.interceptTable().selfResults().size() );
+    candidates.reserve( results.size() );
 
-    for ( const Intercept & it : wm.interceptTable().selfResults() )
+    for ( const Intercept & it : results )
     {
+        candidates.push_back( InterceptCandidate( &it, values[count], count + 1, 0 ) );
         ++count;
-        candidates.push_back( InterceptCandidate( &it, 0.0, count, 0 ) );
-        InterceptCandidate & candidate = candidates.back();
-        candidate.value_ = intercept_evaluator->evaluate( wm, *candidate.info_, save_recovery );
     }
 
 
@@ -0,0 +1,273 @@
+// -*-c++-*-
+
+/*!
+  \file information_value.cpp
+  \brief per-cycle information value of the player objects Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "information_value.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/common/logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+const double InformationValue::RELEVANCE_FLOOR = 0.2;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+double
+gaussian_rate( const double dist,
+               const double sigma )
+{
+    return std::exp( - std::pow( dist, 2 ) / ( 2.0 * std::pow( sigma, 2 ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+double
+get_uncertainty( const AbstractPlayerObject * p )
+{
+    if ( p->ghostCount() >= 5 )
+    {
+        // the object will be removed soon
+        return 0.0;
+    }
+
+    double count = p->seenPosCount();
+    if ( p->isGhost()
+         && p->ghostCount() % 2 == 1 )
+    {
+        count = std::min( 2.0, count );
+    }
+
+    return count + 1.0;
+}
+
+/*-------------------------------------------------------------------*/
+double
+get_relevance( const WorldModel & wm,
+               const AbstractPlayerObject * p,
+               const Vector2D & focus_point,
+               const bool our_ball )
+{
+    const double variance = 30.0; // Magic Number
+    const double x_rate = 1.0; // Magic Number
+    const double y_rate = 0.5; // Magic Number
+
+    const double d = std::sqrt( std::pow( ( p->pos().x - focus_point.x ) * x_rate, 2 )
+                                + std::pow( ( p->pos().y - focus_point.y ) * y_rate, 2 ) );
+
+    double role_rate = 1.0;
+    if ( our_ball )
+    {
+        // receivers in front of the ball
+        if ( p->side() == wm.ourSide()
+             && ( p->pos().x > wm.ball().pos().x - 10.0
+                  || p->pos().x > 30.0 ) )
+        {
+            role_rate = 2.0;
+        }
+    }
+    else
+    {
+        // attackers behind the ball
+        if ( p->side() == wm.theirSide()
+             && ( p->pos().x < wm.ball().pos().x + 10.0
+                  || p->pos().x < -30.0 ) )
+        {
+            role_rate = 2.0;
+        }
+    }
+
+    return role_rate * ( InformationValue::RELEVANCE_FLOOR
+                         + ( 1.0 - InformationValue::RELEVANCE_FLOOR ) * gaussian_rate( d, variance ) );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InformationValue::InformationValue()
+    : M_update_time( -1, 0 ),
+      M_focus_point( Vector2D::INVALIDATED )
+{
+    std::fill( M_number_index, M_number_index + 23, -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InformationValue &
+InformationValue::instance()
+{
+    static InformationValue s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InformationValue::update( const WorldModel & wm )
+{
+    if ( M_update_time == wm.time() )
+    {
+        return;
+    }
+    M_update_time = wm.time();
+
+    M_entries.clear();
+    std::fill( M_number_index, M_number_index + 23, -1 );
+
+    const int self_min = wm.interceptTable().selfStep();
+    const int mate_min = wm.interceptTable().teammateStep();
+    const int opp_min = wm.interceptTable().opponentStep();
+    const bool our_ball = ( std::min( self_min, mate_min ) <= opp_min );
+
+    M_focus_point = wm.ball().inertiaPoint( std::min( std::min( self_min, mate_min ), opp_min ) );
+
+    M_entries.reserve( wm.allPlayers().size() );
+
+    for ( const AbstractPlayerObject * p : wm.allPlayers() )
+    {
+        Entry e;
+        e.player_ = p;
+        e.number_ = ( p->unum() == Unum_Unknown
+                      ? -1
+                      : p->side() == wm.ourSide()
+                      ? p->unum()
+                      : p->unum() + 11 );
+        e.uncertainty_ = get_uncertainty( p );
+        e.relevance_ = get_relevance( wm, p, M_focus_point, our_ball );
+
+        if ( 1 <= e.number_ && e.number_ <= 22 )
+        {
+            M_number_index[e.number_] = static_cast< int >( M_entries.size() );
+        }
+
+        M_entries.push_back( e );
+    }
+
+    dlog.addText( Logger::WORLD,
+                  __FILE__": (update) focus=(%.1f %.1f) our_ball=%d size=%d",
+                  M_focus_point.x, M_focus_point.y,
+                  (int)our_ball, (int)M_entries.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const InformationValue::Entry *
+InformationValue::entry( const int number ) const
+{
+    if ( number < 1 || 22 < number
+         || M_number_index[number] < 0 )
+    {
+        return static_cast< const Entry * >( 0 );
+    }
+
+    return &M_entries[M_number_index[number]];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InformationValue::see_value( const Entry & e,
+                             const Vector2D & observer_pos )
+{
+    // the accuracy of the visual information decreases with distance.
+    const double visible_rate = gaussian_rate( e.player_->pos().dist( observer_pos ), 20.0 ); // Magic Number
+
+    return std::pow( e.uncertainty_, 2 ) * e.relevance_ * visible_rate;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InformationValue::say_value( const Entry & e,
+                             const double hear_count )
+{
+    return hear_count * e.relevance_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InformationValue::maxSeeValue( const Vector2D & observer_pos,
+                               const double max_dist ) const
+{
+    double max_value = 0.0;
+    for ( const Entry & e : M_entries )
+    {
+        if ( e.player_->isSelf() ) continue;
+        if ( e.player_->pos().dist2( observer_pos ) > std::pow( max_dist, 2 ) ) continue;
+
+        max_value = std::max( max_value, see_value( e, observer_pos ) );
+    }
+
+    return max_value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+InformationValue::existGhost( const Vector2D & observer_pos,
+                              const double max_dist ) const
+{
+    for ( const Entry & e : M_entries )
+    {
+        if ( e.player_->isGhost()
+             && e.player_->pos().dist2( observer_pos ) < std::pow( max_dist, 2 ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,170 @@
+// -*-c++-*-
+
+/*!
+  \file information_value.h
+  \brief per-cycle information value of the player objects Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef INFORMATION_VALUE_H
+#define INFORMATION_VALUE_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+
+namespace rcsc {
+class AbstractPlayerObject;
+class WorldModel;
+}
+
+/*!
+  \class InformationValue
+  \brief per-cycle model of how valuable new information about each
+  player object is.
+
+  The value is the product of the positional uncertainty (seen count,
+  ghost state) and the relevance of the object to the current play
+  (distance from the ball reach point and its role in the attack or the
+  defense). The say content, the neck scan and the view width use the
+  same values so that they agree on which objects are stale.
+ */
+class InformationValue {
+public:
+
+    /*!
+      \brief value entry of one player object
+     */
+    struct Entry {
+        const rcsc::AbstractPlayerObject * player_; //!< the player object
+        int number_; //!< 1-11: teammate, 12-22: opponent, -1: unknown uniform number
+        double uncertainty_; //!< (seen count + 1). 0 if the object should be ignored
+        double relevance_; //!< [RELEVANCE_FLOOR, 2.0]
+    };
+
+    //! the minimum relevance of the object far from the ball
+    static const double RELEVANCE_FLOOR;
+
+private:
+
+    rcsc::GameTime M_update_time;
+
+    //! the point where the ball will be controlled
+    rcsc::Vector2D M_focus_point;
+
+    //! all known players including the agent itself
+    std::vector< Entry > M_entries;
+
+    //! index of M_entries for each uniform number. 0: unused
+    int M_number_index[23];
+
+    InformationValue();
+
+    // not used
+    InformationValue( const InformationValue & );
+    const InformationValue & operator=( const InformationValue & );
+public:
+
+    static
+    InformationValue & instance();
+
+    static
+    const InformationValue & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief update values. nothing is done if already updated in this cycle.
+      \param wm world model
+     */
+    void update( const rcsc::WorldModel & wm );
+
+    const rcsc::Vector2D & focusPoint() const
+      {
+          return M_focus_point;
+      }
+
+    const std::vector< Entry > & entries() const
+      {
+          return M_entries;
+      }
+
+    /*!
+      \brief get the entry of the player
+      \param number 1-11: teammate, 12-22: opponent
+      \return null if not found
+     */
+    const Entry * entry( const int number ) const;
+
+    /*!
+      \brief get the relevance of the player
+      \param number 1-11: teammate, 12-22: opponent
+      \return 0 if not found
+     */
+    double relevance( const int number ) const
+      {
+          const Entry * e = entry( number );
+          return e ? e->relevance_ : 0.0;
+      }
+
+    /*!
+      \brief get the value of seeing the object from the observer
+      \param e target entry
+      \param observer_pos observer position
+     */
+    static
+    double see_value( const Entry & e,
+                      const rcsc::Vector2D & observer_pos );
+
+    /*!
+      \brief get the value of telling the object to the teammates
+      \param e target entry
+      \param hear_count cycles since the teammates heard the object
+     */
+    static
+    double say_value( const Entry & e,
+                      const double hear_count );
+
+    /*!
+      \brief get the highest see value over all objects within the distance
+      \param observer_pos observer position
+      \param max_dist max distance from the observer
+     */
+    double maxSeeValue( const rcsc::Vector2D & observer_pos,
+                        const double max_dist ) const;
+
+    /*!
+      \brief check if a ghost object exists within the distance
+      \param observer_pos observer position
+      \param max_dist max distance from the observer
+     */
+    bool existGhost( const rcsc::Vector2D & observer_pos,
+                     const double max_dist ) const;
+};
+
+#endif
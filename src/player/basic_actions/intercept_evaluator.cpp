@@ -35,6 +35,8 @@
 
 #include "intercept_evaluator.h"
 
+#include <rcsc/player/intercept_table.h>
+
 /*-------------------------------------------------------------------*/
 InterceptEvaluator::Creators &
 InterceptEvaluator::creators()
@@ -57,3 +59,19 @@ InterceptEvaluator::create( const std::string & name )
 
     return ptr;
 }
+
+/*-------------------------------------------------------------------*/
+void
+InterceptEvaluator::evaluateAll( const rcsc::WorldModel & wm,
+                                 const std::vector< rcsc::Intercept > & actions,
+                                 const bool save_recovery,
+                                 std::vector< double > * values )
+{
+    values->clear();
+    values->reserve( actions.size() );
+
+    for ( const rcsc::Intercept & action : actions )
+    {
+        values->push_back( evaluate( wm, action, save_recovery ) );
+    }
+}
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <functional>
+#include <vector>
 
 #include <rcsc/factory.h>
 
@@ -88,6 +89,17 @@ public:
     double evaluate( const rcsc::WorldModel & wm,
                      const rcsc::Intercept & action,
                      const bool save_recovery ) = 0;
+
+    /*!
+      \brief evaluate all candidates in one pass.
+      the default implementation calls evaluate() for each candidate.
+      \param values evaluation values in the order of actions
+     */
+    virtual
+    void evaluateAll( const rcsc::WorldModel & wm,
+                      const std::vector< rcsc::Intercept > & actions,
+                      const bool save_recovery,
+                      std::vector< double > * values );
 };
 
 #endif
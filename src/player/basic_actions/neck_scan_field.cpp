@@ -37,6 +37,7 @@
 
 #include "basic_actions.h"
 #include "neck_scan_players.h"
+#include "information_value.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/logger.h>
@@ -104,18 +105,13 @@ Neck_ScanField::execute( PlayerAgent * agent )
     //
     // try to maximize player accuracy
     //
-    bool exist_ghost = false;
-    for ( const AbstractPlayerObject * p : wm.allPlayers() )
+    InformationValue::instance().update( wm );
+
+    const bool exist_ghost = InformationValue::i().existGhost( wm.self().pos(), 30.0 );
+    if ( exist_ghost )
     {
-        if ( p->isGhost()
-             && p->distFromSelf() < 30.0 )
-        {
-            dlog.addText( Logger::ACTION,
-                          __FILE__": (execute) detect ghost player %c %d",
-                          side_char( p->side() ), p->unum() );
-            exist_ghost = true;
-            break;
-        }
+        dlog.addText( Logger::ACTION,
+                      __FILE__": (execute) detect ghost player" );
     }
 
     if ( ! exist_ghost )
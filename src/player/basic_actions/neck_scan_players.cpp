@@ -37,6 +37,7 @@
 
 #include "basic_actions.h"
 #include "neck_scan_field.h"
+#include "information_value.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/intercept_table.h>
@@ -133,6 +134,8 @@ Neck_ScanPlayers::get_best_angle( const PlayerAgent * agent,
         return INVALID_ANGLE;
     }
 
+    InformationValue::instance().update( wm );
+
     const ServerParam & SP = ServerParam::i();
 
     const Vector2D next_self_pos = agent->effector().queuedNextSelfPos();
@@ -179,7 +182,7 @@ Neck_ScanPlayers::get_best_angle( const PlayerAgent * agent,
                       left_angle.degree(), right_angle.degree() );
 #endif
 
-        double score = calculate_score( wm, next_self_pos, left_angle, right_angle );
+        double score = calculate_score( next_self_pos, left_angle, right_angle );
 
         if ( score > best_score )
         {
@@ -234,24 +237,19 @@ Neck_ScanPlayers::get_best_angle( const PlayerAgent * agent,
 
 */
 double
-Neck_ScanPlayers::calculate_score( const WorldModel & wm,
-                                   const Vector2D & next_self_pos,
+Neck_ScanPlayers::calculate_score( const Vector2D & next_self_pos,
                                    const AngleDeg & left_angle,
                                    const AngleDeg & right_angle )
 {
     double score = 0.0;
     double view_buffer = 90.0;
 
-    const int our_min = std::min( wm.interceptTable().selfStep(),
-                                  wm.interceptTable().teammateStep() );
-    const int opp_min = wm.interceptTable().opponentStep();
-    const bool our_ball = ( our_min <= opp_min );
-
     const AngleDeg reduced_left_angle = left_angle + 5.0;
     const AngleDeg reduced_right_angle = right_angle - 5.0;
 
-    for ( const AbstractPlayerObject * p : wm.allPlayers() )
+    for ( const InformationValue::Entry & e : InformationValue::i().entries() )
     {
+        const AbstractPlayerObject * p = e.player_;
         if ( p->isSelf() ) continue;
 
         Vector2D pos = p->pos() + p->vel();
@@ -263,41 +261,21 @@ Neck_ScanPlayers::calculate_score( const WorldModel & wm,
             continue;
         }
 
-        if ( p->ghostCount() >= 5 ) continue;
-
-        double pos_count = p->seenPosCount();
-        if ( p->isGhost()
-             && p->ghostCount() % 2 == 1 )
-        {
-            pos_count = std::min( 2.0, pos_count );
-        }
-        pos_count += 1.0;
-
-        if ( our_ball )
-        {
-            if ( p->side() == wm.ourSide()
-                 && ( p->pos().x > wm.ball().pos().x - 10.0
-                      || p->pos().x > 30.0 ) )
-            {
-                pos_count *= 2.0;
-            }
-        }
+        if ( e.uncertainty_ <= 0.0 ) continue;
 
-        double base_val = std::pow( pos_count, 2 );
-        double rate = std::exp( - std::pow( p->distFromSelf(), 2 )
-                                / ( 2.0 * std::pow( 20.0, 2 ) ) ); // Magic Number
-        score += base_val * rate;
+        const double value = InformationValue::see_value( e, next_self_pos );
+        score += value;
 
         double buf = std::min( ( angle - left_angle ).abs(),
                                ( angle - right_angle ).abs() );
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::ACTION,
-                      "__ %c_%d (%.2f %.2f) count=%d base=%f rate=%f +%f buf=%.1f",
+                      "__ %c_%d (%.2f %.2f) count=%d uncertainty=%f relevance=%f +%f buf=%.1f",
                       p->side() == LEFT ? 'L' : p->side() == RIGHT ? 'R' : 'N',
                       p->unum(),
                       p->pos().x, p->pos().y,
                       p->posCount(),
-                      base_val, rate, base_val * rate,
+                      e.uncertainty_, e.relevance_, value,
                       buf );
 #endif
 
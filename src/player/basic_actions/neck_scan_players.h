@@ -100,15 +100,13 @@ public:
 
 private:
     /*!
-      \brief calculate score of range [left_angle, right_angle]
-      \param wm world model
+      \brief calculate score of range [left_angle, right_angle] from InformationValue
       \param next_self_pos next agent position
       \param left_angle search range: global angle
       \param right_angle search range: global angle
      */
     static
-    double calculate_score( const rcsc::WorldModel & wm,
-                            const rcsc::Vector2D & next_self_pos,
+    double calculate_score( const rcsc::Vector2D & next_self_pos,
                             const rcsc::AngleDeg & left_angle,
                             const rcsc::AngleDeg & right_angle );
 
@@ -0,0 +1,233 @@
+// -*-c++-*-
+
+/*!
+  \file self_motion_cache.cpp
+  \brief per-cycle self motion cache Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "self_motion_cache.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+// #define DEBUG_PRINT
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SelfMotionCache::SelfMotionCache()
+    : M_update_time( -1, 0 ),
+      M_simulated_count( 0 ),
+      M_request_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SelfMotionCache &
+SelfMotionCache::instance()
+{
+    static SelfMotionCache s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SelfMotionCache::update( const WorldModel & wm )
+{
+    if ( M_update_time == wm.time()
+         && M_self_pos == wm.self().pos()
+         && M_self_vel == wm.self().vel() )
+    {
+        return;
+    }
+
+#ifdef DEBUG_PRINT
+    if ( M_request_count > 0 )
+    {
+        dlog.addText( Logger::DRIBBLE,
+                      __FILE__": (update) previous cycle: motions=%d requests=%d simulated steps=%d",
+                      static_cast< int >( M_entries.size() ),
+                      M_request_count, M_simulated_count );
+    }
+#endif
+
+    M_update_time = wm.time();
+    M_self_pos = wm.self().pos();
+    M_self_vel = wm.self().vel();
+
+    M_entries.clear();
+    M_simulated_count = 0;
+    M_request_count = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const SelfMotionCache::Motion &
+SelfMotionCache::get( const WorldModel & wm,
+                      const int n_turn,
+                      const int n_dash,
+                      const double dash_power,
+                      const AngleDeg & dash_dir,
+                      const double stamina_reserve,
+                      const bool normalize_accel )
+{
+    update( wm );
+
+    ++M_request_count;
+
+    const Key key( n_turn, dash_power, dash_dir.degree(), stamina_reserve, normalize_accel );
+
+    std::map< Key, Entry >::iterator it = M_entries.find( key );
+    if ( it == M_entries.end() )
+    {
+        it = M_entries.insert( std::make_pair( key, Entry() ) ).first;
+        createMotion( wm, n_turn, &it->second );
+    }
+
+    const int size = 1 + n_turn + n_dash;
+    if ( static_cast< int >( it->second.motion_.pos_.size() ) < size )
+    {
+        extendMotion( wm, size, dash_power, dash_dir,
+                      stamina_reserve, normalize_accel,
+                      &it->second );
+    }
+
+    return it->second.motion_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SelfMotionCache::createMotion( const WorldModel & wm,
+                               const int n_turn,
+                               Entry * entry )
+{
+    const PlayerType & ptype = wm.self().playerType();
+
+    Motion & motion = entry->motion_;
+    motion.pos_.reserve( 1 + n_turn + 12 );
+    motion.stamina_.reserve( 1 + n_turn + 12 );
+
+    Vector2D my_pos = wm.self().pos();
+    Vector2D my_vel = wm.self().vel();
+    StaminaModel stamina_model = wm.self().staminaModel();
+
+    // 1 kick + turns
+    for ( int i = 0; i < 1 + n_turn; ++i )
+    {
+        my_pos += my_vel;
+        my_vel *= ptype.playerDecay();
+        stamina_model.simulateWait( ptype );
+
+        motion.pos_.push_back( my_pos );
+        motion.stamina_.push_back( stamina_model.stamina() );
+    }
+
+    entry->vel_ = my_vel;
+    entry->stamina_model_ = stamina_model;
+
+    M_simulated_count += 1 + n_turn;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SelfMotionCache::extendMotion( const WorldModel & wm,
+                               const int size,
+                               const double dash_power,
+                               const AngleDeg & dash_dir,
+                               const double stamina_reserve,
+                               const bool normalize_accel,
+                               Entry * entry )
+{
+    const PlayerType & ptype = wm.self().playerType();
+
+    Motion & motion = entry->motion_;
+    Vector2D my_pos = motion.pos_.back();
+    Vector2D my_vel = entry->vel_;
+    StaminaModel & stamina_model = entry->stamina_model_;
+
+    const int n_dash = size - static_cast< int >( motion.pos_.size() );
+    for ( int i = 0; i < n_dash; ++i )
+    {
+        const double available_stamina = std::max( 0.0, stamina_model.stamina() - stamina_reserve );
+        double consumed_stamina = ( dash_power > 0.0
+                                    ? dash_power
+                                    : dash_power * -2.0 );
+        consumed_stamina = std::min( available_stamina, consumed_stamina );
+        double used_power = ( dash_power > 0.0
+                              ? consumed_stamina
+                              : consumed_stamina * -0.5 );
+
+        const double max_accel_mag = ( std::fabs( used_power )
+                                       * ptype.dashPowerRate()
+                                       * stamina_model.effort() );
+        double accel_mag = max_accel_mag;
+        if ( normalize_accel
+             && max_accel_mag > 0.0
+             && ptype.normalizeAccel( my_vel, dash_dir, &accel_mag ) )
+        {
+            used_power *= accel_mag / max_accel_mag;
+        }
+
+        my_vel += Vector2D::polar2vector( accel_mag, dash_dir );
+        my_pos += my_vel;
+        my_vel *= ptype.playerDecay();
+        stamina_model.simulateDash( ptype, used_power );
+
+        motion.pos_.push_back( my_pos );
+        motion.stamina_.push_back( stamina_model.stamina() );
+    }
+
+    entry->vel_ = my_vel;
+
+    M_simulated_count += n_dash;
+}
@@ -0,0 +1,145 @@
+// -*-c++-*-
+
+/*!
+  \file self_motion_cache.h
+  \brief per-cycle self motion cache Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef SELF_MOTION_CACHE_H
+#define SELF_MOTION_CACHE_H
+
+#include <rcsc/player/stamina_model.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+#include <map>
+#include <tuple>
+
+namespace rcsc {
+class WorldModel;
+}
+
+/*!
+  \class SelfMotionCache
+  \brief per-cycle cache of the self positions after one kick, turns and dashes.
+
+  A motion is identified by (turn count, dash power, dash direction) and
+  the dash model of the caller, and is simulated lazily on the first
+  request. A later request with a larger dash count extends the stored
+  motion, so the shorter motions are the prefixes of the longer one and
+  are never simulated twice. The cache is shared by the dribble
+  generators and Body_Dribble2008, each keeping its own dash model.
+ */
+class SelfMotionCache {
+public:
+
+    /*!
+      \brief simulated self motion.
+      the first element is the state just after the kick, followed by
+      the states after each turn and each dash.
+     */
+    struct Motion {
+        std::vector< rcsc::Vector2D > pos_; //!< self positions
+        std::vector< double > stamina_; //!< stamina values
+    };
+
+private:
+
+    //! turn count, dash power, dash direction, stamina reserve, accel normalization
+    typedef std::tuple< int, double, double, double, bool > Key;
+
+    struct Entry {
+        Motion motion_;
+        rcsc::Vector2D vel_; //!< velocity after the last element
+        rcsc::StaminaModel stamina_model_; //!< stamina after the last element
+    };
+
+    rcsc::GameTime M_update_time;
+    rcsc::Vector2D M_self_pos;
+    rcsc::Vector2D M_self_vel;
+
+    std::map< Key, Entry > M_entries;
+
+    int M_simulated_count;
+    int M_request_count;
+
+    // private for singleton
+    SelfMotionCache();
+
+    // not used
+    SelfMotionCache( const SelfMotionCache & );
+    SelfMotionCache & operator=( const SelfMotionCache & );
+
+public:
+
+    /*!
+      \brief get the singleton instance
+     */
+    static
+    SelfMotionCache & instance();
+
+    /*!
+      \brief get the motion. simulate it if not yet.
+      \param wm world model
+      \param n_turn the number of turns after the kick
+      \param n_dash the number of dashes after the turns
+      \param dash_power dash power. negative value means back dash.
+      \param dash_dir global direction of the dash acceleration
+      \param stamina_reserve stamina kept unused by the dashes. negative value
+      means that the extra stamina can be used.
+      \param normalize_accel if true, the acceleration is capped by the player speed max
+      \return the motion that has at least (1 + n_turn + n_dash) elements.
+      the reference is valid until the next cycle.
+     */
+    const Motion & get( const rcsc::WorldModel & wm,
+                        const int n_turn,
+                        const int n_dash,
+                        const double dash_power,
+                        const rcsc::AngleDeg & dash_dir,
+                        const double stamina_reserve,
+                        const bool normalize_accel );
+
+private:
+
+    void update( const rcsc::WorldModel & wm );
+
+    void createMotion( const rcsc::WorldModel & wm,
+                       const int n_turn,
+                       Entry * entry );
+    void extendMotion( const rcsc::WorldModel & wm,
+                       const int size,
+                       const double dash_power,
+                       const rcsc::AngleDeg & dash_dir,
+                       const double stamina_reserve,
+                       const bool normalize_accel,
+                       Entry * entry );
+};
+
+#endif
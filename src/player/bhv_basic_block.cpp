@@ -10,6 +10,7 @@
 #endif
 #include "bhv_basic_block.h"
 #include "strategy.h"
+#include "team_shared_memory.h"
 #include "bhv_basic_tackle.h"
 #include "neck_offensive_intercept_neck.h"
 
@@ -60,7 +61,16 @@ bool Bhv_BasicBlock::execute(PlayerAgent *agent)
         return false;
     }
 
-    std::pair<int, Vector2D> best_blocker_target = get_best_blocker(agent, tm_blockers);
+    std::pair<int, Vector2D> best_blocker_target;
+    if (!TeamSharedMemory::instance().enabled()
+        || !TeamSharedMemory::instance().fetchBlock(wm, &best_blocker_target.first, &best_blocker_target.second))
+    {
+        best_blocker_target = get_best_blocker(agent, tm_blockers);
+        if (TeamSharedMemory::instance().enabled())
+        {
+            TeamSharedMemory::instance().publishBlock(wm, best_blocker_target.first, best_blocker_target.second);
+        }
+    }
     if (best_blocker_target.first != self_unum)
     {
         last_block_cycle = -1;
@@ -12,6 +12,9 @@
 
 #include "strategy.h"
 #include "bhv_unmark.h"
+#include "team_shared_memory.h"
+#include "coach_opponent_model.h"
+#include "thread_pool.h"
 #include "intention_receive.h"
 #include "planner/field_analyzer.h"
 #include <vector>
@@ -21,6 +24,8 @@
 #include "basic_actions/body_go_to_point.h"
 #include "basic_actions/neck_turn_to_ball_or_scan.h"
 #include <rcsc/math_util.h>
+#include <rcsc/soccer_math.h>
+#include <rcsc/common/player_type.h>
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/intercept_table.h>
 #include <rcsc/common/logger.h>
@@ -36,12 +41,12 @@ using namespace rcsc;
 
 // static bool debug = false;
 Bhv_Unmark::UnmarkPosition Bhv_Unmark::last_unmark_position = UnmarkPosition();
+Bhv_Unmark::PasserTree Bhv_Unmark::passer_tree = PasserTree();
 DeepNueralNetwork * Bhv_Unmark::pass_prediction = new DeepNueralNetwork();
 
 
 bool Bhv_Unmark::execute(PlayerAgent *agent) {
     const WorldModel &wm = agent->world();
-    int passer = find_passer_dnn(wm,agent);
     if (!can_unmarking(wm))
         return false;
 
@@ -80,6 +85,8 @@ bool Bhv_Unmark::execute(PlayerAgent *agent) {
     // std::cout << wm.time().cycle()  << "ed___ " << wm.self().unum() << " __ "  << passer << std::endl;
     // passer = passer_finder(agent);
 
+    // the passer is predicted only after the cheap checks are passed
+    int passer = find_passer_dnn(wm,agent);
     dlog.addText(Logger::POSITIONING, "Should unmarking for %d", passer);
     if (passer == 0)
         return false;
@@ -217,24 +224,35 @@ void Bhv_Unmark::simulate_dash(rcsc::PlayerAgent *agent, int tm,
             }
         }
     }
+    const bool debug = dlog.isEnabled(Logger::POSITIONING);
+
+    // the targets passed the filters below. their passes are simulated at once.
+    vector<int> target_ids;
+    vector<Vector2D> targets;
     int position_id = 0;
     for (auto target: positions){
         position_id += 1;
-        dlog.addText(Logger::POSITIONING, "# %d ##### (%.1f,%.1f)", position_id, target.x, target.y);
-        char num[8];
-        snprintf(num, 8, "%d", position_id);
-        dlog.addMessage(Logger::POSITIONING, target + Vector2D(0, 0), num);
+        if (debug) {
+            dlog.addText(Logger::POSITIONING, "# %d ##### (%.1f,%.1f)", position_id, target.x, target.y);
+            char num[8];
+            snprintf(num, 8, "%d", position_id);
+            dlog.addMessage(Logger::POSITIONING, target + Vector2D(0, 0), num);
+        }
         if (target.x > offside_lineX) {
-            dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
-            dlog.addText(Logger::POSITIONING, "---- more than offside");
+            if (debug) {
+                dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
+                dlog.addText(Logger::POSITIONING, "---- more than offside");
+            }
             continue;
         }
 
         double home_max_dist = 7;
 
         if (target.dist(home_pos) > home_max_dist) {
-            dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
-            dlog.addText(Logger::POSITIONING, "---- far to home pos");
+            if (debug) {
+                dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
+                dlog.addText(Logger::POSITIONING, "---- far to home pos");
+            }
             continue;
         }
 
@@ -242,31 +260,44 @@ void Bhv_Unmark::simulate_dash(rcsc::PlayerAgent *agent, int tm,
                 ServerParam::i().theirPenaltyArea().contains(target) ?
                 5 : 8;
         if (nearest_tm_dist_to(wm, target) < min_tm_dist) {
-            dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
-            dlog.addText(Logger::POSITIONING, "---- close to tm");
+            if (debug) {
+                dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
+                dlog.addText(Logger::POSITIONING, "---- close to tm");
+            }
             continue;
         }
         if (target.absX() > 52 || target.absY() > 31.5) {
-            dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
-            dlog.addText(Logger::POSITIONING, "---- out of field");
+            if (debug) {
+                dlog.addCircle(Logger::POSITIONING, target, 0.5, 255, 0, 0);
+                dlog.addText(Logger::POSITIONING, "---- out of field");
+            }
             continue;
         }
 
-        vector<UnmakingPass> passes;
-        lead_pass_simulator(wm, passer_pos, target, //0,
-         passes);
+        target_ids.push_back(position_id);
+        targets.push_back(target);
+    }
+
+    vector<vector<UnmakingPass>> target_passes;
+    lead_pass_simulator(wm, passer_pos, targets, target_passes);
+
+    for (size_t i = 0; i < targets.size(); i++){
+        const Vector2D &target = targets[i];
+        vector<UnmakingPass> &passes = target_passes[i];
 
         if (!passes.empty()) {
             double pos_eval = 0;
-            UnmarkPosition new_pos(position_id, ball_pos, target, pos_eval, passes);
+            UnmarkPosition new_pos(target_ids[i], ball_pos, target, pos_eval, passes);
             pos_eval = evaluate_position(wm, new_pos);
             new_pos.eval = pos_eval;
-            dlog.addCircle(Logger::POSITIONING, target, 0.5, 0, 0, 255);
-            dlog.addText(Logger::POSITIONING, "---- OK (%.1f, %.1f) passes: %d eval: %.1f", target.x,
-                         target.y, passes.size(), pos_eval);
+            if (debug) {
+                dlog.addCircle(Logger::POSITIONING, target, 0.5, 0, 0, 255);
+                dlog.addText(Logger::POSITIONING, "---- # %d OK (%.1f, %.1f) passes: %d eval: %.1f", target_ids[i],
+                             target.x, target.y, passes.size(), pos_eval);
+            }
             unmark_positions.push_back(new_pos);
-        } else {
-            dlog.addText(Logger::POSITIONING, "---- NOK no pass");
+        } else if (debug) {
+            dlog.addText(Logger::POSITIONING, "---- # %d NOK no pass", target_ids[i]);
             dlog.addCircle(Logger::POSITIONING, target, 0.5, 0, 0, 0);
         }
     }
@@ -300,41 +331,139 @@ double passSpeed(double dist_ball_to_unmark_target, double dist_unmark_to_pass_t
     return pass_speed;
 }
 void Bhv_Unmark::lead_pass_simulator(const WorldModel &wm, Vector2D passer_pos,
-                                     Vector2D unmark_target, //int n_step,
-                                      vector<UnmakingPass> &passes) {
+                                     const vector<Vector2D> &unmark_targets,
+                                     vector<vector<UnmakingPass>> &passes) {
+    const ServerParam &SP = ServerParam::i();
+    const bool debug = dlog.isEnabled(Logger::POSITIONING);
 
     int mate_min = wm.interceptTable().teammateStep();
     Vector2D pass_start = wm.ball().inertiaPoint(mate_min);
-    // Vector2D current_self_pos = wm.self().pos();
-
-    vector<Vector2D> pass_targets;
-    for (double dist = 0; dist <= 3; dist += 3.0){
-        for (double angle = -180; angle < 180; angle += 90){
-            pass_targets.push_back(unmark_target + Vector2D::polar2vector(dist, angle));
-            if (dist == 0)
-                break;
+
+    passes.clear();
+    passes.resize(unmark_targets.size());
+
+    // the passes of all targets, one array for each value
+    vector<int> pass_owner;
+    vector<Vector2D> pass_target_cont;
+    vector<double> pass_dir_x;
+    vector<double> pass_dir_y;
+    vector<double> pass_speed_cont;
+    vector<int> pass_speed_index;
+    vector<int> pass_cycle_cont;
+    vector<double> speeds;
+    int max_cycle = 0;
+
+    for (size_t i = 0; i < unmark_targets.size(); i++){
+        const Vector2D &unmark_target = unmark_targets[i];
+        for (double dist = 0; dist <= 3; dist += 3.0){
+            for (double angle = -180; angle < 180; angle += 90){
+                Vector2D pass_target = unmark_target + Vector2D::polar2vector(dist, angle);
+                double pass_speed = passSpeed(passer_pos.dist(unmark_target), unmark_target.dist(pass_target));
+                int pass_cycle = pass_travel_cycle(pass_start, pass_speed, pass_target);
+                Vector2D pass_dir = Vector2D::polar2vector(1.0, (pass_target - pass_start).th());
+
+                size_t s = 0;
+                while (s < speeds.size() && speeds[s] != pass_speed)
+                    s++;
+                if (s == speeds.size())
+                    speeds.push_back(pass_speed);
+
+                pass_owner.push_back(i);
+                pass_target_cont.push_back(pass_target);
+                pass_dir_x.push_back(pass_dir.x);
+                pass_dir_y.push_back(pass_dir.y);
+                pass_speed_cont.push_back(pass_speed);
+                pass_speed_index.push_back(s);
+                pass_cycle_cont.push_back(pass_cycle);
+                max_cycle = std::max(max_cycle, pass_cycle);
+                if (dist == 0)
+                    break;
+            }
+        }
+    }
+
+    if (pass_owner.empty())
+        return;
+
+    const int row = max_cycle + 1;
+
+    // ball travel distance of each pass speed
+    vector<double> ball_travel(speeds.size() * row, 0.0);
+    for (size_t s = 0; s < speeds.size(); s++){
+        for (int c = 1; c <= max_cycle; c++){
+            ball_travel[s * row + c] = inertia_n_step_distance(speeds[s], c, SP.ballDecay());
         }
     }
-    for (auto & pass_target: pass_targets){
-        double pass_speed = passSpeed(passer_pos.dist(unmark_target), unmark_target.dist(pass_target));
-        int pass_cycle = pass_travel_cycle(pass_start, pass_speed, pass_target);
-        int min_opp_cut_cycle = opponents_cycle_intercept(wm, pass_start, pass_speed,
-                                                          pass_target, pass_cycle);
 
+    // squared distance from which each opponent reaches the ball in each cycle
+    vector<double> opp_x;
+    vector<double> opp_y;
+    vector<double> opp_reach2;
+    for (auto &opp: wm.opponentsFromSelf()) {
+        if (opp == nullptr || opp->playerTypePtr() == nullptr)
+            continue;
+        const PlayerType *opp_type = opp->playerTypePtr();
+        const vector<double> &dash_table = opp_type->dashDistanceTable();
+        opp_x.push_back(opp->pos().x);
+        opp_y.push_back(opp->pos().y);
+        opp_reach2.resize(opp_reach2.size() + row, 0.0);
+        double *reach2 = &opp_reach2[opp_reach2.size() - row];
+        for (int c = 1; c <= max_cycle; c++){
+            // the same threshold as PlayerType::cyclesToReachDistance() <= c
+            double reach_dist = (static_cast<size_t>(c) <= dash_table.size()
+                                 ? dash_table[c - 1] + 0.001
+                                 : (dash_table.empty() ? 0.0 : dash_table.back())
+                                   + (c - static_cast<int>(dash_table.size())) * opp_type->realSpeedMax());
+            reach_dist += 0.5;
+            reach2[c] = reach_dist * reach_dist;
+        }
+    }
+    const size_t opp_size = opp_x.size();
+
+    // the first cycle an opponent can cut each pass. computed in parallel into own slots.
+    vector<int> opp_cut_cycle(pass_owner.size(), 1000);
+    ThreadPool::instance().parallelFor(
+        "unmark_lead_pass", 0, static_cast<int>(pass_owner.size()), 32,
+        [&](const int begin, const int end) {
+            for (int p = begin; p < end; p++){
+                const int pass_cycle = pass_cycle_cont[p];
+                const double *travel = &ball_travel[pass_speed_index[p] * row];
+
+                for (int c = 1; c <= pass_cycle; c++){
+                    const double ball_x = pass_start.x + pass_dir_x[p] * travel[c];
+                    const double ball_y = pass_start.y + pass_dir_y[p] * travel[c];
+                    bool reach = false;
+                    for (size_t o = 0; o < opp_size; o++){
+                        const double dx = ball_x - opp_x[o];
+                        const double dy = ball_y - opp_y[o];
+                        reach |= (dx * dx + dy * dy <= opp_reach2[o * row + c]);
+                    }
+                    if (reach) {
+                        opp_cut_cycle[p] = c;
+                        break;
+                    }
+                }
+            }
+        });
+
+    for (size_t p = 0; p < pass_owner.size(); p++){
+        const Vector2D &pass_target = pass_target_cont[p];
+        const int pass_cycle = pass_cycle_cont[p];
+        const int min_opp_cut_cycle = opp_cut_cycle[p];
 
         if (pass_cycle < min_opp_cut_cycle) {
-            dlog.addText(Logger::POSITIONING,
-                         "------pass_start(%.1f,%.1f), pass_target(%.1f,%.1f), self_cycle(%d), opp_cycle(%d) OK",
-                         pass_start.x, pass_start.y, pass_target.x, pass_target.y,
-                         pass_cycle, min_opp_cut_cycle);
+            if (debug) {
+                dlog.addText(Logger::POSITIONING,
+                             "------pass_start(%.1f,%.1f), pass_target(%.1f,%.1f), self_cycle(%d), opp_cycle(%d) OK",
+                             pass_start.x, pass_start.y, pass_target.x, pass_target.y,
+                             pass_cycle, min_opp_cut_cycle);
+                dlog.addCircle(Logger::POSITIONING, pass_target, 0.1, 0, 0, 200);
+            }
             double pass_eval = pass_target.x + std::max(0.0, 40.0 - pass_target.dist(Vector2D(50.0, 0)));
 
-            UnmakingPass pass_obj = UnmakingPass(pass_target, pass_speed,
-                                                 pass_eval, pass_cycle);
-
-            passes.push_back(pass_obj);
-            dlog.addCircle(Logger::POSITIONING, pass_target, 0.1, 0, 0, 200);
-        } else {
+            passes[pass_owner[p]].push_back(UnmakingPass(pass_target, pass_speed_cont[p],
+                                                         pass_eval, pass_cycle));
+        } else if (debug) {
             dlog.addCircle(Logger::POSITIONING, pass_target, 0.1, 255, 0, 0);
             dlog.addText(Logger::POSITIONING,
                          "------pass_start(%.1f,%.1f), pass_target(%.1f,%.1f), self_cycle(%d), opp_cycle(%d) NOT OK",
@@ -342,7 +471,6 @@ void Bhv_Unmark::lead_pass_simulator(const WorldModel &wm, Vector2D passer_pos,
                          pass_cycle, min_opp_cut_cycle);
         }
     }
-
 }
 
 int Bhv_Unmark::pass_travel_cycle(Vector2D pass_start, double pass_speed, Vector2D &pass_target) {
@@ -352,56 +480,16 @@ int Bhv_Unmark::pass_travel_cycle(Vector2D pass_start, double pass_speed, Vector
     return static_cast<int>(cycle);
 }
 
-int Bhv_Unmark::opponents_cycle_intercept(const WorldModel &wm,
-                                          Vector2D pass_start, double pass_speed,
-                                          Vector2D pass_target,
-                                          int pass_cycle) {
-    int min_cycle = 1000;
-    for (auto &opp: wm.opponentsFromSelf()) {
-        if (opp == nullptr)
-            continue;
-        int opp_cycle = opponent_cycle_intercept(opp, pass_start, pass_speed, pass_target, pass_cycle);
-        if (min_cycle > opp_cycle)
-            min_cycle = opp_cycle;
-        if (min_cycle <= pass_cycle)
-            break;
-    }
-    return min_cycle;
-
-}
-
-int Bhv_Unmark::opponent_cycle_intercept(const AbstractPlayerObject *opp, Vector2D pass_start, double pass_speed,
-                                         Vector2D pass_target, int pass_cycle) {
-
-    const ServerParam &SP = ServerParam::i();
-
-    AngleDeg pass_angle = (pass_target - pass_start).th();
-
-    Vector2D pass_start_vel = Vector2D::polar2vector(pass_speed, pass_angle);
-    Vector2D opp_pos = (*opp).pos();
-
-    const PlayerType *opp_type = (*opp).playerTypePtr();
-
-    for (int cycle = 1; cycle <= pass_cycle; cycle++) {
-        const Vector2D ball_pos = inertia_n_step_point(pass_start,
-                                                       pass_start_vel, cycle, SP.ballDecay());
-
-        double dash_dist = ball_pos.dist(opp_pos);
-        dash_dist -= 0.5;
-
-        int n_dash = opp_type->cyclesToReachDistance(dash_dist);
-        int n_step = n_dash;
-        if (n_step <= cycle) {
-            return cycle;
-        }
-    }
-    return 1000;
-}
-
 double Bhv_Unmark::evaluate_position(const WorldModel &wm, const UnmarkPosition &unmark_position) {
     double sum_eval = 0;
     double best_pass_eval = 0;
+    // farther than the opponents' usual marking distance is already free.
+    // the distance is measured by the coach, so it is looked up instead of guessing 10m.
     double opp_eval = 10;
+    const CoachOpponentModel &om = CoachOpponentModel::i();
+    if (om.isValid(wm.time())) {
+        opp_eval = bound(3.0, om.value(CoachOpponentModel::MARK_DIST) * 1.5, 10.0);
+    }
     for (auto &i: unmark_position.pass_list) {
         if (best_pass_eval < i.pass_eval)
             best_pass_eval = i.pass_eval;
@@ -499,17 +587,83 @@ vector<pass_prob> Bhv_Unmark::predict_pass_dnn(vector<double> & features, vector
 
 
 int Bhv_Unmark::find_passer_dnn(const WorldModel & wm, PlayerAgent * agent){
-    dlog.addText(Logger::POSITIONING, "############### Start Update Passer DNN ###########");
-    DEState state = DEState(wm);
-
     int fastest_tm = 0;
     if (wm.interceptTable().firstTeammate() != nullptr)
         fastest_tm = wm.interceptTable().firstTeammate()->unum();
     if (fastest_tm < 1)
         return 0;
     int tm_reach_cycle = wm.interceptTable().teammateStep();
-    if (!state.updateKicker(fastest_tm, wm.ball().inertiaPoint(tm_reach_cycle)))
-        return 0;
+    Vector2D trap_pos = wm.ball().inertiaPoint(tm_reach_cycle);
+
+    if (passer_tree_is_valid(wm, fastest_tm, trap_pos)) {
+        dlog.addText(Logger::POSITIONING, "reuse the passer tree of cycle %ld holder %d",
+                     passer_tree.time.cycle(), passer_tree.holder);
+    } else {
+        passer_tree.passes.clear();
+        vector<pair<int, int>> shared_passes;
+        if (TeamSharedMemory::instance().enabled()
+            && TeamSharedMemory::instance().fetchPasserTree(wm, fastest_tm, trap_pos, shared_passes)) {
+            for (auto &p : shared_passes)
+                passer_tree.passes.push_back(pass_prob(0.0, p.first, p.second));
+        } else {
+            create_passer_tree(wm, fastest_tm, trap_pos, passer_tree.passes);
+            if (TeamSharedMemory::instance().enabled()) {
+                for (auto &p : passer_tree.passes)
+                    shared_passes.push_back(make_pair(p.pass_sender, p.pass_getter));
+                TeamSharedMemory::instance().publishPasserTree(wm, fastest_tm, trap_pos, shared_passes);
+            }
+        }
+        passer_tree.holder = fastest_tm;
+        passer_tree.trap_pos = trap_pos;
+        passer_tree.time = wm.time();
+    }
+
+    vector<unmark_passer> res;
+    for (auto &p : passer_tree.passes)
+    {
+        if (wm.ourPlayer(p.pass_sender) == nullptr || wm.ourPlayer(p.pass_getter) == nullptr)
+            continue;
+        Vector2D kicker_pos = wm.ourPlayer(p.pass_sender)->pos();
+        Vector2D target_pos = wm.ourPlayer(p.pass_getter)->pos();
+        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(-0.2, 0), target_pos - Vector2D(-0.2, 0));
+        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(-0.1, 0), target_pos - Vector2D(-0.1, 0));
+        dlog.addLine(Logger::POSITIONING,kicker_pos, target_pos);
+        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(0.2, 0), target_pos - Vector2D(0.2, 0));
+        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(0.1, 0), target_pos - Vector2D(0.1, 0));
+        dlog.addCircle(Logger::POSITIONING, target_pos, 2);
+
+        if (p.pass_getter == wm.self().unum())
+            res.push_back(unmark_passer(p.pass_sender, kicker_pos, wm.interceptTable().opponentStep()));
+    }
+    if (!res.empty()){
+        return res[0].unum;
+    }
+    return 0;
+}
+
+bool Bhv_Unmark::passer_tree_is_valid(const WorldModel & wm, int holder, const Vector2D & trap_pos){
+    static const int max_age = 3; // Magic Number
+    static const double max_trap_move = 2.0; // Magic Number
+
+    if (!passer_tree.trap_pos.isValid() || passer_tree.holder != holder)
+        return false;
+    int age = wm.time().cycle() - passer_tree.time.cycle();
+    if (age == 0)
+        age = wm.time().stopped() - passer_tree.time.stopped();
+    if (age < 0 || age >= max_age)
+        return false;
+    if (passer_tree.trap_pos.dist(trap_pos) > max_trap_move)
+        return false;
+    return true;
+}
+
+void Bhv_Unmark::create_passer_tree(const WorldModel & wm, int holder, const Vector2D & trap_pos, vector<pass_prob> & best_passes){
+    dlog.addText(Logger::POSITIONING, "############### Start Update Passer DNN ###########");
+    DEState state = DEState(wm);
+
+    int fastest_tm = holder;
+    if (!state.updateKicker(fastest_tm, trap_pos))
+        return;
 
     vector<int> ignored_player;
     string ignored = "";
@@ -520,7 +674,6 @@ int Bhv_Unmark::find_passer_dnn(const WorldModel & wm, PlayerAgent * agent){
         }
     }
     dlog.addText(Logger::POSITIONING, "ignored: %s", ignored.c_str());
-    vector<pass_prob> best_passes;
     vector<pass_prob> all_passes;
     all_passes.push_back(pass_prob(100.0, 0, fastest_tm));
 
@@ -555,25 +708,5 @@ int Bhv_Unmark::find_passer_dnn(const WorldModel & wm, PlayerAgent * agent){
             }
         }
     }
-
-    vector<unmark_passer> res;
-    for (auto &p : best_passes)
-    {
-        Vector2D kicker_pos = wm.ourPlayer(p.pass_sender)->pos();
-        Vector2D target_pos = wm.ourPlayer(p.pass_getter)->pos();
-        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(-0.2, 0), target_pos - Vector2D(-0.2, 0));
-        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(-0.1, 0), target_pos - Vector2D(-0.1, 0));
-        dlog.addLine(Logger::POSITIONING,kicker_pos, target_pos);
-        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(0.2, 0), target_pos - Vector2D(0.2, 0));
-        dlog.addLine(Logger::POSITIONING,kicker_pos - Vector2D(0.1, 0), target_pos - Vector2D(0.1, 0));
-        dlog.addCircle(Logger::POSITIONING, target_pos, 2);
-
-        if (p.pass_getter == wm.self().unum())
-            res.push_back(unmark_passer(p.pass_sender, kicker_pos, wm.interceptTable().opponentStep()));
-    }
-    if (!res.empty()){
-        return res[0].unum;
-    }
-    return 0;
 }
 // */
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/player/soccer_action.h>
 #include <rcsc/player/abstract_player_object.h>
+#include <rcsc/game_time.h>
 #include <utility>
 #include <vector>
 #include <CppDNN/DeepNueralNetwork.h>
@@ -86,6 +87,16 @@ public:
 
     static UnmarkPosition last_unmark_position;
 
+    // the passes predicted from the ball holder. the same for all teammates.
+    struct PasserTree {
+        int holder = 0;
+        Vector2D trap_pos = Vector2D::INVALIDATED;
+        GameTime time = GameTime(-1, 0);
+        vector<pass_prob> passes;
+    };
+
+    static PasserTree passer_tree;
+
     bool execute(PlayerAgent *agent) override;
 
     bool can_unmarking(const rcsc::WorldModel &wm);
@@ -97,23 +108,14 @@ public:
     double nearest_tm_dist_to(const WorldModel &wm,
                               Vector2D point);
 
+    // simulates the lead passes to all targets at once. passes[i] is for unmark_targets[i].
     void lead_pass_simulator(const WorldModel &wm,
                              Vector2D passer_pos,
-                             Vector2D unmark_target,
-                            //  int n_step,
-                             vector<UnmakingPass> &passes);
+                             const vector<Vector2D> &unmark_targets,
+                             vector<vector<UnmakingPass>> &passes);
 
     int pass_travel_cycle(Vector2D pass_start, double pass_speed, Vector2D &pass_target);
 
-    int opponents_cycle_intercept(const WorldModel &wm,
-                                  Vector2D pass_start,
-                                  double pass_speed,
-                                  Vector2D pass_target,
-                                  int pass_cycle);
-
-    int opponent_cycle_intercept(const AbstractPlayerObject *opp, Vector2D pass_start, double pass_speed,
-                                 Vector2D pass_target, int pass_cycle);
-
     double evaluate_position(const WorldModel &wm, const UnmarkPosition &unmark_position);
 
     bool run(PlayerAgent *agent, const UnmarkPosition &unmark_position);
@@ -126,6 +128,10 @@ public:
 
     int find_passer_dnn(const WorldModel & wm, PlayerAgent * agent);
 
+    static bool passer_tree_is_valid(const WorldModel & wm, int holder, const Vector2D & trap_pos);
+
+    void create_passer_tree(const WorldModel & wm, int holder, const Vector2D & trap_pos, vector<pass_prob> & best_passes);
+
 };
 
 
@@ -0,0 +1,86 @@
+// -*-c++-*-
+
+/*!
+  \file coach_opponent_model.cpp
+  \brief opponent model received from the coach Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "coach_opponent_model.h"
+
+#include <rcsc/common/logger.h>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachOpponentModel::CoachOpponentModel()
+    : M_received_time( -1, 0 )
+{
+    for ( int i = 0; i < VALUE_SIZE; ++i )
+    {
+        M_value[i] = 0.0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachOpponentModel &
+CoachOpponentModel::instance()
+{
+    static CoachOpponentModel s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachOpponentModel::setValues( const GameTime & time,
+                               const double * values )
+{
+    M_received_time = time;
+    for ( int i = 0; i < VALUE_SIZE; ++i )
+    {
+        M_value[i] = values[i];
+    }
+
+    dlog.addText( Logger::WORLD,
+                  __FILE__": coach opponent model centroid=(%.1f %.1f) spread=(%.1f %.1f)"
+                  " line=%.1f mark=%.2f chase=%.2f",
+                  M_value[CENTROID_X], M_value[CENTROID_Y],
+                  M_value[SPREAD_X], M_value[SPREAD_Y],
+                  M_value[DEFENSE_LINE_X], M_value[MARK_DIST], M_value[CHASE_SPEED] );
+}
@@ -0,0 +1,120 @@
+// -*-c++-*-
+
+/*!
+  \file coach_opponent_model.h
+  \brief opponent model received from the coach Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef COACH_OPPONENT_MODEL_H
+#define COACH_OPPONENT_MODEL_H
+
+#include <rcsc/game_time.h>
+
+/*!
+  \class CoachOpponentModel
+  \brief the latest opponent model broadcast by our coach.
+
+  The coach computes the statistics from its noise free view, so the
+  players can look them up instead of estimating them every cycle.
+  The values are in our team's coordinates. See OpponentModel in the
+  coach for their definitions.
+ */
+class CoachOpponentModel {
+public:
+
+    //! the values in the message order. the same as the coach's OpponentModel::Value.
+    enum Value {
+        CENTROID_X,
+        CENTROID_Y,
+        SPREAD_X,
+        SPREAD_Y,
+        DEFENSE_LINE_X,
+        MARK_DIST,
+        CHASE_SPEED,
+        VALUE_SIZE
+    };
+
+    //! the period in which the received values are used. the coach resends every 300 cycles.
+    static const int VALID_PERIOD = 1000;
+
+private:
+
+    rcsc::GameTime M_received_time;
+    double M_value[VALUE_SIZE];
+
+    CoachOpponentModel();
+
+    // not used
+    CoachOpponentModel( const CoachOpponentModel & );
+    const CoachOpponentModel & operator=( const CoachOpponentModel & );
+public:
+
+    static
+    CoachOpponentModel & instance();
+
+    static
+    const CoachOpponentModel & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief set the received values
+      \param time the time when the message was received
+      \param values values in the order of Value
+     */
+    void setValues( const rcsc::GameTime & time,
+                    const double * values );
+
+    //! false until the first message is received
+    bool received() const
+      {
+          return M_received_time.cycle() >= 0;
+      }
+
+    const rcsc::GameTime & receivedTime() const
+      {
+          return M_received_time;
+      }
+
+    /*!
+      \brief check if the values are received recently enough to be used
+      \param current current game time
+     */
+    bool isValid( const rcsc::GameTime & current ) const
+      {
+          return received()
+              && current.cycle() - M_received_time.cycle() < VALID_PERIOD;
+      }
+
+    double value( const Value v ) const
+      {
+          return M_value[v];
+      }
+};
+
+#endif
@@ -22,6 +22,7 @@
 
 double invalid_data_ = -2.0;
 bool OffensiveDataExtractor::active = false;
+std::string OffensiveDataExtractor::output_dir = "/data1/nader/workspace/robo/base_data/";
 
 using namespace rcsc;
 
@@ -60,7 +61,9 @@ void OffensiveDataExtractor::init_file(DEState &state) {
     time(&rawtime);
     timeinfo = localtime(&rawtime);
 
-    std::string dir = "/data1/nader/workspace/robo/base_data/";
+    std::string dir = output_dir;
+    if (!dir.empty() && dir.back() != '/')
+        dir += "/";
     strftime(buffer, sizeof(buffer), "%Y-%m-%d-%H-%M-%S", timeinfo);
     std::string str(buffer);
     std::string rand_name = std::to_string(SamplePlayer::player_port);
@@ -62,6 +62,7 @@ public:
     //accessors
     static OffensiveDataExtractor &i();
     static bool active;
+    static std::string output_dir;
 
     void extract_output(DEState &state,
                         int category,
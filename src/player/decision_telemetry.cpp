@@ -0,0 +1,224 @@
+// -*-c++-*-
+
+/*!
+  \file decision_telemetry.cpp
+  \brief per-cycle decision telemetry Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "decision_telemetry.h"
+
+#include "action_chain_graph.h"
+#include "cooperative_action.h"
+
+#include <rcsc/player/world_model.h>
+
+#include <iostream>
+#include <cstdio>
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+const char *
+category_name( const CooperativeAction::ActionCategory category )
+{
+    switch ( category ) {
+    case CooperativeAction::Hold:
+        return "hold";
+    case CooperativeAction::Dribble:
+        return "dribble";
+    case CooperativeAction::Pass:
+        return "pass";
+    case CooperativeAction::Shoot:
+        return "shoot";
+    case CooperativeAction::Clear:
+        return "clear";
+    case CooperativeAction::Move:
+        return "move";
+    default:
+        break;
+    }
+    return "none";
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DecisionTelemetry::DecisionTelemetry()
+    : M_output_dir(),
+      M_open_failed( false ),
+      M_pending( false ),
+      M_cycle( 0 ),
+      M_stopped( 0 ),
+      M_play_on( false ),
+      M_kickable( false ),
+      M_planner_msec( 0.0 ),
+      M_chain_count( 0 ),
+      M_chain_length( 0 ),
+      M_category( "pre" )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DecisionTelemetry::~DecisionTelemetry()
+{
+    flush();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DecisionTelemetry &
+DecisionTelemetry::instance()
+{
+    static DecisionTelemetry s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+DecisionTelemetry::open( const WorldModel & wm )
+{
+    if ( M_fout.is_open() )
+    {
+        return true;
+    }
+
+    if ( M_open_failed )
+    {
+        return false;
+    }
+
+    const std::string path = M_output_dir + '/' + wm.ourTeamName()
+        + '-' + std::to_string( wm.self().unum() ) + ".telemetry";
+
+    M_fout.open( path.c_str() );
+    if ( ! M_fout )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " could not open the telemetry file [" << path << ']'
+                  << std::endl;
+        M_open_failed = true;
+        return false;
+    }
+
+    M_fout << "# cycle stopped play_on kickable planner_msec chain_count chain_length category\n";
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DecisionTelemetry::flush()
+{
+    if ( ! M_pending
+         || ! M_fout.is_open() )
+    {
+        return;
+    }
+
+    char buf[128];
+    std::snprintf( buf, sizeof( buf ), "%ld %ld %d %d %.3f %d %d %s\n",
+                   M_cycle, M_stopped,
+                   M_play_on ? 1 : 0,
+                   M_kickable ? 1 : 0,
+                   M_planner_msec,
+                   M_chain_count,
+                   M_chain_length,
+                   M_category );
+    M_fout << buf;
+
+    M_pending = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DecisionTelemetry::update( const WorldModel & wm )
+{
+    if ( ! enabled()
+         || ! open( wm ) )
+    {
+        return;
+    }
+
+    flush();
+
+    M_pending = true;
+    M_cycle = wm.time().cycle();
+    M_stopped = wm.time().stopped();
+    M_play_on = ( wm.gameMode().type() == GameMode::PlayOn );
+    M_kickable = wm.self().isKickable();
+    M_planner_msec = 0.0;
+    M_chain_count = 0;
+    M_chain_length = 0;
+    M_category = "pre";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DecisionTelemetry::setPlannerResult( const ActionChainGraph & graph,
+                                     const bool reused,
+                                     const double msec )
+{
+    if ( ! M_pending )
+    {
+        return;
+    }
+
+    M_planner_msec = msec;
+    // no chain was evaluated in this cycle
+    M_chain_count = ( reused ? 0 : graph.chainCount() );
+    M_chain_length = static_cast< int >( graph.getAllChain().size() );
+    M_category = ( graph.getAllChain().empty()
+                   ? "none"
+                   : category_name( graph.getFirstAction().category() ) );
+}
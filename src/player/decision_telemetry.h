@@ -0,0 +1,126 @@
+// -*-c++-*-
+
+/*!
+  \file decision_telemetry.h
+  \brief per-cycle decision telemetry Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef DECISION_TELEMETRY_H
+#define DECISION_TELEMETRY_H
+
+#include <fstream>
+#include <string>
+
+namespace rcsc {
+class WorldModel;
+}
+
+class ActionChainGraph;
+
+/*!
+  \class DecisionTelemetry
+  \brief writes one compact record per decision cycle.
+
+  The record contains the planner result and load of the cycle:
+
+  cycle stopped play_on kickable planner_msec chain_count chain_length category
+
+  chain_count is the number of evaluated chains (0 if the previous chain was
+  reused without the search), and category is the first action of the
+  selected chain, or "pre" if the cycle was handled before the
+  action chain search. The file "<dir>/<team>-<unum>.telemetry" is streamed
+  by scripts/telemetry/analyze_telemetry.py.
+ */
+class DecisionTelemetry {
+private:
+
+    std::string M_output_dir;
+    std::ofstream M_fout;
+    bool M_open_failed;
+
+    // the record of the current cycle
+    bool M_pending;
+    long M_cycle;
+    long M_stopped;
+    bool M_play_on;
+    bool M_kickable;
+    double M_planner_msec;
+    int M_chain_count;
+    int M_chain_length;
+    const char * M_category;
+
+    DecisionTelemetry();
+
+    // not used
+    DecisionTelemetry( const DecisionTelemetry & );
+    const DecisionTelemetry & operator=( const DecisionTelemetry & );
+public:
+
+    ~DecisionTelemetry();
+
+    static
+    DecisionTelemetry & instance();
+
+    /*!
+      \brief enable the telemetry
+      \param output_dir the directory where the record file is written
+     */
+    void setOutputDir( const std::string & output_dir )
+      {
+          M_output_dir = output_dir;
+      }
+
+    bool enabled() const
+      {
+          return ! M_output_dir.empty();
+      }
+
+    /*!
+      \brief write the record of the previous cycle and start a new one.
+      called at the start of each decision.
+      \param wm world model
+     */
+    void update( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief set the result of the action chain search to the current record
+      \param graph the searched graph
+      \param reused true if the graph was reused from the previous cycle
+      \param msec elapsed wall time [ms]
+     */
+    void setPlannerResult( const ActionChainGraph & graph,
+                           const bool reused,
+                           const double msec );
+
+private:
+
+    bool open( const rcsc::WorldModel & wm );
+    void flush();
+};
+
+#endif
@@ -0,0 +1,276 @@
+// -*-c++-*-
+
+/*!
+  \file formation_manifest.cpp
+  \brief formation file manifest and change watcher Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_manifest.h"
+
+#include <fstream>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+const std::string FormationManifest::FILE_NAME = "formations.manifest";
+
+namespace {
+
+std::string
+trim( const std::string & str )
+{
+    const std::string::size_type first = str.find_first_not_of( " \t\r" );
+    if ( first == std::string::npos )
+    {
+        return std::string();
+    }
+
+    const std::string::size_type last = str.find_last_not_of( " \t\r" );
+    return str.substr( first, last - first + 1 );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FormationManifest::FormationManifest()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationManifest::read( const std::string & filepath )
+{
+    M_files.clear();
+
+    std::ifstream fin( filepath.c_str() );
+    if ( ! fin )
+    {
+        // no manifest. default file names are used.
+        return true;
+    }
+
+    std::string line;
+    int n_line = 0;
+    while ( std::getline( fin, line ) )
+    {
+        ++n_line;
+
+        const std::string::size_type comment = line.find( '#' );
+        if ( comment != std::string::npos )
+        {
+            line.erase( comment );
+        }
+
+        line = trim( line );
+        if ( line.empty() )
+        {
+            continue;
+        }
+
+        const std::string::size_type sep = line.find( ':' );
+        if ( sep == std::string::npos )
+        {
+            std::cerr << filepath << ':' << n_line
+                      << ": ***ERROR*** illegal manifest line [" << line << ']'
+                      << std::endl;
+            M_files.clear();
+            return false;
+        }
+
+        const std::string key = trim( line.substr( 0, sep ) );
+        const std::string file_name = trim( line.substr( sep + 1 ) );
+        if ( key.empty()
+             || file_name.empty() )
+        {
+            std::cerr << filepath << ':' << n_line
+                      << ": ***ERROR*** empty key or file name [" << line << ']'
+                      << std::endl;
+            M_files.clear();
+            return false;
+        }
+
+        M_files[key] = file_name;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const std::string &
+FormationManifest::fileName( const std::string & key,
+                             const std::string & default_name ) const
+{
+    std::map< std::string, std::string >::const_iterator it = M_files.find( key );
+    if ( it == M_files.end() )
+    {
+        return default_name;
+    }
+
+    return it->second;
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FormationWatcher::FormationWatcher()
+    : M_fd( -1 ),
+      M_wd( -1 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FormationWatcher::~FormationWatcher()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationWatcher::open( const std::string & dir )
+{
+    close();
+
+#ifdef __linux__
+    M_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if ( M_fd < 0 )
+    {
+        std::cerr << "(FormationWatcher::open) inotify_init1 failed: "
+                  << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    // editors either rewrite the file in place or rename a temporary file.
+    M_wd = inotify_add_watch( M_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+    if ( M_wd < 0 )
+    {
+        std::cerr << "(FormationWatcher::open) could not watch [" << dir << "]: "
+                  << std::strerror( errno ) << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+#else
+    std::cerr << "(FormationWatcher::open) hot reload is not supported on this platform."
+              << " dir=[" << dir << ']' << std::endl;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FormationWatcher::close()
+{
+#ifdef __linux__
+    if ( M_fd >= 0 )
+    {
+        ::close( M_fd );
+    }
+#endif
+    M_fd = -1;
+    M_wd = -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FormationWatcher::poll( std::set< std::string > & changed_files )
+{
+    bool changed = false;
+
+#ifdef __linux__
+    if ( M_fd < 0 )
+    {
+        return false;
+    }
+
+    alignas( struct inotify_event ) char buf[4096];
+
+    while ( true )
+    {
+        const ssize_t len = ::read( M_fd, buf, sizeof( buf ) );
+        if ( len <= 0 )
+        {
+            // EAGAIN: no more pending events.
+            break;
+        }
+
+        for ( const char * ptr = buf; ptr < buf + len; )
+        {
+            const struct inotify_event * event
+                = reinterpret_cast< const struct inotify_event * >( ptr );
+            if ( event->len > 0 )
+            {
+                changed_files.insert( std::string( event->name ) );
+                changed = true;
+            }
+            ptr += sizeof( struct inotify_event ) + event->len;
+        }
+    }
+#else
+    (void)changed_files;
+#endif
+
+    return changed;
+}
@@ -0,0 +1,126 @@
+// -*-c++-*-
+
+/*!
+  \file formation_manifest.h
+  \brief formation file manifest and change watcher Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef FORMATION_MANIFEST_H
+#define FORMATION_MANIFEST_H
+
+#include <map>
+#include <set>
+#include <string>
+
+/*!
+  \class FormationManifest
+  \brief mapping from the formation keys used by Strategy to file names.
+
+  The manifest is a plain text file in the formation directory.
+  Each line has the form "key : file_name". '#' starts a comment.
+  Keys that are not listed fall back to the default file names.
+ */
+class FormationManifest {
+public:
+    static const std::string FILE_NAME;
+
+private:
+    std::map< std::string, std::string > M_files;
+
+public:
+
+    FormationManifest();
+
+    /*!
+      \brief read the manifest file
+      \param filepath manifest file path
+      \return false if the file exists but could not be parsed
+     */
+    bool read( const std::string & filepath );
+
+    void clear()
+      {
+          M_files.clear();
+      }
+
+    bool empty() const
+      {
+          return M_files.empty();
+      }
+
+    /*!
+      \brief get the file name registered for the key
+      \param key formation key
+      \param default_name file name used if the key is not registered
+     */
+    const std::string & fileName( const std::string & key,
+                                  const std::string & default_name ) const;
+};
+
+/*!
+  \class FormationWatcher
+  \brief non-blocking watcher of modified files in the formation directory.
+
+  The inotify interface is used on Linux. On other platforms, the watcher
+  is never opened and poll() always returns false.
+ */
+class FormationWatcher {
+private:
+    int M_fd;
+    int M_wd;
+
+    // not used
+    FormationWatcher( const FormationWatcher & );
+    const FormationWatcher & operator=( const FormationWatcher & );
+public:
+
+    FormationWatcher();
+    ~FormationWatcher();
+
+    /*!
+      \brief start watching the directory
+      \param dir directory path
+      \return result of the initialization
+     */
+    bool open( const std::string & dir );
+
+    void close();
+
+    bool isOpen() const
+      {
+          return M_fd >= 0;
+      }
+
+    /*!
+      \brief read the pending events without blocking
+      \param changed_files the names of written files are inserted
+      \return true if at least one file was changed
+     */
+    bool poll( std::set< std::string > & changed_files );
+};
+
+#endif
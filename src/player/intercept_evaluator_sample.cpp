@@ -34,6 +34,7 @@
 #include <rcsc/player/intercept_table.h>
 #include <rcsc/player/world_model.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/soccer_math.h>
 #include <rcsc/common/logger.h>
 
 #include <iostream>
@@ -82,6 +83,49 @@ InterceptEvaluatorSample::~InterceptEvaluatorSample()
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptEvaluatorSample::create_context( const WorldModel & wm,
+                                          Context * ctx )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    ctx->max_x_ = ( SP.keepawayMode()
+                    ? SP.keepawayLength() * 0.5 - 1.0
+                    : SP.pitchHalfLength() - 1.0 );
+    ctx->max_y_ = ( SP.keepawayMode()
+                    ? SP.keepawayWidth() * 0.5 - 1.0
+                    : SP.pitchHalfWidth() - 1.0 );
+
+    ctx->our_goal_kick_ = ( wm.gameMode().type() == GameMode::GoalKick_
+                            && wm.gameMode().side() == wm.ourSide() );
+
+    const int bonus_step = ( wm.interceptTable().firstOpponent()
+                             ? std::min( 5, wm.interceptTable().firstOpponent()->posCount() )
+                             : 0 );
+    ctx->opponent_step_ = wm.interceptTable().opponentStep() - bonus_step;
+    ctx->teammate_step_ = wm.interceptTable().teammateStep();
+
+    ctx->self_pos_ = wm.self().pos();
+    ctx->self_body_ = wm.self().body();
+    ctx->self_stamina_ = wm.self().stamina();
+    ctx->kickable_area_ = wm.self().playerType().kickableArea();
+    ctx->fast_speed_thr_ = wm.self().playerType().realSpeedMax() * 0.8;
+    ctx->offside_line_x_ = wm.offsideLineX();
+
+    ctx->ball_pos_ = wm.ball().pos();
+    ctx->ball_vel_ = wm.ball().vel();
+    ctx->ball_speed_ = wm.ball().vel().r();
+    ctx->ball_vel_angle_ = wm.ball().vel().th();
+
+    // 2021-06-18
+    ctx->kickable_opponent_back_ = ( wm.kickableOpponent()
+                                     && ( wm.ball().angleFromSelf() - wm.self().body() ).abs() > 40.0 );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -90,6 +134,42 @@ double
 InterceptEvaluatorSample::evaluate( const WorldModel & wm,
                                     const Intercept & action,
                                     const bool save_recovery )
+{
+    Context ctx;
+    create_context( wm, &ctx );
+
+    return evaluateImpl( ctx, action, save_recovery );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptEvaluatorSample::evaluateAll( const WorldModel & wm,
+                                       const std::vector< Intercept > & actions,
+                                       const bool save_recovery,
+                                       std::vector< double > * values )
+{
+    Context ctx;
+    create_context( wm, &ctx );
+
+    values->resize( actions.size() );
+
+    for ( std::size_t i = 0; i < actions.size(); ++i )
+    {
+        (*values)[i] = evaluateImpl( ctx, actions[i], save_recovery );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+InterceptEvaluatorSample::evaluateImpl( const Context & ctx,
+                                        const Intercept & action,
+                                        const bool save_recovery )
 {
     ++M_count;
 
@@ -109,16 +189,10 @@ InterceptEvaluatorSample::evaluate( const WorldModel & wm,
     }
 
 
-    const ServerParam & SP = ServerParam::i();
-
-    const double max_x = ( SP.keepawayMode()
-                           ? SP.keepawayLength() * 0.5 - 1.0
-                           : SP.pitchHalfLength() - 1.0 );
-    const double max_y = ( SP.keepawayMode()
-                           ? SP.keepawayWidth() * 0.5 - 1.0
-                           : SP.pitchHalfWidth() - 1.0 );
-
-    const Vector2D ball_pos = wm.ball().inertiaPoint( action.reachStep() );
+    const Vector2D ball_pos = inertia_n_step_point( ctx.ball_pos_,
+                                                    ctx.ball_vel_,
+                                                    action.reachStep(),
+                                                    ServerParam::i().ballDecay() );
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::INTERCEPT,
@@ -129,8 +203,8 @@ InterceptEvaluatorSample::evaluate( const WorldModel & wm,
 
     double value = 0.0;
 
-    if ( ball_pos.absX() > max_x
-         || ball_pos.absY() > max_y )
+    if ( ball_pos.absX() > ctx.max_x_
+         || ball_pos.absY() > ctx.max_y_ )
     {
         value = -1000.0 - action.reachStep();
 #ifdef DEBUG_PRINT
@@ -142,30 +216,26 @@ InterceptEvaluatorSample::evaluate( const WorldModel & wm,
     }
 
     addShootSpotValue( ball_pos, &value );
-    addOpponentStepValue( wm, ball_pos, action, &value );
-    addTeammateStepValue( wm, ball_pos, action, &value );
-    addTurnPenalty( wm, action, &value );
-    addMoveDistPenalty( wm, ball_pos, action, &value );
-    addBallDistPenalty( wm, action, &value );
-    addStaminaPenalty( wm, action, &value );
-    addBallSpeedPenalty( wm, ball_pos, action, &value );
+    addOpponentStepValue( ctx, ball_pos, action, &value );
+    addTeammateStepValue( ctx, action, &value );
+    addTurnPenalty( ctx, action, &value );
+    addMoveDistPenalty( ctx, ball_pos, action, &value );
+    addBallDistPenalty( ctx, action, &value );
+    addStaminaPenalty( ctx, action, &value );
+    addBallSpeedPenalty( ctx, ball_pos, action, &value );
 
     // 2021-06-18
-    if ( wm.kickableOpponent()
+    if ( ctx.kickable_opponent_back_
          && ( action.actionType() == Intercept::OMNI_DASH
               || action.dashPower() < 0.0 ) )
     {
-        const double angle_diff = ( wm.ball().angleFromSelf() - wm.self().body() ).abs();
-        if ( angle_diff > 40.0 )
-        {
-            double tmp_val = -100.0;
-            value += tmp_val;
+        double tmp_val = -100.0;
+        value += tmp_val;
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "%d: kickable_opp value= %.3f (angle_diff = %.1f) (value_sum = %.3f)",
-                          M_count, tmp_val, angle_diff, value );
+        dlog.addText( Logger::INTERCEPT,
+                      "%d: kickable_opp value= %.3f (value_sum = %.3f)",
+                      M_count, tmp_val, value );
 #endif
-        }
     }
 
     return value;
@@ -201,16 +271,15 @@ InterceptEvaluatorSample::addShootSpotValue( const Vector2D & ball_pos,
  */
 
 void
-InterceptEvaluatorSample::addOpponentStepValue(  const WorldModel & wm,
-                                                 const Vector2D & ball_pos,
-                                                 const Intercept & action,
-                                                 double * value )
+InterceptEvaluatorSample::addOpponentStepValue( const Context & ctx,
+                                                const Vector2D & ball_pos,
+                                                const Intercept & action,
+                                                double * value )
 {
     const ServerParam & SP = ServerParam::i();
     double tmp_val = 0.0;
 
-    if ( wm.gameMode().type() == GameMode::GoalKick_
-         && wm.gameMode().side() == wm.ourSide()
+    if ( ctx.our_goal_kick_
          && ball_pos.x < SP.ourPenaltyAreaLineX() - 2.0
          && ball_pos.absY() < SP.penaltyAreaHalfWidth() - 2.0 )
     {
@@ -218,11 +287,7 @@ InterceptEvaluatorSample::addOpponentStepValue(  const WorldModel & wm,
     }
     else
     {
-        const int opponent_step = wm.interceptTable().opponentStep();
-        const int bonus_step = ( wm.interceptTable().firstOpponent()
-                                 ? std::min( 5, wm.interceptTable().firstOpponent()->posCount() )
-                                 : 0 );
-        const int evaluate_step = opponent_step - bonus_step;
+        const int evaluate_step = ctx.opponent_step_;
         if ( evaluate_step <= action.reachStep() + 3 )
         {
             tmp_val = ( evaluate_step - ( action.reachStep() + 3 ) ) * 5.0;
@@ -244,12 +309,11 @@ InterceptEvaluatorSample::addOpponentStepValue(  const WorldModel & wm,
  */
 
 void
-InterceptEvaluatorSample::addTeammateStepValue( const WorldModel & wm,
-                                                const Vector2D & /*ball_pos*/,
+InterceptEvaluatorSample::addTeammateStepValue( const Context & ctx,
                                                 const Intercept & action,
                                                 double * value )
 {
-    const int teammate_step = wm.interceptTable().teammateStep();
+    const int teammate_step = ctx.teammate_step_;
     double tmp_val = 0.0;
 
     if ( teammate_step <= action.reachStep() + 3 )
@@ -272,12 +336,12 @@ InterceptEvaluatorSample::addTeammateStepValue( const WorldModel & wm,
  */
 
 void
-InterceptEvaluatorSample::addTurnPenalty( const WorldModel & wm,
+InterceptEvaluatorSample::addTurnPenalty( const Context & ctx,
                                           const Intercept & action,
                                           double * value )
 {
-    const double kickable_area = wm.self().playerType().kickableArea();
-    const AngleDeg body_angle = wm.self().body() + action.turnAngle();
+    const double kickable_area = ctx.kickable_area_;
+    const AngleDeg body_angle = ctx.self_body_ + action.turnAngle();
     double tmp_val = 0.0;
 
     if ( action.actionType() == Intercept::TURN_FORWARD_DASH
@@ -317,7 +381,7 @@ InterceptEvaluatorSample::addTurnPenalty( const WorldModel & wm,
                       "%d: (intercept eval) turn back penalty = %.3f (%.3f)",
                       M_count, tmp_val, *value );
 #endif
-        if ( ( wm.self().body() - body_angle ).abs() > 90.0 )
+        if ( ( ctx.self_body_ - body_angle ).abs() > 90.0 )
         {
             tmp_val = -0.001;
             *value += tmp_val;
@@ -337,16 +401,16 @@ InterceptEvaluatorSample::addTurnPenalty( const WorldModel & wm,
  */
 
 void
-InterceptEvaluatorSample::addMoveDistPenalty( const WorldModel & wm,
+InterceptEvaluatorSample::addMoveDistPenalty( const Context & ctx,
                                               const Vector2D & ball_pos,
                                               const Intercept & action,
                                               double * value )
 {
-    const double kickable_area = wm.self().playerType().kickableArea();
-    double move_dist = action.selfPos().dist( wm.self().pos() );
+    const double kickable_area = ctx.kickable_area_;
+    double move_dist = action.selfPos().dist( ctx.self_pos_ );
     double tmp_val = 0.0;
 
-    if ( ball_pos.x < wm.offsideLineX() )
+    if ( ball_pos.x < ctx.offside_line_x_ )
     {
         tmp_val = move_dist * -0.3; //-0.1;
     }
@@ -371,11 +435,11 @@ InterceptEvaluatorSample::addMoveDistPenalty( const WorldModel & wm,
  */
 
 void
-InterceptEvaluatorSample::addBallDistPenalty( const WorldModel & wm,
+InterceptEvaluatorSample::addBallDistPenalty( const Context & ctx,
                                               const Intercept & action,
                                               double * value )
 {
-    const double kickable_area = wm.self().playerType().kickableArea();
+    const double kickable_area = ctx.kickable_area_;
     double tmp_val = 0.0;
 
     if ( action.ballDist() > kickable_area - 0.4 )
@@ -395,11 +459,11 @@ InterceptEvaluatorSample::addBallDistPenalty( const WorldModel & wm,
 
  */
 void
-InterceptEvaluatorSample::addStaminaPenalty( const WorldModel & wm,
+InterceptEvaluatorSample::addStaminaPenalty( const Context & ctx,
                                              const Intercept & action,
                                              double * value )
 {
-    double tmp_val = ( action.stamina() - wm.self().stamina() ) * 0.0001;
+    double tmp_val = ( action.stamina() - ctx.self_stamina_ ) * 0.0001;
     *value += tmp_val;
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::INTERCEPT,
@@ -416,25 +480,25 @@ InterceptEvaluatorSample::addStaminaPenalty( const WorldModel & wm,
  */
 
 void
-InterceptEvaluatorSample::addBallSpeedPenalty( const WorldModel & wm,
+InterceptEvaluatorSample::addBallSpeedPenalty( const Context & ctx,
                                                const Vector2D & ball_pos,
                                                const Intercept & action,
                                                double * value )
 {
     const ServerParam & SP = ServerParam::i();
 
-    const double kickable_area = wm.self().playerType().kickableArea();
-    const double fast_speed_thr = wm.self().playerType().realSpeedMax() * 0.8;
+    const double kickable_area = ctx.kickable_area_;
+    const double fast_speed_thr = ctx.fast_speed_thr_;
     const double slow_ball_speed_thr = 0.55;
-    const double first_ball_speed = wm.ball().vel().r();
-    const AngleDeg ball_vel_angle = wm.ball().vel().th();
+    const double first_ball_speed = ctx.ball_speed_;
+    const AngleDeg ball_vel_angle = ctx.ball_vel_angle_;
 
-    const AngleDeg body_angle = wm.self().body() + action.turnAngle();
+    const AngleDeg body_angle = ctx.self_body_ + action.turnAngle();
     const double ball_speed = first_ball_speed * std::pow( SP.ballDecay(), action.reachStep() );
     double tmp_val = 0.0;
 
     if ( ( body_angle - ball_vel_angle ).abs() < 30.0 //aligned_body_angle_to_ball_move_line
-         && Segment2D( wm.ball().pos(), ball_pos ).dist( wm.self().pos() ) < kickable_area - 0.3 )
+         && Segment2D( ctx.ball_pos_, ball_pos ).dist( ctx.self_pos_ ) < kickable_area - 0.3 )
     {
         if ( ball_speed < fast_speed_thr )
         {
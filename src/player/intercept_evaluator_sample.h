@@ -30,6 +30,9 @@
 #include "basic_actions/intercept_evaluator.h"
 
 #include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/angle_deg.h>
+
+#include <vector>
 
 /*!
   \class InterceptEvaluatorSample
@@ -38,6 +41,33 @@
 class InterceptEvaluatorSample
     : public InterceptEvaluator {
 private:
+
+    /*!
+      \brief world model values shared by all candidates in the same cycle
+     */
+    struct Context {
+        double max_x_;
+        double max_y_;
+
+        bool our_goal_kick_;
+        int opponent_step_; //!< opponent step reduced by its accuracy bonus
+        int teammate_step_;
+
+        rcsc::Vector2D self_pos_;
+        rcsc::AngleDeg self_body_;
+        double self_stamina_;
+        double kickable_area_;
+        double fast_speed_thr_;
+        double offside_line_x_;
+
+        rcsc::Vector2D ball_pos_;
+        rcsc::Vector2D ball_vel_;
+        double ball_speed_;
+        rcsc::AngleDeg ball_vel_angle_;
+
+        bool kickable_opponent_back_; //!< kickable opponent exists and the ball is behind our body
+    };
+
     int M_count ;
 
 public:
@@ -51,38 +81,52 @@ public:
     double evaluate( const rcsc::WorldModel & wm,
                      const rcsc::Intercept & action,
                      const bool save_recovery ) override;
+
+    virtual
+    void evaluateAll( const rcsc::WorldModel & wm,
+                      const std::vector< rcsc::Intercept > & actions,
+                      const bool save_recovery,
+                      std::vector< double > * values ) override;
 private:
+
+    static
+    void create_context( const rcsc::WorldModel & wm,
+                         Context * ctx );
+
+    double evaluateImpl( const Context & ctx,
+                         const rcsc::Intercept & action,
+                         const bool save_recovery );
+
     void addShootSpotValue( const rcsc::Vector2D & ball_pos,
                             double * value );
 
-    void addOpponentStepValue(  const rcsc::WorldModel & wm,
-                                const rcsc::Vector2D & ball_pos,
-                                const rcsc::Intercept & action,
-                                double * value );
-
-    void addTeammateStepValue( const rcsc::WorldModel & wm,
+    void addOpponentStepValue( const Context & ctx,
                                const rcsc::Vector2D & ball_pos,
                                const rcsc::Intercept & action,
                                double * value );
 
-    void addTurnPenalty( const rcsc::WorldModel & wm,
+    void addTeammateStepValue( const Context & ctx,
+                               const rcsc::Intercept & action,
+                               double * value );
+
+    void addTurnPenalty( const Context & ctx,
                          const rcsc::Intercept & action,
                          double * value );
 
-    void addMoveDistPenalty( const rcsc::WorldModel & wm,
+    void addMoveDistPenalty( const Context & ctx,
                              const rcsc::Vector2D & ball_pos,
                              const rcsc::Intercept & action,
                              double * value );
 
-    void addBallDistPenalty( const rcsc::WorldModel & wm,
+    void addBallDistPenalty( const Context & ctx,
                              const rcsc::Intercept & action,
                              double * value );
 
-    void addStaminaPenalty( const rcsc::WorldModel & wm,
+    void addStaminaPenalty( const Context & ctx,
                             const rcsc::Intercept & action,
                             double * value );
 
-    void addBallSpeedPenalty( const rcsc::WorldModel & wm,
+    void addBallSpeedPenalty( const Context & ctx,
                               const rcsc::Vector2D & ball_pos,
                               const rcsc::Intercept & action,
                               double * value );
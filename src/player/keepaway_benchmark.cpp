@@ -0,0 +1,170 @@
+// -*-c++-*-
+
+/*!
+  \file keepaway_benchmark.cpp
+  \brief keeper side statistics of the keepaway benchmark Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "keepaway_benchmark.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/server_param.h>
+
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KeepawayBenchmark::KeepawayBenchmark()
+    : M_result_dir(),
+      M_unum( 0 ),
+      M_last_cycle( -1 ),
+      M_decision_count( 0 ),
+      M_planner_msec_sum( 0.0 ),
+      M_planner_msec_max( 0.0 ),
+      M_play_on_count( 0 ),
+      M_missed_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KeepawayBenchmark::~KeepawayBenchmark()
+{
+    if ( enabled()
+         && M_unum != 0 )
+    {
+        write();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KeepawayBenchmark &
+KeepawayBenchmark::instance()
+{
+    static KeepawayBenchmark s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KeepawayBenchmark::update( const WorldModel & wm )
+{
+    if ( ! enabled()
+         || ! ServerParam::i().keepawayMode() )
+    {
+        return;
+    }
+
+    M_unum = wm.self().unum();
+
+    if ( wm.gameMode().type() != GameMode::PlayOn
+         || wm.time().stopped() > 0 )
+    {
+        M_last_cycle = -1;
+        return;
+    }
+
+    ++M_play_on_count;
+
+    if ( M_last_cycle >= 0
+         && wm.time().cycle() > M_last_cycle + 1 )
+    {
+        M_missed_count += wm.time().cycle() - M_last_cycle - 1;
+    }
+
+    M_last_cycle = wm.time().cycle();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KeepawayBenchmark::addPlannerTime( const WorldModel & wm,
+                                   const double msec )
+{
+    if ( ! enabled()
+         || ! ServerParam::i().keepawayMode()
+         || ! wm.self().isKickable()
+         || wm.gameMode().type() != GameMode::PlayOn )
+    {
+        return;
+    }
+
+    ++M_decision_count;
+    M_planner_msec_sum += msec;
+    M_planner_msec_max = std::max( M_planner_msec_max, msec );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KeepawayBenchmark::write() const
+{
+    const std::string path = M_result_dir + "/keeper-" + std::to_string( M_unum ) + ".txt";
+
+    std::ofstream fout( path.c_str() );
+    if ( ! fout )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " could not open the keepaway result file [" << path << ']'
+                  << std::endl;
+        return false;
+    }
+
+    fout << "unum " << M_unum << '\n'
+         << "decisions " << M_decision_count << '\n'
+         << "planner_msec_mean "
+         << ( M_decision_count > 0 ? M_planner_msec_sum / M_decision_count : 0.0 ) << '\n'
+         << "planner_msec_max " << M_planner_msec_max << '\n'
+         << "play_on_cycles " << M_play_on_count << '\n'
+         << "missed_cycles " << M_missed_count << '\n';
+
+    fout.flush();
+    return fout.good();
+}
@@ -0,0 +1,112 @@
+// -*-c++-*-
+
+/*!
+  \file keepaway_benchmark.h
+  \brief keeper side statistics of the keepaway benchmark Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef KEEPAWAY_BENCHMARK_H
+#define KEEPAWAY_BENCHMARK_H
+
+#include <string>
+
+namespace rcsc {
+class WorldModel;
+}
+
+/*!
+  \class KeepawayBenchmark
+  \brief collects the planner load of a keeper during the keepaway benchmark.
+
+  The episode lengths are recorded by the trainer. Each keeper records
+  the wall time of the action chain search for every cycle it holds the
+  ball, and the play_on cycles in which no decision was made. The summary
+  is written to "<dir>/keeper-<unum>.txt" when the process exits.
+ */
+class KeepawayBenchmark {
+private:
+
+    std::string M_result_dir;
+
+    int M_unum;
+    long M_last_cycle;
+
+    long M_decision_count;
+    double M_planner_msec_sum;
+    double M_planner_msec_max;
+
+    long M_play_on_count;
+    long M_missed_count;
+
+    KeepawayBenchmark();
+
+    // not used
+    KeepawayBenchmark( const KeepawayBenchmark & );
+    const KeepawayBenchmark & operator=( const KeepawayBenchmark & );
+public:
+
+    ~KeepawayBenchmark();
+
+    static
+    KeepawayBenchmark & instance();
+
+    /*!
+      \brief enable the benchmark
+      \param result_dir the directory where the result file is written
+     */
+    void setResultDir( const std::string & result_dir )
+      {
+          M_result_dir = result_dir;
+      }
+
+    bool enabled() const
+      {
+          return ! M_result_dir.empty();
+      }
+
+    /*!
+      \brief count the skipped play_on cycles. called at the start of each decision.
+      \param wm world model
+     */
+    void update( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief record the elapsed time of the action chain search
+      \param wm world model
+      \param msec elapsed wall time [ms]
+     */
+    void addPlannerTime( const rcsc::WorldModel & wm,
+                         const double msec );
+
+    /*!
+      \brief write the summary to the result file
+      \return result of the file operation
+     */
+    bool write() const;
+};
+
+#endif
@@ -0,0 +1,389 @@
+// -*-c++-*-
+
+/*!
+  \file packed_say_codec.cpp
+  \brief table driven mixed radix codec for say messages Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "packed_say_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief minimal unsigned big integer for the mixed radix conversion.
+  limbs are stored from the least significant one.
+ */
+class BigUInt {
+private:
+    std::vector< std::uint32_t > M_limbs;
+
+public:
+
+    BigUInt()
+      { }
+
+    bool isZero() const
+      {
+          return M_limbs.empty();
+      }
+
+    void mulAdd( const std::uint32_t mul,
+                 const std::uint32_t add )
+      {
+          std::uint64_t carry = add;
+          for ( std::uint32_t & limb : M_limbs )
+          {
+              const std::uint64_t v = static_cast< std::uint64_t >( limb ) * mul + carry;
+              limb = static_cast< std::uint32_t >( v );
+              carry = v >> 32;
+          }
+          if ( carry != 0 )
+          {
+              M_limbs.push_back( static_cast< std::uint32_t >( carry ) );
+          }
+      }
+
+    std::uint32_t divMod( const std::uint32_t div )
+      {
+          std::uint64_t rem = 0;
+          for ( std::size_t i = M_limbs.size(); i > 0; --i )
+          {
+              const std::uint64_t v = ( rem << 32 ) | M_limbs[i - 1];
+              M_limbs[i - 1] = static_cast< std::uint32_t >( v / div );
+              rem = v % div;
+          }
+          while ( ! M_limbs.empty()
+                  && M_limbs.back() == 0 )
+          {
+              M_limbs.pop_back();
+          }
+          return static_cast< std::uint32_t >( rem );
+      }
+
+    //! compare with a small value
+    bool lessThan( const std::uint32_t val ) const
+      {
+          if ( M_limbs.empty() ) return 0 < val;
+          if ( M_limbs.size() > 1 ) return false;
+          return M_limbs[0] < val;
+      }
+};
+
+const PackedSayCodec::Field BALL_FIELDS[] = {
+    { "ball_x", -52.5, 52.5, 0.25 },
+    { "ball_y", -34.0, 34.0, 0.25 },
+    { "ball_vx", -3.0, 3.0, 0.05 },
+    { "ball_vy", -3.0, 3.0, 0.05 },
+};
+
+/*-------------------------------------------------------------------*/
+void
+add_player_fields( std::vector< PackedSayCodec::Field > & fields,
+                   const double step )
+{
+    fields.push_back( { "player_number", 1.0, 22.0, 1.0 } );
+    fields.push_back( { "player_x", -52.5, 52.5, step } );
+    fields.push_back( { "player_y", -34.0, 34.0, step } );
+}
+
+/*-------------------------------------------------------------------*/
+std::vector< std::vector< PackedSayCodec::Field > >
+create_layouts()
+{
+    std::vector< std::vector< PackedSayCodec::Field > > layouts( PackedSayCodec::LAYOUT_SIZE );
+
+    // the resolutions are chosen so that each layout fits in at most
+    // 9 characters (TWO_PLAYERS needs 8). see PackedSayCodec::bits().
+
+    // BALL_PLAYER: 49.9 bits
+    layouts[PackedSayCodec::BALL_PLAYER].assign( BALL_FIELDS, BALL_FIELDS + PackedSayCodec::BALL_VALUES );
+    add_player_fields( layouts[PackedSayCodec::BALL_PLAYER], 0.5 );
+
+    // TWO_PLAYERS: 43.8 bits
+    add_player_fields( layouts[PackedSayCodec::TWO_PLAYERS], 0.2 );
+    add_player_fields( layouts[PackedSayCodec::TWO_PLAYERS], 0.2 );
+
+    // THREE_PLAYERS: 53.3 bits
+    add_player_fields( layouts[PackedSayCodec::THREE_PLAYERS], 0.85 );
+    add_player_fields( layouts[PackedSayCodec::THREE_PLAYERS], 0.85 );
+    add_player_fields( layouts[PackedSayCodec::THREE_PLAYERS], 0.85 );
+
+    return layouts;
+}
+
+/*-------------------------------------------------------------------*/
+const std::vector< std::vector< PackedSayCodec::Field > > &
+layouts()
+{
+    static const std::vector< std::vector< PackedSayCodec::Field > > s_layouts = create_layouts();
+    return s_layouts;
+}
+
+/*-------------------------------------------------------------------*/
+std::uint32_t
+base()
+{
+    return static_cast< std::uint32_t >( PackedSayCodec::charset().size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief the capacity of the first character left for the value
+ */
+std::uint32_t
+first_char_capacity()
+{
+    return base() / PackedSayCodec::LAYOUT_SIZE;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief the number of characters following the first character
+ */
+int
+compute_tail_length( const PackedSayCodec::Layout layout )
+{
+    // the maximum value of the layout
+    BigUInt val;
+    for ( const PackedSayCodec::Field & f : layouts()[layout] )
+    {
+        val.mulAdd( f.levels(), f.levels() - 1 );
+    }
+
+    int n = 0;
+    while ( ! val.lessThan( first_char_capacity() ) )
+    {
+        val.divMod( base() );
+        ++n;
+    }
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+const std::vector< int > &
+tail_lengths()
+{
+    static std::vector< int > s_lengths;
+    if ( s_lengths.empty() )
+    {
+        for ( int i = 0; i < PackedSayCodec::LAYOUT_SIZE; ++i )
+        {
+            s_lengths.push_back( compute_tail_length( static_cast< PackedSayCodec::Layout >( i ) ) );
+        }
+    }
+    return s_lengths;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+PackedSayCodec::Field::levels() const
+{
+    return static_cast< int >( std::round( ( max_ - min_ ) / step_ ) ) + 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+PackedSayCodec::Field::quantize( const double value ) const
+{
+    const int symbol = static_cast< int >( std::round( ( value - min_ ) / step_ ) );
+    return std::min( std::max( 0, symbol ), levels() - 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+PackedSayCodec::Field::dequantize( const int symbol ) const
+{
+    return min_ + symbol * step_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const std::string &
+PackedSayCodec::charset()
+{
+    // characters accepted by rcssserver in say messages
+    static const std::string s_charset
+        = "0123456789"
+        "abcdefghijklmnopqrstuvwxyz"
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "().+*/?<>_";
+    return s_charset;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const std::vector< PackedSayCodec::Field > &
+PackedSayCodec::fields( const Layout layout )
+{
+    return layouts()[layout];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+PackedSayCodec::length( const Layout layout )
+{
+    return 1 + tail_lengths()[layout];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+PackedSayCodec::bits( const Layout layout )
+{
+    double result = 0.0;
+    for ( const Field & f : layouts()[layout] )
+    {
+        result += std::log2( static_cast< double >( f.levels() ) );
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PackedSayCodec::encode( const Layout layout,
+                        const std::vector< double > & values,
+                        std::string & to )
+{
+    if ( layout < 0 || LAYOUT_SIZE <= layout )
+    {
+        return false;
+    }
+
+    const std::vector< Field > & f = layouts()[layout];
+    if ( values.size() != f.size() )
+    {
+        return false;
+    }
+
+    // the first field becomes the most significant digit
+    BigUInt val;
+    for ( std::size_t i = 0; i < f.size(); ++i )
+    {
+        val.mulAdd( f[i].levels(), f[i].quantize( values[i] ) );
+    }
+
+    const int tail_len = tail_lengths()[layout];
+    std::string tail( tail_len, charset()[0] );
+    for ( int i = tail_len - 1; i >= 0; --i )
+    {
+        tail[i] = charset()[val.divMod( base() )];
+    }
+
+    // the rest is less than first_char_capacity()
+    const std::uint32_t high = val.divMod( first_char_capacity() );
+
+    to += charset()[layout + LAYOUT_SIZE * high];
+    to += tail;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+PackedSayCodec::decode( const char * msg,
+                        Layout * layout,
+                        std::vector< double > * values )
+{
+    if ( ! msg || *msg == '\0' )
+    {
+        return -1;
+    }
+
+    const std::string::size_type first = charset().find( msg[0] );
+    if ( first == std::string::npos )
+    {
+        return -1;
+    }
+
+    *layout = static_cast< Layout >( first % LAYOUT_SIZE );
+
+    BigUInt val;
+    val.mulAdd( 1, static_cast< std::uint32_t >( first / LAYOUT_SIZE ) );
+
+    const int tail_len = tail_lengths()[*layout];
+    for ( int i = 1; i <= tail_len; ++i )
+    {
+        const std::string::size_type digit = ( msg[i] == '\0'
+                                               ? std::string::npos
+                                               : charset().find( msg[i] ) );
+        if ( digit == std::string::npos )
+        {
+            return -1;
+        }
+        val.mulAdd( base(), static_cast< std::uint32_t >( digit ) );
+    }
+
+    const std::vector< Field > & f = layouts()[*layout];
+    values->resize( f.size() );
+    for ( std::size_t i = f.size(); i > 0; --i )
+    {
+        const int symbol = static_cast< int >( val.divMod( f[i - 1].levels() ) );
+        (*values)[i - 1] = f[i - 1].dequantize( symbol );
+    }
+
+    if ( ! val.isZero() )
+    {
+        // out of range value
+        return -1;
+    }
+
+    return 1 + tail_len;
+}
@@ -0,0 +1,128 @@
+// -*-c++-*-
+
+/*!
+  \file packed_say_codec.h
+  \brief table driven mixed radix codec for say messages Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef PACKED_SAY_CODEC_H
+#define PACKED_SAY_CODEC_H
+
+#include <string>
+#include <vector>
+
+/*!
+  \class PackedSayCodec
+  \brief encodes quantized object states into the say message alphabet.
+
+  All quantized fields of a layout are packed into one big integer in
+  mixed radix, which is then written in base-N over the say alphabet.
+  No bit is lost at character boundaries except for the last character.
+
+  The first character holds the layout id together with the most
+  significant part of the integer, so the message length is known to
+  the decoder without an extra length character.
+ */
+class PackedSayCodec {
+public:
+
+    enum Layout {
+        BALL_PLAYER,   //!< ball position and velocity + one player
+        TWO_PLAYERS,   //!< two players at fine resolution
+        THREE_PLAYERS, //!< three players
+        LAYOUT_SIZE
+    };
+
+    /*!
+      \brief quantization of one value
+     */
+    struct Field {
+        const char * name_;
+        double min_;
+        double max_;
+        double step_;
+
+        int levels() const;
+        int quantize( const double value ) const;
+        double dequantize( const int symbol ) const;
+    };
+
+    //! the number of values of the ball part
+    static const int BALL_VALUES = 4;   // x, y, vx, vy
+    //! the number of values of each player part
+    static const int PLAYER_VALUES = 3; // number(1-11: teammate, 12-22: opponent), x, y
+
+    /*!
+      \brief get the say alphabet
+     */
+    static
+    const std::string & charset();
+
+    /*!
+      \brief get the field table of the layout
+     */
+    static
+    const std::vector< Field > & fields( const Layout layout );
+
+    /*!
+      \brief get the number of characters written by encode()
+     */
+    static
+    int length( const Layout layout );
+
+    /*!
+      \brief get the information amount of the layout
+     */
+    static
+    double bits( const Layout layout );
+
+    /*!
+      \brief encode the values
+      \param layout message layout
+      \param values values in the order of fields( layout )
+      \param to the encoded characters are appended
+      \return false if the number of values is illegal
+     */
+    static
+    bool encode( const Layout layout,
+                 const std::vector< double > & values,
+                 std::string & to );
+
+    /*!
+      \brief decode the values
+      \param msg message string without the header character
+      \param layout decoded layout id
+      \param values decoded values in the order of fields( *layout )
+      \return the number of consumed characters. -1 if failed.
+     */
+    static
+    int decode( const char * msg,
+                Layout * layout,
+                std::vector< double > * values );
+};
+
+#endif
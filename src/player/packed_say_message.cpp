@@ -0,0 +1,162 @@
+// -*-c++-*-
+
+/*!
+  \file packed_say_message.cpp
+  \brief packed say message builder and parser Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "packed_say_message.h"
+
+#include <rcsc/common/audio_memory.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/game_time.h>
+
+#include <iostream>
+
+using namespace rcsc;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PackedSayMessage::appendTo( std::string & to ) const
+{
+    std::string msg;
+    msg += header();
+
+    if ( ! PackedSayCodec::encode( M_layout, M_values, msg ) )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " ***ERROR*** PackedSayMessage. illegal values. layout="
+                  << M_layout << " size=" << M_values.size()
+                  << std::endl;
+        dlog.addText( Logger::SENSOR,
+                      __FILE__": (PackedSayMessage::appendTo) illegal values. layout=%d size=%d",
+                      M_layout, (int)M_values.size() );
+        return false;
+    }
+
+    if ( static_cast< int >( msg.length() ) != length() )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " ***ERROR*** PackedSayMessage. illegal length = "
+                  << msg.length() << " [" << msg << ']'
+                  << std::endl;
+        return false;
+    }
+
+    to += msg;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+PackedSayMessage::printDebug( std::ostream & os ) const
+{
+    os << "[Packed:" << M_layout;
+    const std::vector< PackedSayCodec::Field > & fields = PackedSayCodec::fields( M_layout );
+    for ( std::size_t i = 0; i < fields.size() && i < M_values.size(); ++i )
+    {
+        os << ' ' << fields[i].name_ << '=' << M_values[i];
+    }
+    os << ']';
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PackedSayMessageParser::PackedSayMessageParser( std::shared_ptr< AudioMemory > memory )
+    : M_memory( memory )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+PackedSayMessageParser::parse( const int sender,
+                               const double & ,
+                               const char * msg,
+                               const GameTime & current )
+{
+    if ( *msg != header() ) return 0;
+
+    PackedSayCodec::Layout layout;
+    std::vector< double > values;
+
+    const int n_read = PackedSayCodec::decode( msg + 1, &layout, &values );
+    if ( n_read < 0 )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " ***ERROR*** PackedSayMessageParser::parse()"
+                  << " could not decode [" << msg << ']'
+                  << std::endl;
+        dlog.addText( Logger::SENSOR,
+                      __FILE__": (PackedSayMessageParser) could not decode [%s]",
+                      msg );
+        return -1;
+    }
+
+    std::size_t idx = 0;
+
+    if ( layout == PackedSayCodec::BALL_PLAYER )
+    {
+        const Vector2D ball_pos( values[0], values[1] );
+        const Vector2D ball_vel( values[2], values[3] );
+        M_memory->setBall( sender, ball_pos, ball_vel, current );
+        idx = PackedSayCodec::BALL_VALUES;
+    }
+
+    for ( ; idx + PackedSayCodec::PLAYER_VALUES <= values.size(); idx += PackedSayCodec::PLAYER_VALUES )
+    {
+        const int unum = static_cast< int >( values[idx] );
+        const Vector2D pos( values[idx + 1], values[idx + 2] );
+        M_memory->setPlayer( sender, unum, pos, current );
+
+        dlog.addText( Logger::SENSOR,
+                      __FILE__": (PackedSayMessageParser) sender=%d player=%d (%.2f %.2f)",
+                      sender, unum, pos.x, pos.y );
+    }
+
+    return 1 + n_read;
+}
@@ -0,0 +1,143 @@
+// -*-c++-*-
+
+/*!
+  \file packed_say_message.h
+  \brief packed say message builder and parser Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef PACKED_SAY_MESSAGE_H
+#define PACKED_SAY_MESSAGE_H
+
+#include "packed_say_codec.h"
+
+#include <rcsc/player/say_message_builder.h>
+#include <rcsc/common/say_message_parser.h>
+
+#include <memory>
+#include <vector>
+
+namespace rcsc {
+class AudioMemory;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class PackedSayMessage
+  \brief say message encoded by PackedSayCodec
+
+  format:
+  "z<layout and values:N>"
+  the length of the message depends on the layout.
+ */
+class PackedSayMessage
+    : public rcsc::SayMessage {
+private:
+    PackedSayCodec::Layout M_layout;
+    std::vector< double > M_values;
+
+public:
+
+    /*!
+      \brief construct with raw values
+      \param layout message layout
+      \param values values in the order of PackedSayCodec::fields( layout )
+     */
+    PackedSayMessage( const PackedSayCodec::Layout layout,
+                      const std::vector< double > & values )
+        : M_layout( layout ),
+          M_values( values )
+      { }
+
+    static
+    char sheader()
+      {
+          return 'z';
+      }
+
+    static
+    int slength( const PackedSayCodec::Layout layout )
+      {
+          return 1 + PackedSayCodec::length( layout );
+      }
+
+    char header() const
+      {
+          return sheader();
+      }
+
+    int length() const
+      {
+          return slength( M_layout );
+      }
+
+    bool appendTo( std::string & to ) const;
+
+    std::ostream & printDebug( std::ostream & os ) const;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class PackedSayMessageParser
+  \brief parser for PackedSayMessage
+ */
+class PackedSayMessageParser
+    : public rcsc::SayMessageParser {
+private:
+    //! pointer to the audio memory
+    std::shared_ptr< rcsc::AudioMemory > M_memory;
+
+public:
+
+    /*!
+      \brief construct with audio memory
+      \param memory pointer to the memory
+     */
+    explicit
+    PackedSayMessageParser( std::shared_ptr< rcsc::AudioMemory > memory );
+
+    char header() const
+      {
+          return PackedSayMessage::sheader();
+      }
+
+    /*!
+      \brief virtual method which analyzes audio messages.
+      \param sender sender's uniform number
+      \param dir sender's direction
+      \param msg raw audio message
+      \param current current game time
+      \retval bytes read if success
+      \retval 0 message ID is not match. other parser should be tried.
+      \retval -1 failed to parse
+    */
+    int parse( const int sender,
+               const double & dir,
+               const char * msg,
+               const rcsc::GameTime & current );
+};
+
+#endif
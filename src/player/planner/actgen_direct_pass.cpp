@@ -29,7 +29,7 @@
 #include "actgen_direct_pass.h"
 
 #include "pass.h"
-#include "simple_pass_checker.h"
+#include "reachability_table.h"
 
 #include "predict_state.h"
 #include "action_state_pair.h"
@@ -52,6 +52,9 @@ using namespace rcsc;
 
 static const double SAME_PASSER_POS_THRESHOLD2 = std::pow( 10.0, 2 );
 
+static const double NEAR_PASS_DIST_THR = 4.0;
+static const double FAR_PASS_DIST_THR = 35.0;
+
 namespace {
 
 /*-------------------------------------------------------------------*/
@@ -215,33 +218,38 @@ ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
     }
 
 
-    const SimplePassChecker pass_check;
+    ReachabilityTable::instance().update( current_wm );
+    const ReachabilityTable & table = ReachabilityTable::i();
+
+    const ServerParam & SP = ServerParam::i();
+    const Vector2D from_pos = ( holder->isSelf()
+                                ? state.ball().pos()
+                                : holder->pos() );
+
     int generated_count = 0;
 
-    for ( PredictPlayerObject::Cont::const_iterator it = state.ourPlayers().begin(),
-              end = state.ourPlayers().end();
-          it != end;
-          ++it )
+    for ( int unum = 1; unum <= 11; ++unum )
     {
-        if ( ! (*it)->isValid() ) continue;
+        const PredictPlayerObject * receiver = state.ourPlayerObject( unum );
+        if ( ! receiver->isValid() ) continue;
 
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::ACTION_CHAIN,
-                      "direct: checking to %d", (*it)->unum() );
+                      "direct: checking to %d", receiver->unum() );
 #endif
 
-        if ( (*it)->unum() != Unum_Unknown
-             && old_holder_table[ (*it)->unum() - 1 ] )
+        if ( receiver->unum() != Unum_Unknown
+             && old_holder_table[ receiver->unum() - 1 ] )
         {
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::ACTION_CHAIN,
                           "direct: ignored old holder %d",
-                          (*it)->unum() );
+                          receiver->unum() );
 #endif
             continue;
         }
 
-        if ( (*it)->unum() == state.ballHolderUnum() )
+        if ( receiver->unum() == state.ballHolderUnum() )
         {
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::ACTION_CHAIN,
@@ -250,18 +258,18 @@ ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
             continue;
         }
 
-        if ( (*it)->posCount() > VALID_PLAYER_THRESHOLD
-             || (*it)->isGhost()
-             || (*it)->unum() == Unum_Unknown
-             || (*it)->unumCount() > VALID_PLAYER_THRESHOLD
-             || (*it)->isTackling() )
+        if ( receiver->posCount() > VALID_PLAYER_THRESHOLD
+             || receiver->isGhost()
+             || receiver->unum() == Unum_Unknown
+             || receiver->unumCount() > VALID_PLAYER_THRESHOLD
+             || receiver->isTackling() )
         {
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::ACTION_CHAIN,
                           "direct: can't pass from %d to %d(%.1f %.1f),"
                           " target accuracy low",
                           holder->unum(),
-                          (*it)->unum(), (*it)->pos().x, (*it)->pos().y );
+                          receiver->unum(), receiver->pos().x, receiver->pos().y );
 #endif
             continue;
         }
@@ -270,36 +278,53 @@ ActGen_DirectPass::generate( std::vector< ActionStatePair > * result,
         //
         // check direct pass
         //
-        const double dist = ( (*it)->pos() - holder->pos() ).r();
+        const double dist = from_pos.dist( receiver->pos() );
+
+        if ( dist <= NEAR_PASS_DIST_THR
+             || dist >= FAR_PASS_DIST_THR
+             || receiver->goalie()
+             || receiver->pos().x >= state.offsideLineX()
+             || receiver->pos().absX() >= SP.pitchHalfLength()
+             || receiver->pos().absY() >= SP.pitchHalfWidth()
+             || ( receiver->pos().x <= SP.ourPenaltyAreaLineX() + 3.0
+                  && receiver->pos().absY() <= SP.penaltyAreaHalfWidth() + 3.0 ) )
+        {
+#ifdef DEBUG_PRINT
+            dlog.addText( Logger::ACTION_CHAIN,
+                          "direct: can't pass from %d to %d, illegal receive point",
+                          holder->unum(), receiver->unum() );
+#endif
+            continue;
+        }
 
-        const double ball_speed = s_get_ball_speed_for_pass( ( (*it)->pos() - holder->pos() ).r() );
+        const double ball_speed = s_get_ball_speed_for_pass( dist );
+        const int ball_step = calc_length_geom_series( ball_speed,
+                                                       dist,
+                                                       SP.ballDecay() );
 
-        if ( ! pass_check( state, *holder, **it, (**it).pos(), ball_speed ) )
+        if ( ball_step < 0
+             || ! table.canPass( from_pos, receiver->pos(), ball_speed, ball_step ) )
         {
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::ACTION_CHAIN,
                           "direct: can't pass from %d to %d",
-                          holder->unum(), (*it)->unum() );
+                          holder->unum(), receiver->unum() );
 #endif
             continue;
         }
 
         const unsigned long kick_step = 2;
 
-        const unsigned long spend_time
-            = calc_length_geom_series( ball_speed,
-                                       dist,
-                                       ServerParam::i().ballDecay() )
-            + kick_step;
+        const unsigned long spend_time = ball_step + kick_step;
 
         PredictState::ConstPtr result_state( new PredictState( state,
                                                                spend_time,
-                                                               (*it)->unum(),
-                                                               (*it)->pos() ) );
+                                                               receiver->unum(),
+                                                               receiver->pos() ) );
 
         CooperativeAction::Ptr action( new Pass( holder->unum(),
-                                                 (*it)->unum(),
-                                                 (*it)->pos(),
+                                                 receiver->unum(),
+                                                 receiver->pos(),
                                                  ball_speed,
                                                  spend_time,
                                                  kick_step,
@@ -32,6 +32,7 @@
 
 #include "dribble.h"
 #include "field_analyzer.h"
+#include "reachability_table.h"
 
 #include "action_state_pair.h"
 #include "predict_state.h"
@@ -89,6 +90,9 @@ ActGen_SimpleDribble::generate( std::vector< ActionStatePair > * result,
 
     const int bonus_step = 2;
 
+    ReachabilityTable::instance().update( current_wm );
+    const ReachabilityTable & table = ReachabilityTable::i();
+
     const PlayerType * ptype = holder->playerTypePtr();
 
     int generated_count = 0;
@@ -144,27 +148,15 @@ ActGen_SimpleDribble::generate( std::vector< ActionStatePair > * result,
 
             const int holder_reach_step
                 = 1 + 1  // kick + turn
-                + ptype->cyclesToReachDistance( holder_move_dist - ptype->kickableArea() * 0.5 );
+                + table.teammateReachStep( holder->unum(),
+                                           holder_move_dist - ptype->kickableArea() * 0.5 );
 
             //
             // check opponent
             //
-            bool exist_opponent = false;
-            for ( AbstractPlayerObject::Cont::const_iterator o = state.theirPlayers().begin();
-                  o != state.theirPlayers().end();
-                  ++o )
-            {
-                double opp_move_dist = (*o)->pos().dist( target_point );
-                int o_step
-                    = 1 // turn step
-                    + (*o)->playerTypePtr()->cyclesToReachDistance( opp_move_dist - ptype->kickableArea() );
-
-                if ( o_step - bonus_step <= holder_reach_step )
-                {
-                    exist_opponent = true;
-                    break;
-                }
-            }
+            const int o_step = table.opponentReachStep( target_point,
+                                                        holder_reach_step + bonus_step );
+            const bool exist_opponent = ( o_step - bonus_step <= holder_reach_step );
 
             if ( exist_opponent )
             {
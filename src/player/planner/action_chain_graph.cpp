@@ -35,6 +35,7 @@
 #include "action_chain_graph.h"
 #include "../data_extractor/offensive_data_extractor.h"
 #include "hold_ball.h"
+#include "reachability_table.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/server_param.h>
@@ -147,6 +148,9 @@ ActionChainGraph::calculateResult( const WorldModel & wm )
 {
     debugPrintCurrentState( wm );
 
+    // opponent trajectories used by the danger evaluation
+    ReachabilityTable::instance().update( wm );
+
 #if (defined DEBUG_PROFILE) || (defined ACTION_CHAIN_LOAD_DEBUG)
     Timer timer;
 #endif
@@ -398,20 +402,8 @@ public:
 };
 
 
-double ActionChainGraph::oppMinDist(const WorldModel &wm, Vector2D point){
-    double min = 100;
-    for(int i = 1; i<=11; i++){
-        const AbstractPlayerObject * opp = wm.theirPlayer(i);
-        if(opp!=NULL && opp->unum()>0 && !opp->goalie()){
-            double dist = opp->pos().dist(point);
-            if(dist < min)
-                min = dist;
-        }
-    }
-    return min;
-}
 #include "field_analyzer.h"
-double ActionChainGraph::calcDangerEvalForTarget(const WorldModel &wm, Vector2D target){
+double ActionChainGraph::calcDangerEvalForTarget(const WorldModel &wm, const PredictState & state, Vector2D target){
     double danger_eval_base[16] = { 20, 10, 5, 3, 2, 1, 0 };
     double danger_eval[16] = {0, 0, 0, 0, 0, 0, 0 };
 
@@ -423,7 +415,8 @@ double ActionChainGraph::calcDangerEvalForTarget(const WorldModel &wm, Vector2D
         else
             danger_eval[i] = danger_eval_base[i] / 4.0;
     }
-    double dist_opp_target = oppMinDist(wm, target);
+    // opponents approach the target until the spend time of the state
+    double dist_opp_target = state.predictOpponentDist(target);
     if(dist_opp_target > 6)
         dist_opp_target = 6;
     double d = danger_eval[(int)dist_opp_target];;
@@ -432,13 +425,13 @@ double ActionChainGraph::calcDangerEvalForTarget(const WorldModel &wm, Vector2D
 
 double ActionChainGraph::calcDangerEvalForBhv(const WorldModel &wm, const ActionStatePair& bhv){
     Vector2D bhv_target = bhv.M_action->targetPoint();
-    return calcDangerEvalForTarget(wm, bhv_target);
+    return calcDangerEvalForTarget(wm, bhv.state(), bhv_target);
 }
-double ActionChainGraph::calcDangerEvalForChain(const WorldModel &wm, std::vector< ActionStatePair > series){
+double ActionChainGraph::calcDangerEvalForChain(const WorldModel &wm, const std::vector< ActionStatePair > & series){
     uint chain_size = series.size();
     double max_danger_eval = 0;
     for(uint i = 0; i <chain_size; i++){
-        ActionStatePair bhv = series[i];
+        const ActionStatePair & bhv = series[i];
         double danger_eval = calcDangerEvalForBhv(wm, bhv);
         if(danger_eval > max_danger_eval)
             max_danger_eval = danger_eval;
@@ -478,7 +471,7 @@ ActionChainGraph::calculateResultBestFirstSearch( const WorldModel & wm,
     const PredictState current_state( wm );
     const std::vector< ActionStatePair > empty_path;
     double current_evaluation = (*M_evaluator)( current_state, empty_path, wm);
-    double danger_eval = calcDangerEvalForTarget(wm, current_state.ball().pos());
+    double danger_eval = calcDangerEvalForTarget(wm, current_state, current_state.ball().pos());
     current_evaluation -= danger_eval;
     ++M_chain_count;
     ++(*n_evaluated);
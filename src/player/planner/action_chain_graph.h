@@ -89,10 +89,9 @@ private:
                    unsigned long max_chain_length,
                    long max_evaluate_limit );
 
-    double oppMinDist(const rcsc::WorldModel & wm, rcsc::Vector2D point);
-    double calcDangerEvalForTarget(const rcsc::WorldModel & wm, rcsc::Vector2D target);
+    double calcDangerEvalForTarget(const rcsc::WorldModel & wm, const PredictState & state, rcsc::Vector2D target);
     double calcDangerEvalForBhv(const rcsc::WorldModel & wm, const ActionStatePair& bhv);
-    double calcDangerEvalForChain(const rcsc::WorldModel & wm, std::vector< ActionStatePair > series);
+    double calcDangerEvalForChain(const rcsc::WorldModel & wm, const std::vector< ActionStatePair > & series);
     void calculateResultBestFirstSearch( const rcsc::WorldModel & wm,
                                          unsigned long * n_evaluated );
 
@@ -116,6 +115,12 @@ public:
           calculateResult( wm );
       }
 
+    //! the number of evaluated chains
+    int chainCount() const
+      {
+          return M_chain_count;
+      }
+
     const std::vector< ActionStatePair > & getAllChain() const
       {
           return M_result;
@@ -34,10 +34,29 @@
 #endif
 
 #include "action_chain_holder.h"
+
+#include "cooperative_action.h"
+#include "multi_kick_speculation.h"
+
+#include <rcsc/player/player_agent.h>
 #include <rcsc/player/world_model.h>
+#include <rcsc/common/logger.h>
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
 
 using namespace rcsc;
 
+namespace {
+
+// tolerances between the predicted and the observed start state
+const double BALL_POS_TOLERANCE = 0.3;
+const double BALL_VEL_TOLERANCE = 0.1;
+const double OPPONENT_DIST_TOLERANCE = 0.5;
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -45,7 +64,11 @@ using namespace rcsc;
 ActionChainHolder::ActionChainHolder()
     : M_graph(),
       M_evaluator(),
-      M_generator()
+      M_generator(),
+      M_graph_time( -1, 0 ),
+      M_graph_reused( false ),
+      M_speculation_enabled( false ),
+      M_speculation()
 {
 
 }
@@ -132,11 +155,151 @@ ActionChainHolder::update( const WorldModel & wm )
     s_update_time = wm.time();
     s_update_evaluator = M_evaluator;
     s_update_generator = M_generator;
+    M_graph_time = wm.time();
+
+    M_graph_reused = adoptSpeculation( wm );
+    if ( M_graph_reused )
+    {
+        return;
+    }
 
     M_graph = ActionChainGraph::Ptr( new ActionChainGraph( M_evaluator, M_generator ) );
     M_graph->calculate( wm );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainHolder::setSpeculationEnabled( const bool on )
+{
+    M_speculation_enabled = on;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ActionChainHolder::prepareSpeculation( const PlayerAgent * agent )
+{
+    const WorldModel & wm = agent->world();
+
+    const int adopted_count = ( M_speculation.graph_ == M_graph
+                                ? M_speculation.adopted_count_
+                                : 0 );
+    M_speculation.graph_.reset();
+
+    if ( ! M_speculation_enabled
+         || ! M_graph
+         || M_graph_time != wm.time()
+         || M_graph->getAllChain().empty()
+         || wm.gameMode().type() != GameMode::PlayOn
+         || ! wm.self().isKickable()
+         || ! agent->effector().queuedNextBallKickable() )
+    {
+        return;
+    }
+
+    //
+    // only the intermediate kicks of a multi-kick action are continued.
+    // the last kick of the action is always searched again.
+    // see keep_multi_kick_chain().
+    //
+    const CooperativeAction & first_action = M_graph->getFirstAction();
+    if ( first_action.playerUnum() != wm.self().unum()
+         || ( first_action.category() != CooperativeAction::Pass
+              && first_action.category() != CooperativeAction::Dribble )
+         || ! keep_multi_kick_chain( adopted_count, first_action.kickCount() ) )
+    {
+        return;
+    }
+
+    const Vector2D next_ball_pos = agent->effector().queuedNextBallPos();
+
+    // the opponents are assumed to approach the ball at their maximum speed
+    double opponent_dist = std::numeric_limits< double >::max();
+    for ( const PlayerObject * o : wm.opponentsFromBall() )
+    {
+        if ( o->posCount() > 10 ) continue;
+        if ( ! o->playerTypePtr() ) continue;
+
+        const double d = ( o->pos() + o->vel() ).dist( next_ball_pos )
+            - o->playerTypePtr()->realSpeedMax();
+        opponent_dist = std::min( opponent_dist, d );
+    }
+
+    M_speculation.graph_ = M_graph;
+    M_speculation.time_ = wm.time();
+    M_speculation.ball_pos_ = next_ball_pos;
+    M_speculation.ball_vel_ = agent->effector().queuedNextBallVel();
+    M_speculation.opponent_dist_ = opponent_dist;
+    M_speculation.adopted_count_ = adopted_count;
+
+    dlog.addText( Logger::PLAN,
+                  __FILE__": (prepareSpeculation) keep the chain for kick %d/%d. adopted=%d"
+                  " next_ball=(%.2f %.2f) opponent_dist=%.2f",
+                  adopted_count + 2, first_action.kickCount(), adopted_count,
+                  next_ball_pos.x, next_ball_pos.y, opponent_dist );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ActionChainHolder::adoptSpeculation( const WorldModel & wm )
+{
+    if ( ! M_speculation.graph_ )
+    {
+        return false;
+    }
+
+    const ActionChainGraph::Ptr graph = M_speculation.graph_;
+    M_speculation.graph_.reset();
+
+    if ( ! M_speculation_enabled
+         || wm.time().cycle() != M_speculation.time_.cycle() + 1
+         || wm.gameMode().type() != GameMode::PlayOn
+         || ! wm.self().isKickable() )
+    {
+        return false;
+    }
+
+    if ( wm.ball().pos().dist2( M_speculation.ball_pos_ ) > std::pow( BALL_POS_TOLERANCE, 2 )
+         || wm.ball().vel().dist2( M_speculation.ball_vel_ ) > std::pow( BALL_VEL_TOLERANCE, 2 ) )
+    {
+        dlog.addText( Logger::PLAN,
+                      __FILE__": (adoptSpeculation) ball state mismatch" );
+        return false;
+    }
+
+    for ( const PlayerObject * o : wm.opponentsFromBall() )
+    {
+        if ( o->posCount() > 10 ) continue;
+
+        if ( o->distFromBall() < M_speculation.opponent_dist_ - OPPONENT_DIST_TOLERANCE )
+        {
+            dlog.addText( Logger::PLAN,
+                          __FILE__": (adoptSpeculation) opponent %d approached. dist=%.2f",
+                          o->unum(), o->distFromBall() );
+            return false;
+        }
+        break;
+    }
+
+    // keep the reference for the next prepareSpeculation()
+    M_graph = graph;
+    M_speculation.graph_ = graph;
+    M_speculation.adopted_count_ += 1;
+
+    dlog.addText( Logger::PLAN,
+                  __FILE__": (adoptSpeculation) adopt the previous chain. adopted=%d",
+                  M_speculation.adopted_count_ );
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -33,6 +33,7 @@
 #define ACTION_CHAIN_HOLDER_H
 
 namespace rcsc {
+class PlayerAgent;
 class WorldModel;
 }
 
@@ -40,12 +41,42 @@ class WorldModel;
 #include "field_evaluator.h"
 #include "action_generator.h"
 
+#include <rcsc/game_time.h>
+#include <rcsc/geom/vector_2d.h>
+
 class ActionChainHolder {
 
 private:
+
+    /*!
+      \brief the chain kept for the next cycle and its predicted start state
+     */
+    struct Speculation {
+        ActionChainGraph::Ptr graph_; //!< the chain to be adopted
+        rcsc::GameTime time_; //!< the prepared time
+        rcsc::Vector2D ball_pos_; //!< predicted ball position of the next cycle
+        rcsc::Vector2D ball_vel_; //!< predicted ball velocity of the next cycle
+        double opponent_dist_; //!< predicted nearest opponent distance to the ball
+        int adopted_count_; //!< the number of cycles the chain has been adopted
+
+        Speculation()
+            : graph_(),
+              time_( -1, 0 ),
+              ball_pos_( rcsc::Vector2D::INVALIDATED ),
+              ball_vel_( 0.0, 0.0 ),
+              opponent_dist_( 0.0 ),
+              adopted_count_( 0 )
+          { }
+    };
+
     ActionChainGraph::Ptr M_graph;
     FieldEvaluator::ConstPtr M_evaluator;
     ActionGenerator::ConstPtr M_generator;
+    rcsc::GameTime M_graph_time; //!< the time M_graph was set
+    bool M_graph_reused; //!< true if M_graph was adopted from the previous cycle
+
+    bool M_speculation_enabled;
+    Speculation M_speculation;
 
 private:
     /*!
@@ -81,7 +112,31 @@ public:
 
     void update( const rcsc::WorldModel & wm );
 
+    /*!
+      \brief enable the adoption of the previous chain during multi-kick actions
+     */
+    void setSpeculationEnabled( const bool on );
+
+    /*!
+      \brief keep the current chain for the next cycle if it is still in progress.
+      must be called after the action of this cycle is queued.
+     */
+    void prepareSpeculation( const rcsc::PlayerAgent * agent );
+
     const ActionChainGraph & graph() const;
+
+    /*!
+      \brief check if the current graph was adopted from the previous cycle
+      without the search
+     */
+    bool graphReused() const
+      {
+          return M_graph_reused;
+      }
+
+private:
+
+    bool adoptSpeculation( const rcsc::WorldModel & wm );
 };
 
 #endif
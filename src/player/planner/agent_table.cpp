@@ -0,0 +1,157 @@
+// -*-c++-*-
+
+/*!
+  \file agent_table.cpp
+  \brief per-cycle player table shared by the generators Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "agent_table.h"
+
+#include "field_analyzer.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/soccer_math.h>
+
+using namespace rcsc;
+
+const int AgentTable::MAX_PLAYER;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+AgentTable::Players::inertiaPoint( const int i,
+                                   const int n_step ) const
+{
+    return inertia_n_step_point( pos( i ), vel( i ), n_step, player_decay_[i] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AgentTable::AgentTable()
+    : M_update_time( -1, 0 )
+{
+    M_teammates.size_ = 0;
+    M_opponents.size_ = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AgentTable &
+AgentTable::instance()
+{
+    static AgentTable s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename Cont >
+void
+AgentTable::set_players( const Cont & players,
+                         Players * table )
+{
+    table->size_ = 0;
+    for ( const AbstractPlayerObject * p : players )
+    {
+        if ( table->size_ >= MAX_PLAYER ) break;
+
+        const PlayerType * ptype = p->playerTypePtr();
+        if ( ! ptype ) continue;
+
+        const int i = table->size_;
+
+        table->player_[i] = p;
+        table->ptype_[i] = ptype;
+        table->unum_[i] = p->unum();
+        table->goalie_[i] = p->goalie();
+        table->ghost_[i] = p->isGhost();
+        table->tackling_[i] = p->isTackling();
+        table->pos_count_[i] = p->posCount();
+        table->body_count_[i] = p->bodyCount();
+
+        table->x_[i] = p->pos().x;
+        table->y_[i] = p->pos().y;
+        table->vx_[i] = p->vel().x;
+        table->vy_[i] = p->vel().y;
+        table->body_[i] = p->body().degree();
+
+        const Vector2D seen_pos = ( p->seenPosCount() <= p->posCount() ? p->seenPos() : p->pos() );
+        const Vector2D seen_vel = ( p->seenVelCount() <= p->velCount() ? p->seenVel() : p->vel() );
+        table->seen_x_[i] = seen_pos.x;
+        table->seen_y_[i] = seen_pos.y;
+        table->seen_vx_[i] = seen_vel.x;
+        table->seen_vy_[i] = seen_vel.y;
+
+        const Vector2D inertia_pos = ptype->inertiaFinalPoint( seen_pos, seen_vel );
+        table->inertia_x_[i] = inertia_pos.x;
+        table->inertia_y_[i] = inertia_pos.y;
+
+        table->kickable_area_[i] = ptype->kickableArea();
+        table->real_speed_max_[i] = ptype->realSpeedMax();
+        table->player_decay_[i] = ptype->playerDecay();
+
+        table->reach_bonus_[i] = FieldAnalyzer::estimate_virtual_dash_distance( p );
+
+        ++table->size_;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AgentTable::update( const WorldModel & wm )
+{
+    if ( M_update_time == wm.time() )
+    {
+        return;
+    }
+    M_update_time = wm.time();
+
+    set_players( wm.ourPlayers(), &M_teammates );
+    set_players( wm.theirPlayers(), &M_opponents );
+
+    dlog.addText( Logger::TEAM,
+                  __FILE__": (update) teammates=%d opponents=%d",
+                  M_teammates.size_, M_opponents.size_ );
+}
@@ -0,0 +1,183 @@
+// -*-c++-*-
+
+/*!
+  \file agent_table.h
+  \brief per-cycle player table shared by the generators Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef AGENT_TABLE_H
+#define AGENT_TABLE_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+class AbstractPlayerObject;
+class PlayerType;
+class WorldModel;
+}
+
+/*!
+  \class AgentTable
+  \brief per-cycle table of the players used by the first layer generators.
+
+  The values the generators used to compute for each of their own
+  receiver and opponent containers are computed once per cycle and stored
+  in flat arrays, one array per value. The generators loop over the table
+  by index and read only the arrays they need.
+
+  The players are stored in the order of WorldModel::ourPlayers() and
+  WorldModel::theirPlayers(). Players without a player type are skipped.
+ */
+class AgentTable {
+public:
+
+    //! the maximum number of players stored for each side
+    static const int MAX_PLAYER = 16;
+
+    /*!
+      \brief flat arrays of the players of one side
+     */
+    struct Players {
+        int size_;
+
+        const rcsc::AbstractPlayerObject * player_[MAX_PLAYER];
+        const rcsc::PlayerType * ptype_[MAX_PLAYER];
+        int unum_[MAX_PLAYER];
+        bool goalie_[MAX_PLAYER];
+        bool ghost_[MAX_PLAYER];
+        bool tackling_[MAX_PLAYER];
+        int pos_count_[MAX_PLAYER];
+        int body_count_[MAX_PLAYER];
+
+        //! estimated position and velocity
+        double x_[MAX_PLAYER];
+        double y_[MAX_PLAYER];
+        double vx_[MAX_PLAYER];
+        double vy_[MAX_PLAYER];
+        double body_[MAX_PLAYER]; //!< body direction [degree]
+
+        //! the seen values if they are newer than the estimated ones
+        double seen_x_[MAX_PLAYER];
+        double seen_y_[MAX_PLAYER];
+        double seen_vx_[MAX_PLAYER];
+        double seen_vy_[MAX_PLAYER];
+
+        //! final point of the inertia movement from the seen values
+        double inertia_x_[MAX_PLAYER];
+        double inertia_y_[MAX_PLAYER];
+
+        //! player type constants
+        double kickable_area_[MAX_PLAYER];
+        double real_speed_max_[MAX_PLAYER];
+        double player_decay_[MAX_PLAYER];
+
+        //! the distance the player may have moved since it was seen
+        double reach_bonus_[MAX_PLAYER];
+
+        rcsc::Vector2D pos( const int i ) const
+          {
+              return rcsc::Vector2D( x_[i], y_[i] );
+          }
+
+        rcsc::Vector2D vel( const int i ) const
+          {
+              return rcsc::Vector2D( vx_[i], vy_[i] );
+          }
+
+        rcsc::Vector2D seenPos( const int i ) const
+          {
+              return rcsc::Vector2D( seen_x_[i], seen_y_[i] );
+          }
+
+        rcsc::Vector2D seenVel( const int i ) const
+          {
+              return rcsc::Vector2D( seen_vx_[i], seen_vy_[i] );
+          }
+
+        rcsc::Vector2D inertiaFinalPoint( const int i ) const
+          {
+              return rcsc::Vector2D( inertia_x_[i], inertia_y_[i] );
+          }
+
+        /*!
+          \brief get the estimated position after n steps without any command
+         */
+        rcsc::Vector2D inertiaPoint( const int i,
+                                     const int n_step ) const;
+    };
+
+private:
+
+    rcsc::GameTime M_update_time;
+
+    Players M_teammates;
+    Players M_opponents;
+
+    AgentTable();
+
+    // not used
+    AgentTable( const AgentTable & );
+    const AgentTable & operator=( const AgentTable & );
+public:
+
+    static
+    AgentTable & instance();
+
+    static
+    const AgentTable & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief update the table. nothing is done if already updated in this cycle.
+      \param wm world model
+     */
+    void update( const rcsc::WorldModel & wm );
+
+    //! teammates including self
+    const Players & teammates() const
+      {
+          return M_teammates;
+      }
+
+    const Players & opponents() const
+      {
+          return M_opponents;
+      }
+
+private:
+
+    template < typename Cont >
+    static
+    void set_players( const Cont & players,
+                      Players * table );
+};
+
+#endif
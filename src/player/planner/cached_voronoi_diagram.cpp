@@ -0,0 +1,130 @@
+// -*-c++-*-
+
+/*!
+  \file cached_voronoi_diagram.cpp
+  \brief per-cycle cached voronoi diagram Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "cached_voronoi_diagram.h"
+
+using namespace rcsc;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+bool
+same_sites( const std::vector< Vector2D > & lhs,
+            const std::vector< Vector2D > & rhs )
+{
+    if ( lhs.size() != rhs.size() )
+    {
+        return false;
+    }
+
+    for ( std::size_t i = 0; i < lhs.size(); ++i )
+    {
+        if ( lhs[i].x != rhs[i].x
+             || lhs[i].y != rhs[i].y )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CachedVoronoiDiagram::CachedVoronoiDiagram()
+    : M_use_bounding_rect( false ),
+      M_computed( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CachedVoronoiDiagram::setBoundingRect( const Rect2D & rect )
+{
+    if ( M_use_bounding_rect
+         && M_bounding_rect.topLeft().x == rect.topLeft().x
+         && M_bounding_rect.topLeft().y == rect.topLeft().y
+         && M_bounding_rect.size().length() == rect.size().length()
+         && M_bounding_rect.size().width() == rect.size().width() )
+    {
+        return;
+    }
+
+    M_use_bounding_rect = true;
+    M_bounding_rect = rect;
+    M_computed = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const VoronoiDiagram &
+CachedVoronoiDiagram::diagram() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    if ( M_computed
+         && same_sites( M_computed_sites, M_sites ) )
+    {
+        return M_diagram;
+    }
+
+    M_diagram.clear();
+    for ( const Vector2D & p : M_sites )
+    {
+        M_diagram.addPoint( p );
+    }
+
+    if ( M_use_bounding_rect )
+    {
+        M_diagram.setBoundingRect( M_bounding_rect );
+    }
+
+    M_diagram.compute();
+
+    M_computed_sites = M_sites;
+    M_computed = true;
+
+    return M_diagram;
+}
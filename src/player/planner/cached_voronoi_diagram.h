@@ -0,0 +1,115 @@
+// -*-c++-*-
+
+/*!
+  \file cached_voronoi_diagram.h
+  \brief per-cycle cached voronoi diagram Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef CACHED_VORONOI_DIAGRAM_H
+#define CACHED_VORONOI_DIAGRAM_H
+
+#include <rcsc/geom/voronoi_diagram.h>
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <mutex>
+#include <vector>
+
+/*!
+  \class CachedVoronoiDiagram
+  \brief voronoi diagram computed only when it is used and its sites changed.
+
+  The owner registers the sites every cycle, which only copies the
+  points. The diagram is computed on the first access after the sites
+  were changed, so a diagram nobody reads in a cycle costs nothing, and
+  a diagram read by several consumers is computed only once. The same
+  sites as the last computation (e.g. during stopped play) reuse the
+  previous result.
+
+  Threading: the sites and the bounding rectangle are set only by the
+  owner on the client thread, while no worker task reads the diagram
+  (FieldAnalyzer::update()). diagram() may be called from any thread,
+  e.g. by generators and evaluators running on ThreadPool. The lazy
+  computation is serialized by a mutex, and the returned reference is
+  valid until the sites are set again.
+ */
+class CachedVoronoiDiagram {
+private:
+
+    std::vector< rcsc::Vector2D > M_sites;
+
+    bool M_use_bounding_rect;
+    rcsc::Rect2D M_bounding_rect;
+
+    //! the sites used by the last computation
+    mutable std::vector< rcsc::Vector2D > M_computed_sites;
+    mutable bool M_computed;
+    mutable rcsc::VoronoiDiagram M_diagram;
+    mutable std::mutex M_mutex; //!< guards the lazy computation
+
+    // not used
+    CachedVoronoiDiagram( const CachedVoronoiDiagram & );
+    const CachedVoronoiDiagram & operator=( const CachedVoronoiDiagram & );
+public:
+
+    CachedVoronoiDiagram();
+
+    /*!
+      \brief set the bounding rectangle used by the following computations.
+      the diagram is computed again only if the rectangle is changed.
+     */
+    void setBoundingRect( const rcsc::Rect2D & rect );
+
+    /*!
+      \brief remove all sites
+     */
+    void clearSites()
+      {
+          M_sites.clear();
+      }
+
+    /*!
+      \brief add a site of the next diagram
+     */
+    void addSite( const rcsc::Vector2D & p )
+      {
+          M_sites.push_back( p );
+      }
+
+    const std::vector< rcsc::Vector2D > & sites() const
+      {
+          return M_sites;
+      }
+
+    /*!
+      \brief get the diagram of the current sites. computed if needed.
+      thread safe against other calls of diagram().
+     */
+    const rcsc::VoronoiDiagram & diagram() const;
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include "clear_generator.h"
 
 #include "field_analyzer.h"
+#include "agent_table.h"
 #include "clear_ball.h"
 
 #include "basic_actions/kick_table.h"
@@ -379,12 +380,14 @@ ClearGenerator::predictOpponentsReachStep( const WorldModel & wm,
     int min_step = 50;
     int out_of_pitch_step = -1;
 
-    for ( AbstractPlayerObject::Cont::const_iterator o = wm.theirPlayers().begin(),
-              end = wm.theirPlayers().end();
-          o != end;
-          ++o )
+    AgentTable::instance().update( wm );
+
+    const AgentTable::Players & opponents = AgentTable::i().opponents();
+
+    for ( int i = 0; i < opponents.size_; ++i )
     {
-        int step = predictOpponentReachStep( *o,
+        int step = predictOpponentReachStep( opponents,
+                                             i,
                                              first_ball_pos,
                                              first_ball_vel,
                                              ball_move_angle,
@@ -418,7 +421,8 @@ ClearGenerator::predictOpponentsReachStep( const WorldModel & wm,
 
  */
 int
-ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
+ClearGenerator::predictOpponentReachStep( const AgentTable::Players & opponents,
+                                          const int index,
                                           const Vector2D & first_ball_pos,
                                           const Vector2D & first_ball_vel,
                                           const AngleDeg & ball_move_angle,
@@ -427,10 +431,11 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
     const ServerParam & SP = ServerParam::i();
 
 
-    const PlayerType * ptype = opponent->playerTypePtr();
-    const double opponent_speed = opponent->vel().r();
+    const PlayerType * ptype = opponents.ptype_[index];
+    const Vector2D opponent_pos = opponents.pos( index );
+    const double opponent_speed = opponents.vel( index ).r();
 
-    int min_cycle = FieldAnalyzer::estimate_min_reach_cycle( opponent->pos(),
+    int min_cycle = FieldAnalyzer::estimate_min_reach_cycle( opponent_pos,
                                                              ptype->realSpeedMax(),
                                                              first_ball_pos,
                                                              ball_move_angle );
@@ -452,14 +457,14 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP
             dlog.addText( Logger::CLEAR,
                           "____ opponent=%d(%.1f %.1f) step=%d ball is out of pitch. ",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle  );
 #endif
             return 1000 + cycle;
         }
 
-        Vector2D inertia_pos = opponent->inertiaPoint( cycle );
+        Vector2D inertia_pos = opponents.inertiaPoint( index, cycle );
         double target_dist = inertia_pos.dist( ball_pos );
 
         if ( target_dist - ptype->kickableArea() - 0.15 < 0.001 )
@@ -467,8 +472,8 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP
             dlog.addText( Logger::CLEAR,
                           "____ opponent=%d(%.1f %.1f) step=%d already there. dist=%.1f",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle,
                           target_dist );
 #endif
@@ -487,8 +492,8 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP_LEVEL2
             dlog.addText( Logger::CLEAR,
                           "______ opponent=%d(%.1f %.1f) cycle=%d dash_dist=%.1f reachable=%.1f",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle, dash_dist, ptype->realSpeedMax()*cycle );
 #endif
             continue;
@@ -505,8 +510,8 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP_LEVEL2
             dlog.addText( Logger::CLEAR,
                           "______ opponent=%d(%.1f %.1f) cycle=%d dash_dist=%.1f n_dash=%d",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle, dash_dist, n_dash );
 #endif
             continue;
@@ -515,10 +520,10 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
         //
         // turn
         //
-        int n_turn = ( opponent->bodyCount() > 1
+        int n_turn = ( opponents.body_count_[index] > 1
                        ? 0
                        : FieldAnalyzer::predict_player_turn_cycle( ptype,
-                                                                   opponent->body(),
+                                                                   AngleDeg( opponents.body_[index] ),
                                                                    opponent_speed,
                                                                    target_dist,
                                                                    ( ball_pos - inertia_pos ).th(),
@@ -528,20 +533,20 @@ ClearGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
         int n_step = ( n_turn == 0
                        ? n_turn + n_dash
                        : n_turn + n_dash + 1 ); // 1 step penalty for observation delay
-        if ( opponent->isTackling() )
+        if ( opponents.tackling_[index] )
         {
             n_step += 5; // Magic Number
         }
 
-        n_step -= std::min( 3, opponent->posCount() );
+        n_step -= std::min( 3, opponents.pos_count_[index] );
 
         if ( n_step <= cycle )
         {
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP
             dlog.addText( Logger::CLEAR,
                           "____ opponent=%d(%.1f %.1f) step=%d(t:%d,d:%d)",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle, n_turn, n_dash );
 #endif
             return cycle;
@@ -33,6 +33,7 @@
 #define CROSS_GENERATOR_H
 
 #include "cooperative_action.h"
+#include "agent_table.h"
 
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
@@ -85,7 +86,8 @@ private:
                                    const rcsc::Vector2D & first_ball_pos,
                                    const double & first_ball_speed,
                                    const rcsc::AngleDeg & ball_move_angle );
-    int predictOpponentReachStep( const rcsc::AbstractPlayerObject * opponent,
+    int predictOpponentReachStep( const AgentTable::Players & opponents,
+                                  const int index,
                                   const rcsc::Vector2D & first_ball_pos,
                                   const rcsc::Vector2D & first_ball_vel,
                                   const rcsc::AngleDeg & ball_move_angle,
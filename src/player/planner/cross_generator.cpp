@@ -36,6 +36,7 @@
 #include "cross_generator.h"
 
 #include "field_analyzer.h"
+#include "agent_table.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/player/intercept_table.h>
@@ -154,6 +155,8 @@ CrossGenerator::generate( const WorldModel & wm )
         return;
     }
 
+    AgentTable::instance().update( wm );
+
     updateReceivers( wm );
 
     if ( M_receiver_candidates.empty() )
@@ -278,41 +281,42 @@ CrossGenerator::updateReceivers( const WorldModel & wm )
 
     const bool is_self_passer = ( M_passer->unum() == wm.self().unum() );
 
-    for ( AbstractPlayerObject::Cont::const_iterator p = wm.ourPlayers().begin(),
-              end = wm.ourPlayers().end();
-          p != end;
-          ++p )
+    const AgentTable::Players & teammates = AgentTable::i().teammates();
+
+    for ( int i = 0; i < teammates.size_; ++i )
     {
-        if ( *p == M_passer ) continue;
+        if ( teammates.player_[i] == M_passer ) continue;
 
         if ( is_self_passer )
         {
-            if ( (*p)->isGhost() ) continue;
-            if ( (*p)->posCount() >= 4 ) continue;
-            if ( (*p)->pos().x > wm.offsideLineX() ) continue;
+            if ( teammates.ghost_[i] ) continue;
+            if ( teammates.pos_count_[i] >= 4 ) continue;
+            if ( teammates.x_[i] > wm.offsideLineX() ) continue;
         }
         else
         {
             // ignore other players
-            if ( (*p)->unum() != wm.self().unum() )
+            if ( teammates.unum_[i] != wm.self().unum() )
             {
                 continue;
             }
         }
 
-        if ( (*p)->pos().dist2( goal ) > shootable_dist2 ) continue;
+        const Vector2D pos = teammates.pos( i );
+
+        if ( pos.dist2( goal ) > shootable_dist2 ) continue;
 
-        double d2 = (*p)->pos().dist2( M_first_point );
+        double d2 = pos.dist2( M_first_point );
         if ( d2 < min_cross_dist2 ) continue;
         if ( max_cross_dist2 < d2 ) continue;
 
-        M_receiver_candidates.push_back( *p );
+        M_receiver_candidates.push_back( teammates.player_[i] );
 
 #ifdef DEBUG_UPDATE_OPPONENT
         dlog.addText( Logger::CROSS,
                       "Cross receiver %d pos(%.1f %.1f)",
-                      (*p)->unum(),
-                      (*p)->pos().x, (*p)->pos().y );
+                      teammates.unum_[i],
+                      pos.x, pos.y );
 #endif
     }
 }
@@ -322,36 +326,37 @@ CrossGenerator::updateReceivers( const WorldModel & wm )
 
  */
 void
-CrossGenerator::updateOpponents( const WorldModel & wm )
+CrossGenerator::updateOpponents( const WorldModel & )
 {
     const double opponent_dist_thr2 = std::pow( 20.0, 2 );
 
     const Vector2D goal = ServerParam::i().theirTeamGoalPos();
     const AngleDeg goal_angle_from_ball = ( goal - M_first_point ).th();
 
-    for ( AbstractPlayerObject::Cont::const_iterator p = wm.theirPlayers().begin(),
-              end = wm.theirPlayers().end();
-          p != end;
-          ++p )
+    const AgentTable::Players & opponents = AgentTable::i().opponents();
+
+    for ( int i = 0; i < opponents.size_; ++i )
     {
-        AngleDeg opponent_angle_from_ball = ( (*p)->pos() - M_first_point ).th();
+        const Vector2D pos = opponents.pos( i );
+
+        AngleDeg opponent_angle_from_ball = ( pos - M_first_point ).th();
         if ( ( opponent_angle_from_ball - goal_angle_from_ball ).abs() > 90.0 )
         {
             continue;
         }
 
-        if ( (*p)->pos().dist2( M_first_point ) > opponent_dist_thr2 )
+        if ( pos.dist2( M_first_point ) > opponent_dist_thr2 )
         {
             continue;
         }
 
-        M_opponents.push_back( *p );
+        M_opponents.push_back( opponents.player_[i] );
 
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::PASS,
                       "Cross opponent %d pos(%.1f %.1f)",
-                      (*p)->unum(),
-                      (*p)->pos().x, (*p)->pos().y );
+                      opponents.unum_[i],
+                      pos.x, pos.y );
 #endif
     }
 }
@@ -0,0 +1,83 @@
+// -*-c++-*-
+
+/*!
+  \file fast_geometry.cpp
+  \brief float32 geometry for candidate screening Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "fast_geometry.h"
+
+#include <ostream>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+FastGeometry::check_accuracy( std::ostream & os )
+{
+    // atan2 over the points of the field and its surroundings
+    double atan2_error = 0.0;
+    for ( int ix = 0; ix <= 600; ++ix )
+    {
+        for ( int iy = 0; iy <= 400; ++iy )
+        {
+            const double x = -60.0 + 0.2 * ix;
+            const double y = -40.0 + 0.2 * iy;
+            const double exact = std::atan2( y, x ) * 180.0 / M_PI;
+            double err = std::fabs( exact - atan2_deg( static_cast< float >( y ),
+                                                       static_cast< float >( x ) ) );
+            if ( err > 180.0 ) err = 360.0 - err;
+            atan2_error = std::max( atan2_error, err );
+        }
+    }
+
+    double sincos_error = 0.0;
+    for ( int i = -720000; i <= 720000; ++i )
+    {
+        const double deg = i * 0.001;
+        float s, c;
+        sincos_deg( static_cast< float >( deg ), &s, &c );
+        sincos_error = std::max( sincos_error,
+                                 std::max( std::fabs( s - std::sin( deg * M_PI / 180.0 ) ),
+                                           std::fabs( c - std::cos( deg * M_PI / 180.0 ) ) ) );
+    }
+
+    os << "FastGeometry: atan2 error=" << atan2_error << "[deg]"
+       << " (bound " << ATAN2_MAX_ERROR_DEG << ")"
+       << " sincos error=" << sincos_error
+       << " (bound " << SINCOS_MAX_ERROR << ")"
+       << std::endl;
+
+    return ( atan2_error <= ATAN2_MAX_ERROR_DEG
+             && sincos_error <= SINCOS_MAX_ERROR );
+}
@@ -0,0 +1,261 @@
+// -*-c++-*-
+
+/*!
+  \file fast_geometry.h
+  \brief float32 geometry for candidate screening Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef FAST_GEOMETRY_H
+#define FAST_GEOMETRY_H
+
+#include <algorithm>
+#include <cmath>
+#include <iosfwd>
+
+/*!
+  \class FastGeometry
+  \brief float32 versions of the geometry used in the generator inner loops.
+
+  The trigonometric functions are polynomial approximations without any
+  table. Their errors against the double precision versions are bounded
+  by ATAN2_MAX_ERROR_DEG and SINCOS_MAX_ERROR for the angles in
+  [-720, 720] degree. check_accuracy() measures them again.
+
+  These functions are intended for the screening of candidates only.
+  A candidate accepted by the screening must be checked again by the
+  exact double precision code, and a screening condition must keep a
+  margin larger than the errors (SCREEN_MARGIN) so that no valid
+  candidate is rejected. test/fast_geometry_test.cpp checks both.
+ */
+class FastGeometry {
+public:
+
+    //! the maximum error of atan2_deg() [degree]
+    static constexpr float ATAN2_MAX_ERROR_DEG = 2.0e-4f;
+    //! the maximum error of sincos_deg()
+    static constexpr float SINCOS_MAX_ERROR = 1.0e-6f;
+    //! the margin of the screening conditions, larger than the float32 errors
+    static constexpr float SCREEN_MARGIN = 0.01f;
+
+    /*!
+      \brief the direction of (x, y)
+      \return [-180, 180] degree. 0 for (0, 0)
+     */
+    static
+    float atan2_deg( const float y,
+                     const float x )
+      {
+          const float ax = std::fabs( x );
+          const float ay = std::fabs( y );
+          const float max_v = std::max( ax, ay );
+          if ( max_v == 0.0f ) return 0.0f;
+
+          // minimax polynomial of atan(a) for a in [0, 1]
+          const float a = std::min( ax, ay ) / max_v;
+          const float s = a * a;
+          float r = ( ( ( ( ( ( -0.0117212f * s + 0.05265332f ) * s
+                              - 0.11643287f ) * s
+                            + 0.19354346f ) * s
+                          - 0.33262347f ) * s
+                        + 0.99997726f ) * a );
+          if ( ay > ax ) r = 1.57079637f - r;
+          if ( x < 0.0f ) r = 3.14159274f - r;
+          if ( y < 0.0f ) r = -r;
+          return r * 57.2957795f;
+      }
+
+    /*!
+      \brief sine and cosine of the angle
+      \param deg angle [degree]
+     */
+    static
+    void sincos_deg( const float deg,
+                     float * s,
+                     float * c )
+      {
+          // reduce to [-45, 45] degree and the quadrant
+          const float q = std::nearbyint( deg * ( 1.0f / 90.0f ) );
+          const float x = ( deg - q * 90.0f ) * 0.0174532925f;
+          const float x2 = x * x;
+          const float sn = x * ( 1.0f + x2 * ( -1.6666667e-1f
+                                               + x2 * ( 8.3333333e-3f
+                                                        + x2 * ( -1.9841270e-4f
+                                                                 + x2 * 2.7557319e-6f ) ) ) );
+          const float cs = 1.0f + x2 * ( -0.5f
+                                         + x2 * ( 4.1666667e-2f
+                                                  + x2 * ( -1.3888889e-3f
+                                                           + x2 * 2.4801587e-5f ) ) );
+          switch ( static_cast< int >( q ) & 3 ) {
+          case 0: *s = sn; *c = cs; break;
+          case 1: *s = cs; *c = -sn; break;
+          case 2: *s = -sn; *c = -cs; break;
+          default: *s = -cs; *c = sn; break;
+          }
+      }
+
+    /*!
+      \brief the vector of the length and the direction
+     */
+    static
+    void polar( const float r,
+                const float deg,
+                float * x,
+                float * y )
+      {
+          float s, c;
+          sincos_deg( deg, &s, &c );
+          *x = r * c;
+          *y = r * s;
+      }
+
+    /*!
+      \brief the squared distance between two points
+     */
+    static
+    float dist2( const float x0,
+                 const float y0,
+                 const float x1,
+                 const float y1 )
+      {
+          const float dx = x1 - x0;
+          const float dy = y1 - y0;
+          return dx * dx + dy * dy;
+      }
+
+    /*!
+      \brief the positions of an object moving only by inertia.
+      x[i] and y[i] are the position after i steps, i = 0, ..., n_step.
+      \param x0 first position
+      \param y0 first position
+      \param vx first velocity
+      \param vy first velocity
+      \param decay velocity decay
+      \param n_step the last step
+      \param x SoA output of the size n_step + 1 at least
+      \param y SoA output of the size n_step + 1 at least
+     */
+    static
+    void inertia_path( const float x0,
+                       const float y0,
+                       float vx,
+                       float vy,
+                       const float decay,
+                       const int n_step,
+                       float * x,
+                       float * y )
+      {
+          x[0] = x0;
+          y[0] = y0;
+          for ( int i = 1; i <= n_step; ++i )
+          {
+              x[i] = x[i - 1] + vx;
+              y[i] = y[i - 1] + vy;
+              vx *= decay;
+              vy *= decay;
+          }
+      }
+
+    /*!
+      \brief screen a player that tries to reach an object moving on a
+      straight path, e.g. an opponent against a pass.
+
+      The condition is necessary for the reach: false means that the
+      player never comes within the reach distance of the object, where
+      the reach distance of the cycle is
+      speed_max * (cycle + pos_count) + reach_buf.
+      The minimum cycle is estimated in the same way as
+      FieldAnalyzer::estimate_min_reach_cycle().
+
+      \param px player position
+      \param py player position
+      \param pvx player velocity
+      \param pvy player velocity
+      \param decay player decay
+      \param speed_max player speed max
+      \param pos_count extra cycles added to the move of the player
+      \param reach_buf the maximum reduction of the dash distance
+      \param path_x SoA positions of the object. index is the cycle
+      \param path_y SoA positions of the object. index is the cycle
+      \param dir_x unit vector of the path direction
+      \param dir_y unit vector of the path direction
+      \param max_cycle the last cycle
+      \return false if the player never reaches the object
+     */
+    static
+    bool may_reach_path( const float px,
+                         const float py,
+                         const float pvx,
+                         const float pvy,
+                         const float decay,
+                         const float speed_max,
+                         const float pos_count,
+                         const float reach_buf,
+                         const float * path_x,
+                         const float * path_y,
+                         const float dir_x,
+                         const float dir_y,
+                         const int max_cycle )
+      {
+          const float rel_x = px - path_x[0];
+          const float rel_y = py - path_y[0];
+          const float along = rel_x * dir_x + rel_y * dir_y;
+          if ( along < -1.0f - SCREEN_MARGIN )
+          {
+              return false;
+          }
+          const float side = std::fabs( rel_y * dir_x - rel_x * dir_y ) - SCREEN_MARGIN;
+          const int min_cycle = std::max( 1, static_cast< int >( std::floor( side / speed_max ) ) );
+
+          float gain = 0.0f; // the travel of the first velocity after the cycle
+          float decay_n = 1.0f;
+          for ( int cycle = 1; cycle <= max_cycle; ++cycle )
+          {
+              gain += decay_n;
+              decay_n *= decay;
+              if ( cycle < min_cycle ) continue;
+
+              const float reach = speed_max * ( cycle + pos_count ) + reach_buf + SCREEN_MARGIN;
+              if ( dist2( px + pvx * gain, py + pvy * gain,
+                          path_x[cycle], path_y[cycle] ) <= reach * reach )
+              {
+                  return true;
+              }
+          }
+          return false;
+      }
+
+    /*!
+      \brief compare the approximations with the double precision versions
+      \param os the measured errors are written to this stream
+      \return true if the errors are within the documented bounds
+     */
+    static
+    bool check_accuracy( std::ostream & os );
+};
+
+#endif
@@ -1046,18 +1046,16 @@ FieldAnalyzer::get_pass_count( const PredictState & state,
 
 
     int pass_count = 0;
-    for ( PredictPlayerObject::Cont::const_iterator it = state.ourPlayers().begin(),
-              end = state.ourPlayers().end();
-          it != end;
-          ++it )
+    for ( int unum = 1; unum <= 11; ++unum )
     {
-        if ( ! (*it)->isValid()
-             || (*it)->unum() == from->unum() )
+        const PredictPlayerObject * receiver = state.ourPlayerObject( unum );
+        if ( ! receiver->isValid()
+             || receiver->unum() == from->unum() )
         {
             continue;
         }
 
-        if ( pass_checker( state, *from, **it, (*it)->pos(), first_ball_speed ) )
+        if ( pass_checker( state, *from, *receiver, receiver->pos(), first_ball_speed ) )
         {
             pass_count ++;
 
@@ -1211,6 +1209,9 @@ FieldAnalyzer::update( const WorldModel & wm )
     }
     s_update_time = wm.time();
 
+    // only the sites are updated here
+    updateVoronoiDiagram( wm );
+
     if ( wm.gameMode().type() == GameMode::BeforeKickOff
          || wm.gameMode().type() == GameMode::AfterGoal_
          || wm.gameMode().isPenaltyKickMode() )
@@ -1222,8 +1223,6 @@ FieldAnalyzer::update( const WorldModel & wm )
     Timer timer;
 #endif
 
-    // updateVoronoiDiagram( wm );
-
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::TEAM,
                   "FieldAnalyzer::update() elapsed %f [ms]",
@@ -1244,9 +1243,10 @@ FieldAnalyzer::updateVoronoiDiagram( const WorldModel & wm )
                                              ServerParam::i().pitchLength() - 10.0,
                                              ServerParam::i().pitchWidth() - 10.0 );
 
-    M_all_players_voronoi_diagram.clear();
-    M_teammates_voronoi_diagram.clear();
-    M_pass_voronoi_diagram.clear();
+    M_all_players_voronoi_diagram.clearSites();
+    M_teammates_voronoi_diagram.clearSites();
+    M_opponents_voronoi_diagram.clearSites();
+    M_pass_voronoi_diagram.clearSites();
 
     const SideID our = wm.ourSide();
 
@@ -1255,36 +1255,40 @@ FieldAnalyzer::updateVoronoiDiagram( const WorldModel & wm )
           p != end;
           ++p )
     {
-        M_all_players_voronoi_diagram.addPoint( (*p)->pos() );
+        M_all_players_voronoi_diagram.addSite( (*p)->pos() );
 
         if ( (*p)->side() == our )
         {
-            M_teammates_voronoi_diagram.addPoint( (*p)->pos() );
+            M_teammates_voronoi_diagram.addSite( (*p)->pos() );
         }
         else
         {
-            M_pass_voronoi_diagram.addPoint( (*p)->pos() );
+            M_pass_voronoi_diagram.addSite( (*p)->pos() );
         }
     }
 
+    for ( PlayerObject::Cont::const_iterator p = wm.opponentsFromSelf().begin(),
+              end = wm.opponentsFromSelf().end();
+          p != end;
+          ++p )
+    {
+        M_opponents_voronoi_diagram.addSite( (*p)->pos() );
+    }
+
     // our goal
-    M_pass_voronoi_diagram.addPoint( Vector2D( - ServerParam::i().pitchHalfLength() + 5.5, 0.0 ) );
+    M_pass_voronoi_diagram.addSite( Vector2D( - ServerParam::i().pitchHalfLength() + 5.5, 0.0 ) );
     //     M_pass_voronoi_diagram.addPoint( Vector2D( - ServerParam::i().pitchHalfLength() + 5.5,
     //                                                - ServerParam::i().goalHalfWidth() ) );
     //     M_pass_voronoi_diagram.addPoint( Vector2D( - ServerParam::i().pitchHalfLength() + 5.5,
     //                                                + ServerParam::i().goalHalfWidth() ) );
 
     // opponent side corners
-    M_pass_voronoi_diagram.addPoint( Vector2D( + ServerParam::i().pitchHalfLength() + 10.0,
-                                               - ServerParam::i().pitchHalfWidth() - 10.0 ) );
-    M_pass_voronoi_diagram.addPoint( Vector2D( + ServerParam::i().pitchHalfLength() + 10.0,
-                                               + ServerParam::i().pitchHalfWidth() + 10.0 ) );
+    M_pass_voronoi_diagram.addSite( Vector2D( + ServerParam::i().pitchHalfLength() + 10.0,
+                                              - ServerParam::i().pitchHalfWidth() - 10.0 ) );
+    M_pass_voronoi_diagram.addSite( Vector2D( + ServerParam::i().pitchHalfLength() + 10.0,
+                                              + ServerParam::i().pitchHalfWidth() + 10.0 ) );
 
     M_pass_voronoi_diagram.setBoundingRect( rect );
-
-    M_all_players_voronoi_diagram.compute();
-    M_teammates_voronoi_diagram.compute();
-    M_pass_voronoi_diagram.compute();
 }
 
 /*-------------------------------------------------------------------*/
@@ -1297,8 +1301,10 @@ FieldAnalyzer::writeDebugLog()
 
     if ( dlog.isEnabled( Logger::PASS ) )
     {
-        const VoronoiDiagram::Segment2DCont::const_iterator s_end = M_pass_voronoi_diagram.resultSegments().end();
-        for ( VoronoiDiagram::Segment2DCont::const_iterator s = M_pass_voronoi_diagram.resultSegments().begin();
+        const VoronoiDiagram & pass_voronoi_diagram = passVoronoiDiagram();
+
+        const VoronoiDiagram::Segment2DCont::const_iterator s_end = pass_voronoi_diagram.resultSegments().end();
+        for ( VoronoiDiagram::Segment2DCont::const_iterator s = pass_voronoi_diagram.resultSegments().begin();
               s != s_end;
               ++s )
         {
@@ -1307,8 +1313,8 @@ FieldAnalyzer::writeDebugLog()
                           "#0000ff" );
         }
 
-        const VoronoiDiagram::Ray2DCont::const_iterator r_end = M_pass_voronoi_diagram.resultRays().end();
-        for ( VoronoiDiagram::Ray2DCont::const_iterator r = M_pass_voronoi_diagram.resultRays().begin();
+        const VoronoiDiagram::Ray2DCont::const_iterator r_end = pass_voronoi_diagram.resultRays().end();
+        for ( VoronoiDiagram::Ray2DCont::const_iterator r = pass_voronoi_diagram.resultRays().begin();
               r != r_end;
               ++r )
         {
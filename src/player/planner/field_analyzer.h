@@ -33,6 +33,7 @@
 #define FIELD_ANALYZER_H
 
 #include "predict_state.h"
+#include "cached_voronoi_diagram.h"
 
 #include <rcsc/geom/voronoi_diagram.h>
 #include <rcsc/geom/vector_2d.h>
@@ -52,9 +53,12 @@ class PassChecker;
 class FieldAnalyzer {
 private:
 
-    rcsc::VoronoiDiagram M_all_players_voronoi_diagram;
-    rcsc::VoronoiDiagram M_teammates_voronoi_diagram;
-    rcsc::VoronoiDiagram M_pass_voronoi_diagram;
+    // the diagrams are computed on the first access in each cycle.
+    // the accessors can be called from the ThreadPool workers.
+    CachedVoronoiDiagram M_all_players_voronoi_diagram;
+    CachedVoronoiDiagram M_teammates_voronoi_diagram;
+    CachedVoronoiDiagram M_opponents_voronoi_diagram;
+    CachedVoronoiDiagram M_pass_voronoi_diagram;
 
     FieldAnalyzer();
 public:
@@ -70,17 +74,26 @@ public:
 
     const rcsc::VoronoiDiagram & allPlayersVoronoiDiagram() const
       {
-          return M_all_players_voronoi_diagram;
+          return M_all_players_voronoi_diagram.diagram();
       }
 
     const rcsc::VoronoiDiagram & teammatesVoronoiDiagram() const
       {
-          return M_teammates_voronoi_diagram;
+          return M_teammates_voronoi_diagram.diagram();
+      }
+
+    /*!
+      \brief get the diagram of the opponent positions without any bounding rect.
+      the sites are added in the order of WorldModel::opponentsFromSelf().
+     */
+    const rcsc::VoronoiDiagram & opponentsVoronoiDiagram() const
+      {
+          return M_opponents_voronoi_diagram.diagram();
       }
 
     const rcsc::VoronoiDiagram & passVoronoiDiagram() const
       {
-          return M_pass_voronoi_diagram;
+          return M_pass_voronoi_diagram.diagram();
       }
 
     void update( const rcsc::WorldModel & wm );
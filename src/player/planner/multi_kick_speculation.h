@@ -0,0 +1,57 @@
+// -*-c++-*-
+
+/*!
+  \file multi_kick_speculation.h
+  \brief the rule which kicks of a multi-kick action reuse the chain Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef MULTI_KICK_SPECULATION_H
+#define MULTI_KICK_SPECULATION_H
+
+/*!
+  \brief check if the chain is kept for the next kick of a multi-kick action.
+
+  The kicks are counted from 1. The first kick is always planned by the
+  search, and the chain is adopted for the intermediate kicks only. The
+  last kick, which releases the ball, is always searched again.
+
+  \param adopted_count the number of kicks executed by the adopted chain
+  in a row, i.e. the current kick is the (adopted_count + 1)-th kick.
+  \param kick_count the number of kicks of the action
+  \return true if the next kick is an intermediate kick
+ */
+inline
+bool
+keep_multi_kick_chain( const int adopted_count,
+                       const int kick_count )
+{
+    // the next kick is the (adopted_count + 2)-th kick
+    return adopted_count + 2 < kick_count;
+}
+
+#endif
@@ -35,15 +35,19 @@
 
 #include "predict_state.h"
 
+#include "reachability_table.h"
+
 #include <rcsc/common/server_param.h>
 
 #include <algorithm>
+#include <iostream>
 
 using namespace rcsc;
 
 //#define STRICT_LINE_UPDATE
 
 const int PredictState::VALID_PLAYER_THRESHOLD = 8;
+const int PredictState::MAX_MOVED_PLAYERS;
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -55,10 +59,13 @@ PredictState::PredictState( const WorldModel & wm )
       M_ball_holder_unum( Unum_Unknown ),
       M_ball(),
       M_self_unum( Unum_Unknown ),
-      M_our_players(),
+      M_base_players(),
+      M_moved_size( 0 ),
       M_our_defense_line_x( 0.0 ),
       M_our_offense_player_line_x( 0.0 )
 {
+    std::fill( M_moved_index, M_moved_index + 11, -1 );
+
     init( wm );
 }
 
@@ -73,11 +80,10 @@ PredictState::PredictState( const PredictState & rhs,
       M_ball_holder_unum( rhs.ballHolderUnum() ),
       M_ball( rhs.M_ball ),
       M_self_unum( rhs.M_self_unum ),
-      M_our_players( rhs.M_our_players ),
       M_our_defense_line_x( rhs.M_our_defense_line_x ),
       M_our_offense_player_line_x( rhs.M_our_offense_player_line_x )
 {
-
+    copyPlayers( rhs );
 }
 
 /*-------------------------------------------------------------------*/
@@ -93,14 +99,12 @@ PredictState::PredictState( const PredictState & rhs,
       M_ball_holder_unum( ball_holder_unum ),
       M_ball( ball_and_holder_pos ),
       M_self_unum( rhs.M_self_unum ),
-      M_our_players( rhs.M_our_players ),
       M_our_defense_line_x( rhs.M_our_defense_line_x ),
       M_our_offense_player_line_x( std::max( rhs.M_our_offense_player_line_x,
                                              ball_and_holder_pos.x ) )
 {
-    M_our_players[ ball_holder_unum - 1 ]
-        = PredictPlayerObject::Ptr( new PredictPlayerObject( *(M_our_players[ ball_holder_unum - 1 ] ),
-                                                             ball_and_holder_pos ) );
+    copyPlayers( rhs );
+    moveOurPlayer( ball_holder_unum, ball_and_holder_pos );
 
     updateLines();
 }
@@ -117,10 +121,11 @@ PredictState::PredictState( const PredictState & rhs,
       M_ball_holder_unum( rhs.M_ball_holder_unum ),
       M_ball( ball_pos ),
       M_self_unum( rhs.M_self_unum ),
-      M_our_players( rhs.M_our_players ),
       M_our_defense_line_x( rhs.M_our_defense_line_x ),
       M_our_offense_player_line_x( rhs.M_our_offense_player_line_x )
 {
+    copyPlayers( rhs );
+
     updateLines();
 }
 
@@ -169,15 +174,14 @@ PredictState::init( const WorldModel & wm )
     //
     // initialize all teammates
     //
-    M_our_players.reserve( 11 );
+    std::shared_ptr< PlayerSnapshot > players( new PlayerSnapshot() );
+    players->reserve( 11 );
 
     for ( int n = 1; n <= 11; ++n )
     {
-        PredictPlayerObject::Ptr ptr;
-
         if ( n == M_self_unum )
         {
-            ptr = PredictPlayerObject::Ptr( new PredictPlayerObject( wm.self() ) );
+            players->emplace_back( wm.self() );
         }
         else
         {
@@ -185,29 +189,111 @@ PredictState::init( const WorldModel & wm )
 
             if ( t )
             {
-                ptr = PredictPlayerObject::Ptr( new PredictPlayerObject( *t ) );
-
+                players->emplace_back( *t );
             }
             else
             {
-                ptr = PredictPlayerObject::Ptr( new PredictPlayerObject() );
+                players->emplace_back();
             }
         }
 
-        M_our_players.push_back( ptr );
-
 #ifndef STRICT_LINE_UPDATE
-        if ( ptr->isValid()
-             && M_our_offense_player_line_x < ptr->pos().x )
+        if ( players->back().isValid()
+             && M_our_offense_player_line_x < players->back().pos().x )
         {
-            M_our_offense_player_line_x = ptr->pos().x;
+            M_our_offense_player_line_x = players->back().pos().x;
         }
 #endif
     }
 
+    M_base_players = players;
+    M_moved_size = 0;
+    std::fill( M_moved_index, M_moved_index + 11, -1 );
+
     updateLines();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PredictState::copyPlayers( const PredictState & rhs )
+{
+    M_base_players = rhs.M_base_players;
+
+    M_moved_size = rhs.M_moved_size;
+    for ( int i = 0; i < M_moved_size; ++i )
+    {
+        M_moved_players[i] = rhs.M_moved_players[i];
+    }
+
+    std::copy( rhs.M_moved_index, rhs.M_moved_index + 11, M_moved_index );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  only the moved teammate is allocated. other teammates are shared with
+  the parent state.
+ */
+void
+PredictState::moveOurPlayer( const int unum,
+                             const Vector2D & pos )
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        std::cerr << "internal error: "
+                  << __FILE__ << ":" << __LINE__ << ": "
+                  << "invalid unum " << unum << std::endl;
+        return;
+    }
+
+    PredictPlayerObject::ConstPtr moved = std::make_shared< PredictPlayerObject >( *ourPlayerObject( unum ),
+                                                                                   pos );
+
+    const int idx = M_moved_index[ unum - 1 ];
+    if ( idx >= 0 )
+    {
+        M_moved_players[ idx ] = moved;
+        return;
+    }
+
+    if ( M_moved_size >= MAX_MOVED_PLAYERS )
+    {
+        mergeMovedPlayers();
+    }
+
+    M_moved_index[ unum - 1 ] = static_cast< signed char >( M_moved_size );
+    M_moved_players[ M_moved_size ] = moved;
+    ++M_moved_size;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  create the new snapshot that includes the moved teammates.
+  this happens only when the action chain is longer than MAX_MOVED_PLAYERS.
+ */
+void
+PredictState::mergeMovedPlayers()
+{
+    std::shared_ptr< PlayerSnapshot > players( new PlayerSnapshot() );
+    players->reserve( 11 );
+
+    for ( int n = 1; n <= 11; ++n )
+    {
+        players->push_back( *ourPlayerObject( n ) );
+    }
+
+    M_base_players = players;
+
+    for ( int i = 0; i < M_moved_size; ++i )
+    {
+        M_moved_players[i].reset();
+    }
+    M_moved_size = 0;
+    std::fill( M_moved_index, M_moved_index + 11, -1 );
+}
+
 void
 PredictState::updateLines()
 {
@@ -217,15 +303,13 @@ PredictState::updateLines()
 #ifdef STRICT_LINE_UPDATE
     M_our_offense_player_line_x = ServerParam::i().ourTeamGoalLineX();
 
-    const PredictPlayerPtrCont::const_iterator t_end = M_all_teammates.end();
-    for ( PredictPlayerPtrCont::const_iterator it = M_all_teammates.begin();
-          it != t_end;
-          ++it )
+    for ( int unum = 1; unum <= 11; ++unum )
     {
-        if ( (*it)->isValid()
-             && M_our_offense_player_line_x < (*it)->pos().x )
+        const PredictPlayerObject * p = ourPlayerObject( unum );
+        if ( p->isValid()
+             && M_our_offense_player_line_x < p->pos().x )
         {
-            M_our_offense_player_line_x = (*it)->pos().x;
+            M_our_offense_player_line_x = p->pos().x;
         }
     }
 #endif
@@ -246,14 +330,12 @@ PredictState::getPlayers( const PlayerPredicate * predicate ) const
         return ret;
     }
 
-    for ( PredictPlayerObject::Cont::const_iterator it = M_our_players.begin(),
-              end = M_our_players.end();
-          it != end;
-          ++it )
+    for ( int unum = 1; unum <= 11; ++unum )
     {
-        if ( (*predicate)( **it ) )
+        const PredictPlayerObject * p = ourPlayerObject( unum );
+        if ( (*predicate)( *p ) )
         {
-            ret.push_back( &(**it) );
+            ret.push_back( p );
         }
     }
 
@@ -272,3 +354,13 @@ PredictState::getPlayers( const PlayerPredicate * predicate ) const
 
     return ret;
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+PredictState::predictOpponentDist( const Vector2D & holder_pos ) const
+{
+    return ReachabilityTable::i().opponentDist( holder_pos, static_cast< int >( M_spend_time ) );
+}
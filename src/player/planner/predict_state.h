@@ -42,16 +42,24 @@
 #include <rcsc/geom/vector_2d.h>
 
 #include <memory>
+#include <vector>
 #include <algorithm>
 
 class PredictState {
 public:
     static const int VALID_PLAYER_THRESHOLD;
 
+    //! the number of teammates held by value in each state before they are merged into the snapshot
+    static const int MAX_MOVED_PLAYERS = 4;
+
     typedef std::shared_ptr< PredictState > Ptr; //!< pointer type alias
     typedef std::shared_ptr< const PredictState > ConstPtr; //!< const pointer type alias
 
 private:
+
+    //! teammates snapshot. index: unum - 1
+    typedef std::vector< PredictPlayerObject > PlayerSnapshot;
+
     const rcsc::WorldModel * M_world;
     unsigned long M_spend_time;
 
@@ -61,7 +69,15 @@ private:
 
     int M_self_unum;
 
-    PredictPlayerObject::Cont M_our_players;
+    //! immutable teammates created from the world model. shared by all derived states.
+    std::shared_ptr< const PlayerSnapshot > M_base_players;
+
+    //! teammates moved by this state or its ancestors
+    PredictPlayerObject::ConstPtr M_moved_players[MAX_MOVED_PLAYERS];
+    int M_moved_size;
+
+    //! index of M_moved_players for each teammate. -1: not moved
+    signed char M_moved_index[11];
 
     double M_our_defense_line_x;
     double M_our_offense_player_line_x;
@@ -88,6 +104,11 @@ private:
     void init( const rcsc::WorldModel & wm );
     void updateLines();
 
+    void copyPlayers( const PredictState & rhs );
+    void moveOurPlayer( const int unum,
+                        const rcsc::Vector2D & pos );
+    void mergeMovedPlayers();
+
 public:
 
     unsigned long spendTime() const
@@ -124,10 +145,10 @@ public:
               std::cerr << "internal error: "
                         << __FILE__ << ":" << __LINE__
                         << "invalid self unum " << M_self_unum << std::endl;
-              return *(M_our_players[0]);
+              return *ourPlayerObject( 1 );
           }
 
-          return *(M_our_players[ M_self_unum - 1 ]);
+          return *ourPlayerObject( M_self_unum );
       }
 
     const rcsc::AbstractPlayerObject * ourPlayer( const int unum ) const
@@ -140,17 +161,25 @@ public:
               return static_cast< const rcsc::AbstractPlayerObject * >( 0 );
           }
 
-          return &( *(M_our_players[ unum - 1 ]) );
+          return ourPlayerObject( unum );
       }
 
-    const rcsc::AbstractPlayerObject * theirPlayer( const int unum ) const
+    /*!
+      \brief get the teammate object without range check
+      \param unum uniform number [1, 11]
+      \return pointer to the predicted teammate. the object may be invalid.
+     */
+    const PredictPlayerObject * ourPlayerObject( const int unum ) const
       {
-          return M_world->theirPlayer( unum );
+          const int idx = M_moved_index[ unum - 1 ];
+          return ( idx >= 0
+                   ? M_moved_players[ idx ].get()
+                   : &(*M_base_players)[ unum - 1 ] );
       }
 
-    const PredictPlayerObject::Cont & ourPlayers() const
+    const rcsc::AbstractPlayerObject * theirPlayer( const int unum ) const
       {
-          return M_our_players;
+          return M_world->theirPlayer( unum );
       }
 
     const rcsc::AbstractPlayerObject::Cont & theirPlayers() const
@@ -163,6 +192,15 @@ public:
           return M_world->opponentsFromSelf();
       }
 
+    /*!
+      \brief get the distance from the nearest field player opponent to the ball holder
+      at this state. the opponents are not stored in each state. they are moved toward
+      the holder along the per-cycle trajectories of ReachabilityTable.
+      \param holder_pos ball holder position at this state
+      \return predicted distance
+     */
+    double predictOpponentDist( const rcsc::Vector2D & holder_pos ) const;
+
     const rcsc::PlayerObject * getOpponentNearestTo( const rcsc::Vector2D & point,
                                                      const int count_thr,
                                                      double * dist_to_point ) const
@@ -0,0 +1,297 @@
+// -*-c++-*-
+
+/*!
+  \file reachability_table.cpp
+  \brief per-cycle player reachability table for the approximate action generators Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "reachability_table.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/common/logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rcsc;
+
+namespace {
+
+//! opponents whose accuracy is lower than this are ignored
+const int VALID_OPPONENT_ACCURACY = 20;
+
+}
+
+const int ReachabilityTable::MAX_STEP;
+const int ReachabilityTable::MAX_OPPONENT;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ReachabilityTable::ReachabilityTable()
+    : M_update_time( -1, 0 ),
+      M_opponent_size( 0 )
+{
+    for ( int i = 0; i < 11; ++i )
+    {
+        std::fill( M_teammate_reach_dist[i], M_teammate_reach_dist[i] + MAX_STEP + 1, 0.0 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ReachabilityTable &
+ReachabilityTable::instance()
+{
+    static ReachabilityTable s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ReachabilityTable::create_reach_dist( const PlayerType & ptype,
+                                      double * reach_dist )
+{
+    const double accel = ServerParam::i().maxDashPower() * ptype.dashPowerRate() * ptype.effortMax();
+
+    double speed = 0.0;
+    double dist = 0.0;
+
+    reach_dist[0] = 0.0;
+    for ( int n = 1; n <= MAX_STEP; ++n )
+    {
+        speed = std::min( speed + accel, ptype.realSpeedMax() );
+        dist += speed;
+        speed *= ptype.playerDecay();
+        reach_dist[n] = dist;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ReachabilityTable::update( const WorldModel & wm )
+{
+    if ( M_update_time == wm.time() )
+    {
+        return;
+    }
+    M_update_time = wm.time();
+
+    const ServerParam & SP = ServerParam::i();
+
+    M_opponent_size = 0;
+    for ( const AbstractPlayerObject * o : wm.theirPlayers() )
+    {
+        if ( M_opponent_size >= MAX_OPPONENT ) break;
+        if ( o->isGhost()
+             || o->posCount() > VALID_OPPONENT_ACCURACY )
+        {
+            continue;
+        }
+
+        const PlayerType * ptype = o->playerTypePtr();
+        if ( ! ptype ) continue;
+
+        const Vector2D pos = o->pos() + o->vel();
+        M_opponent_x[M_opponent_size] = pos.x;
+        M_opponent_y[M_opponent_size] = pos.y;
+        M_opponent_radius[M_opponent_size] = ( o->goalie()
+                                               && pos.x > SP.theirPenaltyAreaLineX()
+                                               && pos.absY() < SP.penaltyAreaHalfWidth()
+                                               ? SP.catchableArea()
+                                               : ptype->kickableArea() );
+        M_opponent_goalie[M_opponent_size] = o->goalie();
+        create_reach_dist( *ptype, M_opponent_reach_dist[M_opponent_size] );
+
+        Vector2D inertia_pos = o->pos();
+        Vector2D inertia_vel = o->vel();
+        for ( int n = 0; n <= MAX_STEP; ++n )
+        {
+            M_opponent_inertia_x[n][M_opponent_size] = inertia_pos.x;
+            M_opponent_inertia_y[n][M_opponent_size] = inertia_pos.y;
+            inertia_pos += inertia_vel;
+            inertia_vel *= ptype->playerDecay();
+        }
+
+        ++M_opponent_size;
+    }
+
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        const PlayerType * ptype = wm.ourPlayerType( unum );
+        if ( ptype )
+        {
+            create_reach_dist( *ptype, M_teammate_reach_dist[unum - 1] );
+        }
+    }
+
+    dlog.addText( Logger::ACTION_CHAIN,
+                  __FILE__": (update) opponents=%d", M_opponent_size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ReachabilityTable::opponentReachStep( const Vector2D & point,
+                                      const int max_step ) const
+{
+    const int limit = std::min( max_step, MAX_STEP );
+    int best = max_step + 1;
+
+    for ( int i = 0; i < M_opponent_size; ++i )
+    {
+        const double dist = std::sqrt( std::pow( M_opponent_x[i] - point.x, 2 )
+                                       + std::pow( M_opponent_y[i] - point.y, 2 ) )
+            - M_opponent_radius[i];
+        if ( dist <= 0.0 )
+        {
+            return 0;
+        }
+
+        // 1 step is spent for turn
+        for ( int n = 1; n < best && n <= limit; ++n )
+        {
+            if ( M_opponent_reach_dist[i][n - 1] >= dist )
+            {
+                best = n;
+                break;
+            }
+        }
+    }
+
+    return best;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+ReachabilityTable::opponentDist( const Vector2D & holder_pos,
+                                 const int spend_time ) const
+{
+    const int step = std::max( 0, std::min( spend_time, MAX_STEP ) );
+    // 1 step is spent for turn
+    const int move_step = std::max( 0, step - 1 );
+
+    const double * inertia_x = M_opponent_inertia_x[step];
+    const double * inertia_y = M_opponent_inertia_y[step];
+
+    double min_dist = 1000.0;
+    for ( int i = 0; i < M_opponent_size; ++i )
+    {
+        if ( M_opponent_goalie[i] ) continue;
+
+        const double dist = std::sqrt( std::pow( inertia_x[i] - holder_pos.x, 2 )
+                                       + std::pow( inertia_y[i] - holder_pos.y, 2 ) )
+            - M_opponent_reach_dist[i][move_step];
+        min_dist = std::min( min_dist, dist );
+    }
+
+    return std::max( 0.0, min_dist );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ReachabilityTable::teammateReachStep( const int unum,
+                                      const double dist ) const
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        return MAX_STEP + 1;
+    }
+
+    const double * reach_dist = M_teammate_reach_dist[unum - 1];
+    for ( int n = 0; n <= MAX_STEP; ++n )
+    {
+        if ( reach_dist[n] >= dist )
+        {
+            return n;
+        }
+    }
+
+    return MAX_STEP + 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ReachabilityTable::canPass( const Vector2D & from,
+                            const Vector2D & receive_point,
+                            const double first_ball_speed,
+                            const int ball_step ) const
+{
+    const double ball_decay = ServerParam::i().ballDecay();
+
+    Vector2D ball_vel = ( receive_point - from ).setLengthVector( first_ball_speed );
+    Vector2D ball_pos = from;
+
+    for ( int t = 1; t <= ball_step; ++t )
+    {
+        ball_pos += ball_vel;
+        ball_vel *= ball_decay;
+
+        // 1 step is spent for turn
+        const int opp_step = std::min( t - 1, MAX_STEP );
+
+        for ( int i = 0; i < M_opponent_size; ++i )
+        {
+            const double dist2 = std::pow( M_opponent_x[i] - ball_pos.x, 2 )
+                + std::pow( M_opponent_y[i] - ball_pos.y, 2 );
+            const double reach = M_opponent_reach_dist[i][opp_step] + M_opponent_radius[i];
+
+            if ( dist2 <= reach * reach )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,152 @@
+// -*-c++-*-
+
+/*!
+  \file reachability_table.h
+  \brief per-cycle player reachability table for the approximate action generators Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef REACHABILITY_TABLE_H
+#define REACHABILITY_TABLE_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+class PlayerType;
+class WorldModel;
+}
+
+/*!
+  \class ReachabilityTable
+  \brief per-cycle table of how far each player can move in N steps.
+
+  The table is created once per cycle from the world model and shared by
+  the approximate generators used for the deeper levels of the action
+  chain search. Each query is a flat loop over the opponents without any
+  call into the player type.
+
+  The table also holds the inertia trajectory of each opponent indexed by
+  the elapsed step, so that the predicted states can move the opponents
+  toward the ball holder without copying them into each state.
+ */
+class ReachabilityTable {
+public:
+    //! the maximum step stored in the table
+    static const int MAX_STEP = 30;
+
+private:
+
+    //! the number of opponents stored
+    static const int MAX_OPPONENT = 11;
+
+    rcsc::GameTime M_update_time;
+
+    int M_opponent_size;
+    double M_opponent_x[MAX_OPPONENT];
+    double M_opponent_y[MAX_OPPONENT];
+    double M_opponent_radius[MAX_OPPONENT];
+    bool M_opponent_goalie[MAX_OPPONENT];
+    //! opponent position moved by inertia. index: [step][opponent]
+    double M_opponent_inertia_x[MAX_STEP + 1][MAX_OPPONENT];
+    double M_opponent_inertia_y[MAX_STEP + 1][MAX_OPPONENT];
+    //! cumulative reachable distance from a stop. index: step
+    double M_opponent_reach_dist[MAX_OPPONENT][MAX_STEP + 1];
+
+    //! cumulative reachable distance of the teammates. index: [unum - 1][step]
+    double M_teammate_reach_dist[11][MAX_STEP + 1];
+
+    ReachabilityTable();
+
+    // not used
+    ReachabilityTable( const ReachabilityTable & );
+    const ReachabilityTable & operator=( const ReachabilityTable & );
+public:
+
+    static
+    ReachabilityTable & instance();
+
+    static
+    const ReachabilityTable & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief update the table. nothing is done if already updated in this cycle.
+      \param wm world model
+     */
+    void update( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief get the minimum step for any opponent to reach the point
+      \param point target point
+      \param max_step search limit
+      \return estimated step. (max_step + 1) if no opponent can reach.
+     */
+    int opponentReachStep( const rcsc::Vector2D & point,
+                           const int max_step ) const;
+
+    /*!
+      \brief get the predicted distance from the nearest field player opponent to the ball holder.
+      the opponents move by inertia and run toward the ball holder after one turn step.
+      \param holder_pos predicted ball holder position
+      \param spend_time elapsed steps from the current cycle
+      \return predicted distance. 1000.0 if no opponent.
+     */
+    double opponentDist( const rcsc::Vector2D & holder_pos,
+                         const int spend_time ) const;
+
+    /*!
+      \brief get the step for the teammate to move the distance
+      \param unum teammate's uniform number
+      \param dist move distance
+      \return estimated step. (MAX_STEP + 1) if too far.
+     */
+    int teammateReachStep( const int unum,
+                           const double dist ) const;
+
+    /*!
+      \brief check if any opponent can intercept the ball before the receive point
+      \param from kick point
+      \param receive_point ball receive point
+      \param first_ball_speed first ball speed
+      \param ball_step the number of ball steps to the receive point
+      \return true if no opponent can reach the ball trajectory in time
+     */
+    bool canPass( const rcsc::Vector2D & from,
+                  const rcsc::Vector2D & receive_point,
+                  const double first_ball_speed,
+                  const int ball_step ) const;
+
+private:
+
+    static
+    void create_reach_dist( const rcsc::PlayerType & ptype,
+                            double * reach_dist );
+};
+
+#endif
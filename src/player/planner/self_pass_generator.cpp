@@ -39,6 +39,7 @@
 #include "field_analyzer.h"
 
 #include "basic_actions/kick_table.h"
+#include "basic_actions/self_motion_cache.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/common/server_param.h>
@@ -77,6 +78,77 @@ debug_paint_failed( const int count,
                      receive_point, num );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the stamina that the self pass keeps unused
+ */
+double
+get_stamina_threshold( const WorldModel & wm )
+{
+    return ( wm.self().staminaModel().capacityIsEmpty()
+             ? -wm.self().playerType().extraStamina() // minus value to set available stamina
+             : ServerParam::i().recoverDecThrValue() + 350.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the number of dashes the self pass can use in the motion
+ */
+int
+get_dash_count( const WorldModel & wm,
+                const SelfMotionCache::Motion & motion,
+                const AngleDeg & dash_angle,
+                const int n_turn,
+                const int max_dash )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const double stamina_thr = get_stamina_threshold( wm );
+
+    for ( int i = 0; i < max_dash; ++i )
+    {
+        if ( motion.stamina_[n_turn + i] < stamina_thr )
+        {
+#ifdef DEBUG_PRINT_SELF_CACHE
+            dlog.addText( Logger::DRIBBLE,
+                          "?: SelfPass (get_dash_count) turn=%d dash=%d. stamina=%.1f < threshold",
+                          n_turn, i, motion.stamina_[n_turn + i] );
+#endif
+            return i;
+        }
+
+        const Vector2D & my_pos = motion.pos_[n_turn + i + 1];
+
+        if ( my_pos.x > SP.pitchHalfLength() - 2.5 )
+        {
+#ifdef DEBUG_PRINT_SELF_CACHE
+            dlog.addText( Logger::DRIBBLE,
+                          "?: SelfPass (get_dash_count) turn=%d dash=%d. my_x=%.2f. over goal line",
+                          n_turn, i + 1, my_pos.x );
+#endif
+            return i;
+        }
+
+        if ( my_pos.absY() > SP.pitchHalfWidth() - 3.0
+             && ( ( my_pos.y > 0.0 && dash_angle.degree() > 0.0 )
+                  || ( my_pos.y < 0.0 && dash_angle.degree() < 0.0 ) )
+             )
+        {
+#ifdef DEBUG_PRINT_SELF_CACHE
+            dlog.addText( Logger::DRIBBLE,
+                          "?: SelfPass (get_dash_count) turn=%d dash=%d."
+                          " my_pos=(%.2f %.2f). dash_angle=%.1f",
+                          n_turn, i + 1,
+                          my_pos.x, my_pos.y,
+                          dash_angle.degree() );
+#endif
+            return i;
+        }
+    }
+
+    return max_dash;
+}
+
 }
 
 /*-------------------------------------------------------------------*/
@@ -167,8 +239,6 @@ SelfPassGenerator::createCourses( const WorldModel & wm )
     static const int ANGLE_DIVS = 60;
     static const double ANGLE_STEP = 360.0 / ANGLE_DIVS;
 
-    static std::vector< Vector2D > self_cache( 24 );
-
     const ServerParam & SP = ServerParam::i();
 
     const Vector2D ball_pos = wm.ball().pos();
@@ -224,11 +294,13 @@ SelfPassGenerator::createCourses( const WorldModel & wm )
             continue;
         }
 
-        createSelfCache( wm, dash_angle,
-                         n_turn, max_dash,
-                         self_cache );
+        const SelfMotionCache::Motion & self_cache
+            = SelfMotionCache::instance().get( wm, n_turn, max_dash,
+                                               SP.maxDashPower(), dash_angle,
+                                               get_stamina_threshold( wm ),
+                                               false );
 
-        int n_dash = self_cache.size() - n_turn;
+        int n_dash = get_dash_count( wm, self_cache, dash_angle, n_turn, max_dash );
 
         if ( n_dash < min_dash )
         {
@@ -260,7 +332,7 @@ SelfPassGenerator::createCourses( const WorldModel & wm )
                 dash_dec = 1;
             }
 
-            const Vector2D receive_pos = self_cache[n_turn + n_dash - 1];
+            const Vector2D receive_pos = self_cache.pos_[n_turn + n_dash];
 
             if ( receive_pos.dist2( our_goal ) < goal_dist_thr2 )
             {
@@ -327,124 +399,6 @@ SelfPassGenerator::createCourses( const WorldModel & wm )
 
 }
 
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-SelfPassGenerator::createSelfCache( const WorldModel & wm,
-                                    const AngleDeg & dash_angle,
-                                    const int n_turn,
-                                    const int n_dash,
-                                    std::vector< Vector2D > & self_cache )
-{
-    self_cache.clear();
-
-    const PlayerType & ptype = wm.self().playerType();
-
-    const double dash_power = ServerParam::i().maxDashPower();
-    const double stamina_thr = ( wm.self().staminaModel().capacityIsEmpty()
-                                 ? -ptype.extraStamina() // minus value to set available stamina
-                                 : ServerParam::i().recoverDecThrValue() + 350.0 );
-
-    StaminaModel stamina_model = wm.self().staminaModel();
-
-    Vector2D my_pos = wm.self().pos();
-    Vector2D my_vel = wm.self().vel();
-
-    //
-    // 1 kick
-    //
-    my_pos += my_vel;
-    my_vel *= ptype.playerDecay();
-    stamina_model.simulateWait( ptype );
-
-    //
-    // turns
-    //
-    for ( int i = 0; i < n_turn; ++i )
-    {
-        my_pos += my_vel;
-        my_vel *= ptype.playerDecay();
-        stamina_model.simulateWait( ptype );
-
-        self_cache.push_back( my_pos );
-    }
-
-    //
-    // simulate dashes
-    //
-    for ( int i = 0; i < n_dash; ++i )
-    {
-        if ( stamina_model.stamina() < stamina_thr )
-        {
-#ifdef DEBUG_PRINT_SELF_CACHE
-            dlog.addText( Logger::DRIBBLE,
-                          "?: SelfPass (createSelfCache) turn=%d dash=%d. stamina=%.1f < threshold",
-                          n_turn, n_dash, stamina_model.stamina() );
-#endif
-            break;
-        }
-
-        double available_stamina =  std::max( 0.0, stamina_model.stamina() - stamina_thr );
-        double actual_dash_power = std::min( dash_power, available_stamina );
-        double accel_mag = actual_dash_power * ptype.dashPowerRate() * stamina_model.effort();
-        Vector2D dash_accel = Vector2D::polar2vector( accel_mag, dash_angle );
-
-        // TODO: check playerSpeedMax & update actual_dash_power if necessary
-        // if ( ptype.normalizeAccel( my_vel, &dash_accel ) ) actual_dash_power = ...
-
-        my_vel += dash_accel;
-        my_pos += my_vel;
-
-// #ifdef DEBUG_PRINT_SELF_CACHE
-//         dlog.addText( Logger::DRIBBLE,
-//                       "___ dash=%d accel=(%.2f %.2f)r=%.2f th=%.1f pos=(%.2f %.2f) vel=(%.2f %.2f)",
-//                       i + 1,
-//                       dash_accel.x, dash_accel.y, dash_accel.r(), dash_accel.th().degree(),
-//                       my_pos.x, my_pos.y,
-//                       my_vel.x, my_vel.y );
-// #endif
-
-        if ( my_pos.x > ServerParam::i().pitchHalfLength() - 2.5 )
-        {
-#ifdef DEBUG_PRINT_SELF_CACHE
-            dlog.addText( Logger::DRIBBLE,
-                          "?: SelfPass (createSelfCache) turn=%d dash=%d. my_x=%.2f. over goal line",
-                          n_turn, n_dash, my_pos.x );
-#endif
-            break;
-        }
-
-        if ( my_pos.absY() > ServerParam::i().pitchHalfWidth() - 3.0
-             && ( ( my_pos.y > 0.0 && dash_angle.degree() > 0.0 )
-                  || ( my_pos.y < 0.0 && dash_angle.degree() < 0.0 ) )
-             )
-        {
-#ifdef DEBUG_PRINT_SELF_CACHE
-            dlog.addText( Logger::DRIBBLE,
-                          "?: SelfPass (createSelfCache) turn=%d dash=%d."
-                          " my_pos=(%.2f %.2f). dash_angle=%.1f",
-                          n_turn, n_dash,
-                          my_pos.x, my_pos.y,
-                          dash_angle.degree() );
-            dlog.addText( Logger::DRIBBLE,
-                          "__ dash_accel=(%.2f %.2f)r=%.2f  vel=(%.2f %.2f)r=%.2f th=%.1f",
-                          dash_accel.x, dash_accel.y, accel_mag,
-                          my_vel.x, my_vel.y, my_vel.r(), my_vel.th().degree() );
-
-#endif
-
-            break;
-        }
-
-        my_vel *= ptype.playerDecay();
-        stamina_model.simulateDash( ptype, actual_dash_power );
-
-        self_cache.push_back( my_pos );
-    }
-}
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -78,12 +78,6 @@ private:
 
     void createCourses( const rcsc::WorldModel & wm );
 
-    void createSelfCache( const rcsc::WorldModel & wm,
-                          const rcsc::AngleDeg & dash_angle,
-                          const int n_turn,
-                          const int n_dash,
-                          std::vector< rcsc::Vector2D > & self_cache );
-
     bool canKick( const rcsc::WorldModel & wm,
                   const int n_turn,
                   const int n_dash,
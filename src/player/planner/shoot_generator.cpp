@@ -56,8 +56,25 @@
 
 // #define DEBUG_PRINT_EVALUATE
 
+// #define DEBUG_CULL_OPPONENT
+
 using namespace rcsc;
 
+namespace {
+
+//! buffer added to the goalie's control area by maybeGoalieCatch()
+const double GOALIE_CONTROL_AREA_BUF = 0.15;
+
+//! absorbs the 0.001 tolerance of PlayerType::cyclesToReachDistance()
+const double CULL_MARGIN = 0.01;
+
+#ifdef DEBUG_PROFILE
+int s_exact_check_count = 0;
+int s_cull_count = 0;
+#endif
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -65,6 +82,8 @@ using namespace rcsc;
 ShootGenerator::ShootGenerator()
 {
     M_courses.reserve( 32 );
+    M_opponents.reserve( 11 );
+    M_ball_path.reserve( 64 );
 
     clear();
 }
@@ -88,9 +107,112 @@ void
 ShootGenerator::clear()
 {
     M_total_count = 0;
+    M_opponents.clear();
+    M_ball_path.clear();
     M_courses.clear();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  collect the opponents that can affect any shoot course in this cycle.
+  the filters do not depend on the course, so they are applied once
+  instead of once per (target, speed) pair.
+ */
+void
+ShootGenerator::updateOpponents( const WorldModel & wm )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const double opponent_x_thr = SP.theirPenaltyAreaLineX() - 30.0;
+    const double opponent_y_thr = SP.penaltyAreaHalfWidth();
+
+    for ( PlayerObject::Cont::const_iterator o = wm.opponentsFromSelf().begin(),
+              end = wm.opponentsFromSelf().end();
+          o != end;
+          ++o )
+    {
+        if ( (*o)->isTackling() ) continue;
+        if ( (*o)->pos().x < opponent_x_thr ) continue;
+        if ( (*o)->pos().absY() > opponent_y_thr ) continue;
+
+        if ( ! (*o)->goalie() )
+        {
+            if ( (*o)->posCount() > 10 ) continue;
+            if ( (*o)->isGhost() && (*o)->posCount() > 5 ) continue;
+        }
+
+        const PlayerType * ptype = (*o)->playerTypePtr();
+
+        // upper bound of the distance covered by inertiaPoint()
+        const double inertia_travel = ( (*o)->vel().r()
+                                        / std::max( 0.01, 1.0 - ptype->playerDecay() ) );
+
+        double control_area = ptype->kickableArea();
+        if ( (*o)->goalie() )
+        {
+            control_area = std::max( control_area, SP.catchableArea() )
+                + GOALIE_CONTROL_AREA_BUF
+                + (*o)->distFromSelf() * 0.02; // seen_dist_noise
+        }
+
+        Opponent opp;
+        opp.player_ = *o;
+        opp.speed_max_ = ptype->realSpeedMax();
+        opp.reach_buf_ = control_area + inertia_travel + CULL_MARGIN;
+
+        M_opponents.push_back( opp );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  ball positions of the course. computed with the same expression as
+  before so that the exact checks see identical values.
+ */
+void
+ShootGenerator::updateBallPath( const Course & course )
+{
+    const double ball_decay = ServerParam::i().ballDecay();
+
+    M_ball_path.clear();
+    for ( int cycle = 0; cycle < course.ball_reach_step_; ++cycle )
+    {
+        M_ball_path.push_back( inertia_n_step_point( M_first_ball_pos,
+                                                     course.first_ball_vel_,
+                                                     cycle,
+                                                     ball_decay ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  closed form bound of maybeGoalieCatch() and opponentCanReach().
+  both checks need cyclesToReachDistance( dash_dist ) <= cycle + posCount
+  for some cycle < ball_reach_step before they can report or flag anything,
+  and the dash distance table never exceeds realSpeedMax() per cycle.
+  while the ball stays on the segment from the first ball position to the
+  target point, the opponent is out of reach if the segment is farther than
+  that distance plus the control area and the inertia travel.
+ */
+bool
+ShootGenerator::isOutOfReach( const Opponent & opponent,
+                              const Course & course ) const
+{
+    const int max_cycle = course.ball_reach_step_ - 1 + opponent.player_->posCount();
+    const double reach = ( opponent.speed_max_ * max_cycle + CULL_MARGIN ) / 0.999
+        + opponent.reach_buf_;
+
+    const Vector2D rel = opponent.player_->pos() - M_first_ball_pos;
+    const double ux = course.first_ball_vel_.x / course.first_ball_speed_;
+    const double uy = course.first_ball_vel_.y / course.first_ball_speed_;
+
+    const double along = bound( 0.0, rel.x * ux + rel.y * uy, course.ball_move_dist_ );
+    const double dx = rel.x - ux * along;
+    const double dy = rel.y - uy * along;
+
+    return dx * dx + dy * dy > reach * reach;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -139,8 +261,12 @@ ShootGenerator::generate( const WorldModel & wm )
 
 #ifdef DEBUG_PROFILE
     Timer timer;
+    s_exact_check_count = 0;
+    s_cull_count = 0;
 #endif
 
+    updateOpponents( wm );
+
     Vector2D goal_l( SP.pitchHalfLength(), -SP.goalHalfWidth() );
     Vector2D goal_r( SP.pitchHalfLength(), +SP.goalHalfWidth() );
 
@@ -187,10 +313,13 @@ ShootGenerator::generate( const WorldModel & wm )
 
 #ifdef DEBUG_PROFILE
     dlog.addText( Logger::SHOOT,
-                  __FILE__": PROFILE %d/%d. elapsed=%.3f [ms]",
+                  __FILE__": PROFILE %d/%d. elapsed=%.3f [ms] opponents=%d exact=%d culled=%d",
                   (int)M_courses.size(),
                   DIST_DIVS,
-                  timer.elapsedReal() );
+                  timer.elapsedReal(),
+                  (int)M_opponents.size(),
+                  s_exact_check_count,
+                  s_cull_count );
 #endif
 
 }
@@ -332,7 +461,7 @@ ShootGenerator::createShoot( const WorldModel & wm,
 
  */
 bool
-ShootGenerator::createShoot( const WorldModel & wm,
+ShootGenerator::createShoot( const WorldModel &,
                              const Vector2D & target_point,
                              const double & first_ball_speed,
                              const rcsc::AngleDeg & ball_move_angle,
@@ -375,27 +504,56 @@ ShootGenerator::createShoot( const WorldModel & wm,
 
     // estimate opponent interception
 
-    const double opponent_x_thr = SP.theirPenaltyAreaLineX() - 30.0;
-    const double opponent_y_thr = SP.penaltyAreaHalfWidth();
+    M_ball_path.clear();
 
-    for ( PlayerObject::Cont::const_iterator o = wm.opponentsFromSelf().begin(),
-              end = wm.opponentsFromSelf().end();
+    for ( std::vector< Opponent >::const_iterator o = M_opponents.begin(),
+              end = M_opponents.end();
           o != end;
           ++o )
     {
-        if ( (*o)->isTackling() ) continue;
-        if ( (*o)->pos().x < opponent_x_thr ) continue;
-        if ( (*o)->pos().absY() > opponent_y_thr ) continue;
+        const PlayerObject * opponent = o->player_;
 
         // behind of shoot course
-        if ( ( ball_move_angle - (*o)->angleFromSelf() ).abs() > 90.0 )
+        if ( ( ball_move_angle - opponent->angleFromSelf() ).abs() > 90.0 )
         {
             continue;
         }
 
-        if ( (*o)->goalie() )
+        if ( isOutOfReach( *o, course ) )
+        {
+#ifdef DEBUG_PROFILE
+            ++s_cull_count;
+#endif
+#ifdef DEBUG_CULL_OPPONENT
+            if ( M_ball_path.empty() ) updateBallPath( course );
+            Course tmp = course;
+            if ( ( opponent->goalie()
+                   ? maybeGoalieCatch( opponent, tmp )
+                   : opponentCanReach( opponent, tmp ) )
+                 || tmp.goalie_never_reach_ != course.goalie_never_reach_
+                 || tmp.opponent_never_reach_ != course.opponent_never_reach_ )
+            {
+                dlog.addText( Logger::SHOOT,
+                              "%d: ERROR culled opponent %d (%.2f %.2f) affects the course",
+                              M_total_count,
+                              opponent->unum(),
+                              opponent->pos().x, opponent->pos().y );
+            }
+#endif
+            continue;
+        }
+
+#ifdef DEBUG_PROFILE
+        ++s_exact_check_count;
+#endif
+        if ( M_ball_path.empty() )
         {
-            if ( maybeGoalieCatch( *o, course ) )
+            updateBallPath( course );
+        }
+
+        if ( opponent->goalie() )
+        {
+            if ( maybeGoalieCatch( opponent, course ) )
             {
 #ifdef DEBUG_PRINT
                 dlog.addText( Logger::SHOOT,
@@ -411,10 +569,7 @@ ShootGenerator::createShoot( const WorldModel & wm,
         // check field player
         //
 
-        if ( (*o)->posCount() > 10 ) continue;
-        if ( (*o)->isGhost() && (*o)->posCount() > 5 ) continue;
-
-        if ( opponentCanReach( *o, course ) )
+        if ( opponentCanReach( opponent, course ) )
         {
 #ifdef DEBUG_PRINT
                 dlog.addText( Logger::SHOOT,
@@ -441,7 +596,7 @@ ShootGenerator::maybeGoalieCatch( const PlayerObject * goalie,
                                                 -ServerParam::i().penaltyAreaHalfWidth() ),
                                       Size2D( ServerParam::i().penaltyAreaLength(),
                                               ServerParam::i().penaltyAreaWidth() ) );
-    static const double CONTROL_AREA_BUF = 0.15;  // buffer for kick table
+    static const double CONTROL_AREA_BUF = GOALIE_CONTROL_AREA_BUF;  // buffer for kick table
 
     const ServerParam & SP = ServerParam::i();
 
@@ -474,10 +629,7 @@ ShootGenerator::maybeGoalieCatch( const PlayerObject * goalie,
 
     for ( int cycle = min_cycle; cycle < max_cycle; ++cycle )
     {
-        const Vector2D ball_pos = inertia_n_step_point( M_first_ball_pos,
-                                                        course.first_ball_vel_,
-                                                        cycle,
-                                                        SP.ballDecay() );
+        const Vector2D & ball_pos = M_ball_path[cycle];
         if ( ball_pos.x > SP.pitchHalfLength() )
         {
 #ifdef DEBUG_PRINT
@@ -611,8 +763,6 @@ bool
 ShootGenerator::opponentCanReach( const PlayerObject * opponent,
                                   Course & course )
 {
-    const ServerParam & SP = ServerParam::i();
-
     const PlayerType * ptype = opponent->playerTypePtr();
     const double control_area = ptype->kickableArea();
 
@@ -643,10 +793,7 @@ ShootGenerator::opponentCanReach( const PlayerObject * opponent,
 
     for ( int cycle = min_cycle; cycle < max_cycle; ++cycle )
     {
-        Vector2D ball_pos = inertia_n_step_point( M_first_ball_pos,
-                                                  course.first_ball_vel_,
-                                                  cycle,
-                                                  SP.ballDecay() );
+        const Vector2D & ball_pos = M_ball_path[cycle];
 
         Vector2D inertia_pos = opponent->inertiaPoint( cycle );
         double target_dist = inertia_pos.dist( ball_pos );
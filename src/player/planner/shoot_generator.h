@@ -120,12 +120,28 @@ public:
 
 private:
 
+    /*!
+      \struct Opponent
+      \brief opponent that passed the static filters, shared by all courses
+     */
+    struct Opponent {
+        const rcsc::PlayerObject * player_; //!< original object
+        double speed_max_; //!< real speed max of the player type
+        double reach_buf_; //!< control area + noise + inertia travel
+    };
+
     //! search count
     int M_total_count;
 
     //! first ball position
     rcsc::Vector2D M_first_ball_pos;
 
+    //! opponent candidates for the current cycle
+    std::vector< Opponent > M_opponents;
+
+    //! ball positions of the current course, shared by the exact checks
+    std::vector< rcsc::Vector2D > M_ball_path;
+
     //! cached calculated shoot pathes
     Container M_courses;
 
@@ -157,6 +173,13 @@ private:
 
     void clear();
 
+    void updateOpponents( const rcsc::WorldModel & wm );
+
+    void updateBallPath( const Course & course );
+
+    bool isOutOfReach( const Opponent & opponent,
+                       const Course & course ) const;
+
     void createShoot( const rcsc::WorldModel & wm,
                       const rcsc::Vector2D & target_point );
 
@@ -38,6 +38,8 @@
 #include "dribble.h"
 #include "field_analyzer.h"
 
+#include "basic_actions/self_motion_cache.h"
+
 #include <rcsc/player/world_model.h>
 #include <rcsc/player/intercept_table.h>
 #include <rcsc/common/server_param.h>
@@ -526,14 +528,16 @@ ShortDribbleGenerator::simulateKickTurnsDashes( const WorldModel & wm,
     static const int min_dash = 2;
     //static const int min_dash = 1;
 
-    static std::vector< Vector2D > self_cache;
+    const ServerParam & SP = ServerParam::i();
 
     //
-    // create self position cache
+    // get self position cache
     //
-    createSelfCache( wm, dash_angle, n_turn, max_dash, self_cache );
-
-    const ServerParam & SP = ServerParam::i();
+    const std::vector< Vector2D > & self_cache
+        = SelfMotionCache::instance().get( wm, n_turn, max_dash,
+                                           SP.maxDashPower(), dash_angle,
+                                           SP.recoverDecThrValue() + 300.0,
+                                           false ).pos_;
     const PlayerType & ptype = wm.self().playerType();
 
     const Vector2D trap_rel
@@ -645,61 +649,6 @@ ShortDribbleGenerator::simulateKickTurnsDashes( const WorldModel & wm,
     }
 }
 
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-void
-ShortDribbleGenerator::createSelfCache( const WorldModel & wm,
-                                        const AngleDeg & dash_angle,
-                                        const int n_turn,
-                                        const int n_dash,
-                                        std::vector< Vector2D > & self_cache )
-{
-    const ServerParam & SP = ServerParam::i();
-    const PlayerType & ptype = wm.self().playerType();
-
-    self_cache.clear();
-
-    StaminaModel stamina_model = wm.self().staminaModel();
-
-    Vector2D my_pos = wm.self().pos();
-    Vector2D my_vel = wm.self().vel();
-
-    my_pos += my_vel;
-    my_vel *= ptype.playerDecay();
-
-    self_cache.push_back( my_pos ); // first element is next cycle just after kick
-
-    for ( int i = 0; i < n_turn; ++i )
-    {
-        my_pos += my_vel;
-        my_vel *= ptype.playerDecay();
-        self_cache.push_back( my_pos );
-    }
-
-    stamina_model.simulateWaits( ptype, 1 + n_turn );
-
-    const Vector2D unit_vec = Vector2D::polar2vector( 1.0, dash_angle );
-
-    for ( int i = 0; i < n_dash; ++i )
-    {
-        double available_stamina = std::max( 0.0,
-                                             stamina_model.stamina() - SP.recoverDecThrValue() - 300.0 );
-        double dash_power = std::min( available_stamina, SP.maxDashPower() );
-        Vector2D dash_accel = unit_vec.setLengthVector( dash_power * ptype.dashPowerRate() * stamina_model.effort() );
-
-        my_vel += dash_accel;
-        my_pos += my_vel;
-        my_vel *= ptype.playerDecay();
-
-        stamina_model.simulateDash( ptype, dash_power );
-
-        self_cache.push_back( my_pos );
-    }
-
-}
-
 /*-------------------------------------------------------------------*/
 /*!
 
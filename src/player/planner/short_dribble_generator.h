@@ -93,12 +93,6 @@ private:
                                   const rcsc::AngleDeg & dash_angle,
                                   const int n_turn );
 
-    void createSelfCache( const rcsc::WorldModel & wm,
-                          const rcsc::AngleDeg & dash_angle,
-                          const int n_turn,
-                          const int n_dash,
-                          std::vector< rcsc::Vector2D > & self_cache );
-
     bool checkOpponent( const rcsc::WorldModel & wm,
                         const rcsc::Vector2D & ball_trap_pos,
                         const int dribble_step );
@@ -43,6 +43,7 @@
 
 #include "pass.h"
 #include "field_analyzer.h"
+#include "fast_geometry.h"
 
 #include <rcsc/player/world_model.h>
 #include <rcsc/player/intercept_table.h>
@@ -71,6 +72,7 @@
 
 // #define DEBUG_PREDICT_RECEIVER
 // #define DEBUG_PREDICT_OPPONENT_REACH_STEP
+// #define DEBUG_SCREEN_OPPONENT
 
 // #define DEBUG_PRINT_SUCCESS_PASS
 // #define DEBUG_PRINT_FAILED_PASS
@@ -82,6 +84,9 @@ using namespace rcsc;
 
 namespace {
 
+//! the maximum ball step of the float32 opponent screening
+const int MAX_SCREEN_STEP = 64;
+
 inline
 void
 debug_paint_failed_pass( const int count,
@@ -106,16 +111,17 @@ debug_paint_failed_pass( const int count,
 /*!
 
  */
-StrictCheckPassGenerator::Receiver::Receiver( const AbstractPlayerObject * p,
+StrictCheckPassGenerator::Receiver::Receiver( const AgentTable::Players & players,
+                                              const int index,
                                               const Vector2D & first_ball_pos )
-    : player_( p ),
-      pos_( p->seenPosCount() <= p->posCount() ? p->seenPos() : p->pos() ),
-      vel_( p->seenVelCount() <= p->velCount() ? p->seenVel() : p->vel() ),
-      inertia_pos_( p->playerTypePtr()->inertiaFinalPoint( pos_, vel_ ) ),
+    : player_( players.player_[index] ),
+      pos_( players.seenPos( index ) ),
+      vel_( players.seenVel( index ) ),
+      inertia_pos_( players.inertiaFinalPoint( index ) ),
       speed_( vel_.r() ),
-      penalty_distance_( FieldAnalyzer::estimate_virtual_dash_distance( p ) ),
-      penalty_step_( p->playerTypePtr()->cyclesToReachDistance( penalty_distance_ ) ),
-      angle_from_ball_( ( p->pos() - first_ball_pos ).th() )
+      penalty_distance_( players.reach_bonus_[index] ),
+      penalty_step_( players.ptype_[index]->cyclesToReachDistance( penalty_distance_ ) ),
+      angle_from_ball_( ( players.pos( index ) - first_ball_pos ).th() )
 {
 
 }
@@ -124,12 +130,13 @@ StrictCheckPassGenerator::Receiver::Receiver( const AbstractPlayerObject * p,
 /*!
 
  */
-StrictCheckPassGenerator::Opponent::Opponent( const AbstractPlayerObject * p )
-    : player_( p ),
-      pos_( p->seenPosCount() <= p->posCount() ? p->seenPos() : p->pos() ),
-      vel_( p->seenVelCount() <= p->velCount() ? p->seenVel() : p->vel() ),
+StrictCheckPassGenerator::Opponent::Opponent( const AgentTable::Players & players,
+                                              const int index )
+    : player_( players.player_[index] ),
+      pos_( players.seenPos( index ) ),
+      vel_( players.seenVel( index ) ),
       speed_( vel_.r() ),
-      bonus_distance_( FieldAnalyzer::estimate_virtual_dash_distance( p ) )
+      bonus_distance_( players.reach_bonus_[index] )
 {
 
 }
@@ -177,6 +184,7 @@ StrictCheckPassGenerator::clear()
     M_first_point.invalidate();
     M_receiver_candidates.clear();
     M_opponents.clear();
+    M_opponent_screen.size_ = 0;
     M_direct_size = M_leading_size = M_through_size = 0;
     M_courses.clear();
 }
@@ -216,6 +224,8 @@ StrictCheckPassGenerator::generate( const WorldModel & wm )
         return;
     }
 
+    AgentTable::instance().update( wm );
+
     updateReceivers( wm );
 
     if ( M_receiver_candidates.empty() )
@@ -384,32 +394,29 @@ StrictCheckPassGenerator::updateReceivers( const WorldModel & wm )
 
     const bool is_self_passer = ( M_passer->unum() == wm.self().unum() );
 
-    for ( AbstractPlayerObject::Cont::const_iterator p = wm.ourPlayers().begin(),
-              end = wm.ourPlayers().end();
-          p != end;
-          ++p )
+    const AgentTable::Players & teammates = AgentTable::i().teammates();
+
+    for ( int i = 0; i < teammates.size_; ++i )
     {
-        if ( *p == M_passer ) continue;
+        if ( teammates.player_[i] == M_passer ) continue;
 
         if ( is_self_passer )
         {
-            // if ( (*p)->isGhost() ) continue;
-            if ( (*p)->unum() == Unum_Unknown ) continue;
-            // if ( (*p)->unumCount() > 10 ) continue;
-            if ( (*p)->posCount() > 10 ) continue;
-            if ( (*p)->isTackling() ) continue;
-            if ( (*p)->pos().x > wm.offsideLineX() )
+            // if ( teammates.ghost_[i] ) continue;
+            if ( teammates.unum_[i] == Unum_Unknown ) continue;
+            if ( teammates.pos_count_[i] > 10 ) continue;
+            if ( teammates.tackling_[i] ) continue;
+            if ( teammates.x_[i] > wm.offsideLineX() )
             {
                 dlog.addText( Logger::PASS,
                               "(updateReceiver) unum=%d (%.2f %.2f) > offside=%.2f",
-                              (*p)->unum(),
-                              (*p)->pos().x, (*p)->pos().y,
+                              teammates.unum_[i],
+                              teammates.x_[i], teammates.y_[i],
                               wm.offsideLineX() );
                 continue;
             }
-            //if ( (*p)->isTackling() ) continue;
-            if ( (*p)->goalie()
-                 && (*p)->pos().x < SP.ourPenaltyAreaLineX() + 15.0 )
+            if ( teammates.goalie_[i]
+                 && teammates.x_[i] < SP.ourPenaltyAreaLineX() + 15.0 )
             {
                 continue;
             }
@@ -417,15 +424,15 @@ StrictCheckPassGenerator::updateReceivers( const WorldModel & wm )
         else
         {
             // ignore other players
-            if ( (*p)->unum() != wm.self().unum() )
+            if ( teammates.unum_[i] != wm.self().unum() )
             {
                 continue;
             }
         }
 
-        if ( (*p)->pos().dist2( M_first_point ) > max_dist2 ) continue;
+        if ( teammates.pos( i ).dist2( M_first_point ) > max_dist2 ) continue;
 
-        M_receiver_candidates.push_back( Receiver( *p, M_first_point ) );
+        M_receiver_candidates.push_back( Receiver( teammates, i, M_first_point ) );
     }
 
     std::sort( M_receiver_candidates.begin(),
@@ -461,16 +468,39 @@ StrictCheckPassGenerator::updateReceivers( const WorldModel & wm )
 
  */
 void
-StrictCheckPassGenerator::updateOpponents( const WorldModel & wm )
+StrictCheckPassGenerator::updateOpponents( const WorldModel & )
 {
-    for ( AbstractPlayerObject::Cont::const_iterator p = wm.theirPlayers().begin(),
-              end = wm.theirPlayers().end();
-          p != end;
-          ++p )
+    const ServerParam & SP = ServerParam::i();
+    const AgentTable::Players & opponents = AgentTable::i().opponents();
+
+    OpponentScreen & screen = M_opponent_screen;
+    screen.size_ = 0;
+
+    for ( int i = 0; i < opponents.size_; ++i )
     {
-        M_opponents.push_back( Opponent( *p ) );
-#ifdef DEBUG_UPDATE_OPPONENT
+        M_opponents.push_back( Opponent( opponents, i ) );
+
+        //
+        // predictOpponentReachStep() reduces the dash distance at most by
+        // the bonus distance, the control area and 0.5.
+        //
         const Opponent & o = M_opponents.back();
+        const PlayerType * ptype = opponents.ptype_[i];
+        const double control_area = ( opponents.goalie_[i]
+                                      ? std::max( SP.catchableArea(), ptype->kickableArea() )
+                                      : ptype->kickableArea() );
+        const int n = screen.size_++;
+        screen.x_[n] = static_cast< float >( o.pos_.x );
+        screen.y_[n] = static_cast< float >( o.pos_.y );
+        screen.vx_[n] = static_cast< float >( o.vel_.x );
+        screen.vy_[n] = static_cast< float >( o.vel_.y );
+        screen.decay_[n] = static_cast< float >( ptype->playerDecay() );
+        screen.speed_max_[n] = static_cast< float >( ptype->realSpeedMax() );
+        screen.pos_count_[n] = static_cast< float >( std::min( opponents.pos_count_[i], 5 ) );
+        screen.reach_buf_[n] = static_cast< float >( std::max( 0.0, o.bonus_distance_ )
+                                                     + control_area
+                                                     + 0.5 );
+#ifdef DEBUG_UPDATE_OPPONENT
         dlog.addText( Logger::PASS,
                       "StrictPass opp %d pos(%.1f %.1f) vel(%.2f %.2f) bonus_dist=%.3f",
                       o.player_->unum(),
@@ -1578,6 +1608,59 @@ StrictCheckPassGenerator::predictOpponentsReachStep( const WorldModel & wm,
 {
     const Vector2D first_ball_vel = Vector2D::polar2vector( first_ball_speed, ball_move_angle );
 
+    //
+    // float32 screening.
+    // an opponent that cannot cover the ball path even with the maximum
+    // reduction of the dash distance is never reached by the exact check.
+    //
+    bool screened[AgentTable::MAX_PLAYER];
+    const bool use_screen = ( max_cycle <= MAX_SCREEN_STEP
+                              && M_opponent_screen.size_ == static_cast< int >( M_opponents.size() ) );
+    if ( use_screen )
+    {
+        const OpponentScreen & screen = M_opponent_screen;
+
+        float ball_vx, ball_vy;
+        FastGeometry::polar( static_cast< float >( first_ball_speed ),
+                             static_cast< float >( ball_move_angle.degree() ),
+                             &ball_vx, &ball_vy );
+        float ball_x[MAX_SCREEN_STEP + 1];
+        float ball_y[MAX_SCREEN_STEP + 1];
+        FastGeometry::inertia_path( static_cast< float >( first_ball_pos.x ),
+                                    static_cast< float >( first_ball_pos.y ),
+                                    ball_vx, ball_vy,
+                                    static_cast< float >( ServerParam::i().ballDecay() ),
+                                    max_cycle,
+                                    ball_x, ball_y );
+
+        float dir_x, dir_y;
+        FastGeometry::sincos_deg( static_cast< float >( ball_move_angle.degree() ), &dir_y, &dir_x );
+
+        for ( int i = 0; i < screen.size_; ++i )
+        {
+            screened[i] = ! FastGeometry::may_reach_path( screen.x_[i], screen.y_[i],
+                                                          screen.vx_[i], screen.vy_[i],
+                                                          screen.decay_[i],
+                                                          screen.speed_max_[i],
+                                                          screen.pos_count_[i],
+                                                          screen.reach_buf_[i],
+                                                          ball_x, ball_y,
+                                                          dir_x, dir_y,
+                                                          max_cycle );
+        }
+    }
+
+#ifdef DEBUG_SCREEN_OPPONENT
+    static bool s_accuracy_checked = false;
+    if ( ! s_accuracy_checked )
+    {
+        s_accuracy_checked = true;
+        std::ostringstream os;
+        FastGeometry::check_accuracy( os );
+        dlog.addText( Logger::PASS, "%s", os.str().c_str() );
+    }
+#endif
+
     double bonus_dist = -10000.0;
     int min_step = 1000;
     const AbstractPlayerObject * fastest_opponent = static_cast< AbstractPlayerObject * >( 0 );
@@ -1586,13 +1669,29 @@ StrictCheckPassGenerator::predictOpponentsReachStep( const WorldModel & wm,
           o != M_opponents.end();
           ++o )
     {
-        int step = predictOpponentReachStep( wm,
+        const int index = static_cast< int >( o - M_opponents.begin() );
+        int step = 1000;
+        if ( ! use_screen
+             || ! screened[index] )
+        {
+            step = predictOpponentReachStep( wm,
                                              *o,
                                              first_ball_pos,
                                              first_ball_vel,
                                              ball_move_angle,
                                              receive_point,
                                              std::min( max_cycle, min_step ) );
+        }
+#ifdef DEBUG_SCREEN_OPPONENT
+        else if ( predictOpponentReachStep( wm, *o, first_ball_pos, first_ball_vel,
+                                            ball_move_angle, receive_point,
+                                            std::min( max_cycle, min_step ) ) < 1000 )
+        {
+            dlog.addText( Logger::PASS,
+                          "__ ERROR: opponent %d was screened out but can reach the ball",
+                          o->player_->unum() );
+        }
+#endif
         if ( step < min_step
              || ( step == min_step
                   && o->bonus_distance_ > bonus_dist ) )
@@ -33,6 +33,7 @@
 #define STRICT_CHECK_PASS_GENERATOR_H
 
 #include "cooperative_action.h"
+#include "agent_table.h"
 
 #include <rcsc/player/abstract_player_object.h>
 #include <rcsc/geom/vector_2d.h>
@@ -63,7 +64,8 @@ public:
     private:
         Receiver();
     public:
-        Receiver( const rcsc::AbstractPlayerObject * p,
+        Receiver( const AgentTable::Players & players,
+                  const int index,
                   const rcsc::Vector2D & first_ball_pos );
     };
 
@@ -78,12 +80,28 @@ public:
     private:
         Opponent();
     public:
-        explicit
-        Opponent( const rcsc::AbstractPlayerObject * p );
+        Opponent( const AgentTable::Players & players,
+                  const int index );
     };
 
     typedef std::vector< Opponent > OpponentCont;
 
+    /*!
+      \brief float32 copy of M_opponents for the screening of the opponents
+      in predictOpponentsReachStep(). the index is same as M_opponents.
+     */
+    struct OpponentScreen {
+        int size_;
+        float x_[AgentTable::MAX_PLAYER];
+        float y_[AgentTable::MAX_PLAYER];
+        float vx_[AgentTable::MAX_PLAYER];
+        float vy_[AgentTable::MAX_PLAYER];
+        float decay_[AgentTable::MAX_PLAYER];
+        float speed_max_[AgentTable::MAX_PLAYER];
+        float pos_count_[AgentTable::MAX_PLAYER]; //!< min( posCount, 5 )
+        float reach_buf_[AgentTable::MAX_PLAYER]; //!< the maximum reduction of the dash distance
+    };
+
 private:
 
     rcsc::GameTime M_update_time;
@@ -96,6 +114,7 @@ private:
 
     ReceiverCont M_receiver_candidates;
     OpponentCont M_opponents;
+    OpponentScreen M_opponent_screen;
 
     int M_direct_size;
     int M_leading_size;
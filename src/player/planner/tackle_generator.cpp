@@ -36,6 +36,7 @@
 #include "tackle_generator.h"
 
 #include "field_analyzer.h"
+#include "agent_table.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/common/logger.h>
@@ -635,12 +636,14 @@ TackleGenerator::predictOpponentsReachStep( const WorldModel & wm,
 #endif
 
     int min_step = first_min_step;
-    for ( AbstractPlayerObject::Cont::const_iterator o = wm.theirPlayers().begin(),
-              end = wm.theirPlayers().end();
-          o != end;
-          ++o )
+    AgentTable::instance().update( wm );
+
+    const AgentTable::Players & opponents = AgentTable::i().opponents();
+
+    for ( int i = 0; i < opponents.size_; ++i )
     {
-        int step = predictOpponentReachStep( *o,
+        int step = predictOpponentReachStep( opponents,
+                                             i,
                                              first_ball_pos,
                                              first_ball_vel,
                                              ball_move_angle,
@@ -662,7 +665,8 @@ TackleGenerator::predictOpponentsReachStep( const WorldModel & wm,
 
  */
 int
-TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent,
+TackleGenerator::predictOpponentReachStep( const AgentTable::Players & opponents,
+                                           const int index,
                                            const Vector2D & first_ball_pos,
                                            const Vector2D & first_ball_vel,
                                            const AngleDeg & ball_move_angle,
@@ -670,10 +674,11 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
 {
     const ServerParam & SP = ServerParam::i();
 
-    const PlayerType * ptype = opponent->playerTypePtr();
-    const double opponent_speed = opponent->vel().r();
+    const PlayerType * ptype = opponents.ptype_[index];
+    const Vector2D opponent_pos = opponents.pos( index );
+    const double opponent_speed = opponents.vel( index ).r();
 
-    int min_cycle = FieldAnalyzer::estimate_min_reach_cycle( opponent->pos(),
+    int min_cycle = FieldAnalyzer::estimate_min_reach_cycle( opponent_pos,
                                                              ptype->realSpeedMax(),
                                                              first_ball_pos,
                                                              ball_move_angle );
@@ -695,14 +700,14 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP
             dlog.addText( Logger::CLEAR,
                           "__ opponent=%d(%.1f %.1f) step=%d ball is out of pitch. ",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle  );
 #endif
             return 1000;
         }
 
-        Vector2D inertia_pos = opponent->inertiaPoint( cycle );
+        Vector2D inertia_pos = opponents.inertiaPoint( index, cycle );
         double target_dist = inertia_pos.dist( ball_pos );
 
         if ( target_dist - ptype->kickableArea() < 0.001 )
@@ -710,8 +715,8 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP
             dlog.addText( Logger::CLEAR,
                           "____ opponent=%d(%.1f %.1f) step=%d already there. dist=%.1f",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle,
                           target_dist );
 #endif
@@ -730,8 +735,8 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP_LEVEL2
             dlog.addText( Logger::CLEAR,
                           "______ opponent=%d(%.1f %.1f) cycle=%d dash_dist=%.1f reachable=%.1f",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle, dash_dist, ptype->realSpeedMax()*cycle );
 #endif
             continue;
@@ -748,8 +753,8 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP_LEVEL2
             dlog.addText( Logger::CLEAR,
                           "______ opponent=%d(%.1f %.1f) cycle=%d dash_dist=%.1f n_dash=%d",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle, dash_dist, n_dash );
 #endif
             continue;
@@ -758,10 +763,10 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
         //
         // turn
         //
-        int n_turn = ( opponent->bodyCount() > 1
+        int n_turn = ( opponents.body_count_[index] > 1
                        ? 0
                        : FieldAnalyzer::predict_player_turn_cycle( ptype,
-                                                                   opponent->body(),
+                                                                   AngleDeg( opponents.body_[index] ),
                                                                    opponent_speed,
                                                                    target_dist,
                                                                    ( ball_pos - inertia_pos ).th(),
@@ -771,20 +776,20 @@ TackleGenerator::predictOpponentReachStep( const AbstractPlayerObject * opponent
         int n_step = ( n_turn == 0
                        ? n_turn + n_dash
                        : n_turn + n_dash + 1 ); // 1 step penalty for observation delay
-        if ( opponent->isTackling() )
+        if ( opponents.tackling_[index] )
         {
             n_step += 5; // Magic Number
         }
 
-        n_step -= std::min( 3, opponent->posCount() );
+        n_step -= std::min( 3, opponents.pos_count_[index] );
 
         if ( n_step <= cycle )
         {
 #ifdef DEBUG_PREDICT_OPPONENT_REACH_STEP
             dlog.addText( Logger::CLEAR,
                           "____ opponent=%d(%.1f %.1f) step=%d(t:%d,d:%d) bpos=(%.2f %.2f) dist=%.2f dash_dist=%.2f",
-                          opponent->unum(),
-                          opponent->pos().x, opponent->pos().y,
+                          opponents.unum_[index],
+                          opponent_pos.x, opponent_pos.y,
                           cycle, n_turn, n_dash,
                           ball_pos.x, ball_pos.y,
                           target_dist,
@@ -32,6 +32,8 @@
 #ifndef TACKLE_GENERATOR_H
 #define TACKLE_GENERATOR_H
 
+#include "agent_table.h"
+
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
 
@@ -111,7 +113,8 @@ private:
                                    const rcsc::Vector2D & first_ball_pos,
                                    const rcsc::Vector2D & first_ball_vel,
                                    const rcsc::AngleDeg & ball_move_angle );
-    int predictOpponentReachStep( const rcsc::AbstractPlayerObject * opponent,
+    int predictOpponentReachStep( const AgentTable::Players & opponents,
+                                  const int index,
                                   const rcsc::Vector2D & first_ball_pos,
                                   const rcsc::Vector2D & first_ball_vel,
                                   const rcsc::AngleDeg & ball_move_angle,
@@ -36,6 +36,9 @@
 #include "sample_communication.h"
 
 #include "strategy.h"
+#include "packed_say_message.h"
+
+#include "basic_actions/information_value.h"
 
 #include <rcsc/formation/formation.h>
 #include <rcsc/player/player_agent.h>
@@ -127,27 +130,6 @@ struct AbstractPlayerXCmp {
       }
 };
 
-inline
-double
-distance_rate( const double & val,
-               const double & variance )
-{
-    return std::exp( - std::pow( val, 2 ) / ( 2.0 * std::pow( variance, 2 ) ) );
-
-}
-
-inline
-double
-distance_from_ball( const AbstractPlayerObject * p,
-                    const Vector2D & ball_pos,
-                    const double & x_rate,
-                    const double & y_rate )
-{
-    //return p->distFromBall();
-    return std::sqrt( std::pow( ( p->pos().x - ball_pos.x ) * x_rate, 2 )
-                      + std::pow( ( p->pos().y - ball_pos.y ) * y_rate, 2 ) ); // Magic Number
-}
-
 }
 
 /*-------------------------------------------------------------------*/
@@ -616,6 +598,8 @@ SampleCommunication::sayBallAndPlayers( PlayerAgent * agent )
 
     const AudioMemory & am = wm.audioMemory();
 
+    InformationValue::instance().update( wm );
+
     //
     // initialize object priority score with fixed value 1000
     //
@@ -723,50 +707,24 @@ SampleCommunication::sayBallAndPlayers( PlayerAgent * agent )
     //
     // players:
     //   1. set illegal value if player's uniform number has not been seen directry.
-    //   2. reduced the priority based on the distance from ball
+    //   2. weighted by the relevance from the information value model
     //
     {
-        const double variance = 30.0; // Magic Number
-        const double x_rate = 1.0; // Magic Number
-        const double y_rate = 0.5; // Magic Number
-
-        const int min_step = std::min( std::min( wm.interceptTable().opponentStep(),
-                                                 wm.interceptTable().teammateStep() ),
-                                       wm.interceptTable().selfStep() );
-
-        const Vector2D ball_pos = wm.ball().inertiaPoint( min_step );
+        const InformationValue & info = InformationValue::i();
 
-        for ( int unum = 1; unum <= 11; ++unum )
+        for ( int num = 1; num <= 22; ++num )
         {
+            const InformationValue::Entry * e = info.entry( num );
+            if ( ! e
+                 || e->player_->unumCount() >= 2 )
             {
-                const AbstractPlayerObject * t = wm.ourPlayer( unum );
-                if ( ! t
-                     || t->unumCount() >= 2 )
-                {
-                    objects[unum].score_ = -65535.0;
-                }
-                else
-                {
-                    double d = distance_from_ball( t, ball_pos, x_rate, y_rate );
-                    objects[unum].score_ *= distance_rate( d, variance );
-                    objects[unum].score_ *= std::pow( 0.3, t->unumCount() );
-                    objects[unum].player_ = t;
-                }
+                objects[num].score_ = -65535.0;
             }
+            else
             {
-                const AbstractPlayerObject * o = wm.theirPlayer( unum );
-                if ( ! o
-                     || o->unumCount() >= 2 )
-                {
-                    objects[unum + 11].score_ = -65535.0;
-                }
-                else
-                {
-                    double d = distance_from_ball( o, ball_pos, x_rate, y_rate );
-                    objects[unum + 11].score_ *= distance_rate( d, variance );
-                    objects[unum].score_ *= std::pow( 0.3, o->unumCount() );
-                    objects[unum + 11].player_ = o;
-                }
+                objects[num].score_ = InformationValue::say_value( *e, objects[num].score_ );
+                objects[num].score_ *= std::pow( 0.3, e->player_->unumCount() );
+                objects[num].player_ = e->player_;
             }
         }
     }
@@ -874,6 +832,23 @@ SampleCommunication::sayBallAndPlayers( PlayerAgent * agent )
                                                          agent->effector().queuedNextSelfBody() ) );
             updatePlayerSendTime( wm, wm.ourSide(), wm.self().unum() );
         }
+        else if ( available_len >= PackedSayMessage::slength( PackedSayCodec::BALL_PLAYER ) )
+        {
+            // the packed message still has room for self without the body angle
+            const Vector2D ball_pos = agent->effector().queuedNextBallPos();
+            const Vector2D self_pos = agent->effector().queuedNextSelfPos();
+            std::vector< double > values;
+            values.reserve( PackedSayCodec::BALL_VALUES + PackedSayCodec::PLAYER_VALUES );
+            values.push_back( ball_pos.x );
+            values.push_back( ball_pos.y );
+            values.push_back( ball_vel.x );
+            values.push_back( ball_vel.y );
+            values.push_back( wm.self().unum() );
+            values.push_back( self_pos.x );
+            values.push_back( self_pos.y );
+            agent->addSayMessage( new PackedSayMessage( PackedSayCodec::BALL_PLAYER, values ) );
+            updatePlayerSendTime( wm, wm.ourSide(), wm.self().unum() );
+        }
         else
         {
             agent->addSayMessage( new BallMessage( agent->effector().queuedNextBallPos(),
@@ -934,6 +909,34 @@ SampleCommunication::sayBallAndPlayers( PlayerAgent * agent )
                           p0->side() == wm.ourSide() ? 'T' : 'O', p0->unum() );
             return true;
         }
+
+        if ( available_len >= PackedSayMessage::slength( PackedSayCodec::BALL_PLAYER ) )
+        {
+            // shorter than BallPlayerMessage, but without the body angle
+            const AbstractPlayerObject * p0 = send_players[0].player_;
+            const Vector2D ball_pos = agent->effector().queuedNextBallPos();
+            const Vector2D player_pos = ( p0->unum() == wm.self().unum()
+                                          ? agent->effector().queuedNextSelfPos()
+                                          : p0->pos() + p0->vel() );
+            std::vector< double > values;
+            values.reserve( PackedSayCodec::BALL_VALUES + PackedSayCodec::PLAYER_VALUES );
+            values.push_back( ball_pos.x );
+            values.push_back( ball_pos.y );
+            values.push_back( ball_vel.x );
+            values.push_back( ball_vel.y );
+            values.push_back( send_players[0].number_ );
+            values.push_back( player_pos.x );
+            values.push_back( player_pos.y );
+            agent->addSayMessage( new PackedSayMessage( PackedSayCodec::BALL_PLAYER, values ) );
+
+            M_ball_send_time = wm.time();
+            updatePlayerSendTime( wm, p0->side(), p0->unum() );
+
+            dlog.addText( Logger::COMMUNICATION,
+                          __FILE__": (sayBallAndPlayers) say packed ball and player %d",
+                          send_players[0].number_ );
+            return true;
+        }
     }
 
     //
@@ -1019,6 +1022,32 @@ SampleCommunication::sayBallAndPlayers( PlayerAgent * agent )
         }
     }
 
+    if ( send_players.size() >= 3
+         && available_len >= PackedSayMessage::slength( PackedSayCodec::THREE_PLAYERS ) )
+    {
+        // three players fit in the length of a two players message.
+        std::vector< double > values;
+        values.reserve( 3 * PackedSayCodec::PLAYER_VALUES );
+        for ( int i = 0; i < 3; ++i )
+        {
+            const AbstractPlayerObject * p = send_players[i].player_;
+            const Vector2D pos = p->pos() + p->vel();
+            values.push_back( send_players[i].number_ );
+            values.push_back( pos.x );
+            values.push_back( pos.y );
+            updatePlayerSendTime( wm, p->side(), p->unum() );
+        }
+
+        agent->addSayMessage( new PackedSayMessage( PackedSayCodec::THREE_PLAYERS, values ) );
+
+        dlog.addText( Logger::COMMUNICATION,
+                      __FILE__": say packed three players %d %d %d",
+                      send_players[0].number_,
+                      send_players[1].number_,
+                      send_players[2].number_ );
+        return true;
+    }
+
     if ( send_players.size() >= 3
          && available_len >= ThreePlayerMessage::slength() )
     {
@@ -1044,6 +1073,31 @@ SampleCommunication::sayBallAndPlayers( PlayerAgent * agent )
         return true;
     }
 
+    if ( send_players.size() >= 2
+         && available_len >= PackedSayMessage::slength( PackedSayCodec::TWO_PLAYERS ) )
+    {
+        // same length as TwoPlayerMessage on a 0.2m grid
+        std::vector< double > values;
+        values.reserve( 2 * PackedSayCodec::PLAYER_VALUES );
+        for ( int i = 0; i < 2; ++i )
+        {
+            const AbstractPlayerObject * p = send_players[i].player_;
+            const Vector2D pos = p->pos() + p->vel();
+            values.push_back( send_players[i].number_ );
+            values.push_back( pos.x );
+            values.push_back( pos.y );
+            updatePlayerSendTime( wm, p->side(), p->unum() );
+        }
+
+        agent->addSayMessage( new PackedSayMessage( PackedSayCodec::TWO_PLAYERS, values ) );
+
+        dlog.addText( Logger::COMMUNICATION,
+                      __FILE__": say packed two players %d %d",
+                      send_players[0].number_,
+                      send_players[1].number_ );
+        return true;
+    }
+
     if ( send_players.size() >= 2
          && available_len >= TwoPlayerMessage::slength() )
     {
@@ -231,17 +231,10 @@ evaluate_state( const PredictState & state, const rcsc::WorldModel & wm )
 
 		if ( wm.ball().pos().x < 35.0 &&  state.ball().pos().x > 5.0 )
 		{
-                       VoronoiDiagram vd;
+                        // computed once per cycle and shared by all evaluated states
+                        const VoronoiDiagram & vd = FieldAnalyzer::i().opponentsVoronoiDiagram();
 
                         std::vector<Vector2D> vd_cont;
-                        for ( auto o = wm.opponentsFromSelf().begin();
-                                o != wm.opponentsFromSelf().end();
-                                ++o )
-                        {
-                                   vd.addPoint((*o)->pos());
-                        }
-
-                        vd.compute();
 
 
 			    double max_dist = -1000.0;
@@ -35,6 +35,9 @@
 
 #include "sample_freeform_message_parser.h"
 
+#include "coach_opponent_model.h"
+#include "opponent_model_codec.h"
+
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/player/world_model.h>
@@ -134,3 +137,63 @@ OpponentPlayerTypeMessageParser::parse( const char * msg )
 
     return n_read;
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+OpponentModelMessageParser::OpponentModelMessageParser( const WorldModel & world )
+    : FreeformMessageParser( "om" ),
+      M_world( world )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+OpponentModelMessageParser::parse( const char * msg )
+{
+    static_assert( OpponentModelCodec::VALUE_SIZE == CoachOpponentModel::VALUE_SIZE,
+                   "OpponentModelCodec does not match CoachOpponentModel::Value" );
+
+    char buf[16];
+    int n_read = 0;
+
+    std::memset( buf, 0, 16 );
+
+    if ( std::sscanf( msg, " ( om %15[^)] ) %n", buf, &n_read ) != 1 )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": could not read the message. [" << msg << "]"
+                  << std::endl;
+        return -1;
+    }
+
+    if ( std::strlen( buf ) != static_cast< size_t >( CoachOpponentModel::VALUE_SIZE ) )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": (OpponentModelMessageParser) illegal message [" << buf << "]"
+                  << std::endl;
+        return -1;
+    }
+
+    double values[CoachOpponentModel::VALUE_SIZE];
+
+    for ( int i = 0; i < CoachOpponentModel::VALUE_SIZE; ++i )
+    {
+        if ( ! OpponentModelCodec::decode( i, buf[i], &values[i] ) )
+        {
+            std::cerr << __FILE__ << ' ' << __LINE__
+                      << ": illegal character in the opponent model. char=" << buf[i]
+                      << std::endl;
+            return -1;
+        }
+    }
+
+    CoachOpponentModel::instance().setValues( M_world.time(), values );
+
+    return n_read;
+}
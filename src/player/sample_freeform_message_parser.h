@@ -63,4 +63,33 @@ public:
     int parse( const char * msg );
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \class OpponentModelMessageParser
+  \brief coach's opponent model message parser.
+  the value ranges must be the same as the coach's OpponentModelMessage.
+ */
+class OpponentModelMessageParser
+    : public rcsc::FreeformMessageParser {
+private:
+    //! reference to the world model instance
+    const rcsc::WorldModel & M_world;
+
+public:
+
+    /*!
+      \brief construct with world model
+      \param wm reference to the world model instance
+     */
+    OpponentModelMessageParser( const rcsc::WorldModel & wm );
+
+    /*!
+      \brief analyzes freeform message.
+      \retval bytes read if success
+      \retval 0 message ID is not match. other parser should be tried.
+      \retval -1 failed to parse
+    */
+    int parse( const char * msg );
+};
+
 #endif
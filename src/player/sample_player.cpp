@@ -32,8 +32,14 @@
 
 #include "strategy.h"
 #include "field_analyzer.h"
+#include "team_shared_memory.h"
+#include "keepaway_benchmark.h"
+#include "decision_telemetry.h"
+#include "thread_pool.h"
+#include "data_extractor/offensive_data_extractor.h"
 
 #include "action_chain_holder.h"
+#include "agent_table.h"
 #include "sample_field_evaluator.h"
 
 #include "soccer_role.h"
@@ -41,6 +47,7 @@
 #include "sample_communication.h"
 #include "keepaway_communication.h"
 #include "sample_freeform_message_parser.h"
+#include "packed_say_message.h"
 
 #include "bhv_penalty_kick.h"
 #include "bhv_set_play.h"
@@ -63,6 +70,7 @@
 #include "basic_actions/neck_turn_to_ball_or_scan.h"
 #include "basic_actions/view_synch.h"
 #include "basic_actions/kick_table.h"
+#include "basic_actions/information_value.h"
 
 #include <rcsc/formation/formation.h>
 #include <rcsc/player/intercept_table.h>
@@ -78,6 +86,7 @@
 
 #include <rcsc/param/param_map.h>
 #include <rcsc/param/cmd_line_parser.h>
+#include <rcsc/timer.h>
 
 #include <iostream>
 #include <sstream>
@@ -126,6 +135,7 @@ SamplePlayer::SamplePlayer()
     addSayMessageParser( new BallPlayerMessageParser( audio_memory ) );
     addSayMessageParser( new StaminaMessageParser( audio_memory ) );
     addSayMessageParser( new RecoveryMessageParser( audio_memory ) );
+    addSayMessageParser( new PackedSayMessageParser( audio_memory ) );
 
     // addSayMessageParser( new FreeMessageParser< 9 >( audio_memory ) );
     // addSayMessageParser( new FreeMessageParser< 8 >( audio_memory ) );
@@ -141,6 +151,7 @@ SamplePlayer::SamplePlayer()
     // set freeform message parser
     //
     addFreeformMessageParser( new OpponentPlayerTypeMessageParser( M_worldmodel ) );
+    addFreeformMessageParser( new OpponentModelMessageParser( M_worldmodel ) );
 
     //
     // set communication planner
@@ -154,7 +165,12 @@ SamplePlayer::SamplePlayer()
  */
 SamplePlayer::~SamplePlayer()
 {
-
+    if ( ThreadPool::i().workerSize() > 0 )
+    {
+        std::cerr << config().teamName() << ' ' << world().self().unum() << ": ";
+        ThreadPool::instance().printStatistics( std::cerr );
+    }
+    ThreadPool::instance().stop();
 }
 
 /*-------------------------------------------------------------------*/
@@ -175,6 +191,25 @@ SamplePlayer::initImpl( CmdLineParser & cmd_parser )
     param_map.add()
         ( "param-file", "", &param_file_path, "specified parameter file" );
 #endif
+    std::string team_shm_name;
+    std::string keepaway_benchmark_dir;
+    std::string data_extractor_dir;
+    std::string telemetry_dir;
+    bool speculative_planning = false;
+    int worker_threads = 0;
+    my_params.add()
+        ( "team-shm", "", &team_shm_name,
+          "share team level results with co-located teammates through the named shared memory segment. for local test matches only." )
+        ( "keepaway-benchmark-dir", "", &keepaway_benchmark_dir,
+          "write the planner load statistics of the keepaway benchmark into the directory." )
+        ( "data-extractor-dir", "", &data_extractor_dir,
+          "write the pass decisions for the unmark model training into the directory." )
+        ( "telemetry-dir", "", &telemetry_dir,
+          "write one planner record per decision cycle into the directory." )
+        ( "speculative-planning", "", rcsc::BoolSwitch( &speculative_planning ),
+          "reuse the action chain during a multi-kick action while the predicted ball state holds." )
+        ( "worker-threads", "", &worker_threads,
+          "the number of worker threads of the task pool. -1 decides it from the CPU affinity." );
 
     cmd_parser.parse( my_params );
 
@@ -196,6 +231,40 @@ SamplePlayer::initImpl( CmdLineParser & cmd_parser )
         return false;
     }
 
+    if ( ! team_shm_name.empty() )
+    {
+        TeamSharedMemory::instance().setName( team_shm_name );
+    }
+
+    if ( ! keepaway_benchmark_dir.empty() )
+    {
+        KeepawayBenchmark::instance().setResultDir( keepaway_benchmark_dir );
+    }
+
+    if ( ! telemetry_dir.empty() )
+    {
+        DecisionTelemetry::instance().setOutputDir( telemetry_dir );
+    }
+
+    ActionChainHolder::instance().setSpeculationEnabled( speculative_planning );
+
+    if ( worker_threads < 0 )
+    {
+        // 11 players and the coach share the CPUs of the host
+        worker_threads = ThreadPool::auto_thread_count( 12 );
+    }
+    if ( worker_threads > 0 )
+    {
+        ThreadPool::instance().start( worker_threads );
+        std::cerr << config().teamName() << ": worker threads=" << worker_threads << std::endl;
+    }
+
+    if ( ! data_extractor_dir.empty() )
+    {
+        OffensiveDataExtractor::active = true;
+        OffensiveDataExtractor::output_dir = data_extractor_dir;
+    }
+
     if ( ! Strategy::instance().read( config().configDir() ) )
     {
         std::cerr << "***ERROR*** Failed to read team strategy." << std::endl;
@@ -235,7 +304,11 @@ SamplePlayer::actionImpl()
     // update strategy and analyzer
     //
     Strategy::instance().update( world() );
+    AgentTable::instance().update( world() );
     FieldAnalyzer::instance().update( world() );
+    InformationValue::instance().update( world() );
+    KeepawayBenchmark::instance().update( world() );
+    DecisionTelemetry::instance().update( world() );
 
     //
     // prepare action chain
@@ -259,7 +332,15 @@ SamplePlayer::actionImpl()
     //
     // update action chain
     //
-    ActionChainHolder::instance().update( world() );
+    {
+        Timer timer;
+        ActionChainHolder::instance().update( world() );
+        const double msec = timer.elapsedReal();
+        KeepawayBenchmark::instance().addPlannerTime( world(), msec );
+        DecisionTelemetry::instance().setPlannerResult( ActionChainHolder::i().graph(),
+                                                        ActionChainHolder::i().graphReused(),
+                                                        msec );
+    }
 
 
     //
@@ -335,6 +416,12 @@ SamplePlayer::handleActionStart()
 void
 SamplePlayer::handleActionEnd()
 {
+    //
+    // the command of this cycle has been sent.
+    // keep the chain for the next cycle if the planned action continues.
+    //
+    ActionChainHolder::instance().prepareSpeculation( this );
+
     if ( world().self().posValid() )
     {
 #if 0
@@ -823,9 +910,9 @@ SamplePlayer::createActionGenerator() const
     //
     // direct pass
     //
-    // g->addGenerator( new ActGen_RangeActionChainLengthFilter
-    //                  ( new ActGen_DirectPass(),
-    //                    2, ActGen_RangeActionChainLengthFilter::MAX ) );
+    g->addGenerator( new ActGen_RangeActionChainLengthFilter
+                     ( new ActGen_DirectPass(),
+                       2, ActGen_RangeActionChainLengthFilter::MAX ) );
 
     //
     // short dribble
@@ -842,9 +929,9 @@ SamplePlayer::createActionGenerator() const
     //
     // simple dribble
     //
-    // g->addGenerator( new ActGen_RangeActionChainLengthFilter
-    //                  ( new ActGen_SimpleDribble(),
-    //                    2, ActGen_RangeActionChainLengthFilter::MAX ) );
+    g->addGenerator( new ActGen_RangeActionChainLengthFilter
+                     ( new ActGen_SimpleDribble(),
+                       2, ActGen_RangeActionChainLengthFilter::MAX ) );
 
     return ActionGenerator::ConstPtr( g );
 }
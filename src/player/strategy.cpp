@@ -42,6 +42,8 @@
 #include "strategy.h"
 
 #include "soccer_role.h"
+#include "team_shared_memory.h"
+#include "field_analyzer.h"
 
 
 #ifndef USE_GENERIC_FACTORY
@@ -72,6 +74,7 @@
 #include <rcsc/game_mode.h>
 
 #include <iostream>
+#include <set>
 
 using namespace rcsc;
 
@@ -120,7 +123,8 @@ struct MyCompare {
 
  */
 Strategy::Strategy()
-    : M_goalie_unum( Unum_Unknown ),
+    : M_formation_hot_reload( false ),
+      M_goalie_unum( Unum_Unknown ),
       M_current_situation( Normal_Situation ),
       M_role_number( 11, 0 ),
       M_position_types( 11, Position_Center ),
@@ -180,6 +184,10 @@ Strategy::init( CmdLineParser & cmd_parser )
     //param_map.add()
     //    ( "fconf", "", &fconf, "another formation file." );
 
+    param_map.add()
+        ( "formation-hot-reload", "", BoolSwitch( &M_formation_hot_reload ),
+          "reload modified formation files during set plays." );
+
     //
     //
     //
@@ -215,136 +223,140 @@ Strategy::read( const std::string & formation_dir )
         return false;
     }
 
-    std::string configpath = formation_dir;
-    if ( ! configpath.empty()
-         && configpath[ configpath.length() - 1 ] != '/' )
+    M_formation_dir = formation_dir;
+    if ( ! M_formation_dir.empty()
+         && M_formation_dir[ M_formation_dir.length() - 1 ] != '/' )
     {
-        configpath += '/';
+        M_formation_dir += '/';
     }
 
-    // before kick off
-    M_before_kick_off_formation = createFormation( configpath + BEFORE_KICK_OFF_CONF );
-    if ( ! M_before_kick_off_formation )
+    if ( ! M_formation_manifest.read( M_formation_dir + FormationManifest::FILE_NAME ) )
     {
-        std::cerr << "Failed to read before_kick_off formation" << std::endl;
+        std::cerr << "Failed to read the formation manifest in "
+                  << M_formation_dir << std::endl;
         return false;
     }
-    M_after_goal_formation = createFormation( configpath + AFTER_GOAL_FORMATION_CONF );  
-    if ( ! M_after_goal_formation )  
-    {  
-        std::cerr << "Failed to read after goal formation" << std::endl;  
-        return false;  
-    }
-
-    // Cargar formaciones para secuencia de taunts R → T
-    M_after_goal_r_left_formation = createFormation( configpath + AFTER_GOAL_FORMATION_CONF_Left );
-    if ( ! M_after_goal_r_left_formation )
-    {
-        std::cerr << "Failed to read after-goal R LEFT formation from " << configpath + AFTER_GOAL_FORMATION_CONF_Left << std::endl;
-    }
-
-    M_after_goal_r_right_formation = createFormation( configpath + AFTER_GOAL_FORMATION_CONF_Right );
-    if ( ! M_after_goal_r_right_formation )
-    {
-        std::cerr << "Failed to read after-goal R RIGHT formation from " << configpath + AFTER_GOAL_FORMATION_CONF_Right << std::endl;
-    }
-
-    M_after_goal_t_left_formation = createFormation( configpath + AFTER_GOAL_FORMATION_CONF_T_Left );
-    if ( ! M_after_goal_t_left_formation )
-    {
-        std::cerr << "Failed to read after-goal T LEFT formation from " << configpath + AFTER_GOAL_FORMATION_CONF_T_Left << std::endl;
-    }
-
-    M_after_goal_t_right_formation = createFormation( configpath + AFTER_GOAL_FORMATION_CONF_T_Right );
-    if ( ! M_after_goal_t_right_formation )
-    {
-        std::cerr << "Failed to read after-goal T RIGHT formation from " << configpath + AFTER_GOAL_FORMATION_CONF_T_Right << std::endl;
-    }
 
-    ///////////////////////////////////////////////////////////
-    M_normal_formation = createFormation( configpath + NORMAL_FORMATION_CONF );
-    if ( ! M_normal_formation )
+    for ( const FormationSlot & slot : formation_slots() )
     {
-        std::cerr << "Failed to read normal formation" << std::endl;
-        return false;
-    }
+        const std::string filepath
+            = M_formation_dir + M_formation_manifest.fileName( slot.key_, *slot.default_name_ );
 
-    M_defense_formation = createFormation( configpath + DEFENSE_FORMATION_CONF );
-    if ( ! M_defense_formation )
-    {
-        std::cerr << "Failed to read defense formation" << std::endl;
-        return false;
+        this->*slot.formation_ = createFormation( filepath );
+        if ( ! ( this->*slot.formation_ ) )
+        {
+            std::cerr << "Failed to read " << slot.key_ << " formation from "
+                      << filepath << std::endl;
+            if ( slot.required_ )
+            {
+                return false;
+            }
+        }
     }
 
-    M_offense_formation = createFormation( configpath + OFFENSE_FORMATION_CONF );
-    if ( ! M_offense_formation )
+    if ( M_formation_hot_reload )
     {
-        std::cerr << "Failed to read offense formation" << std::endl;
-        return false;
+        if ( M_formation_watcher.open( M_formation_dir ) )
+        {
+            std::cerr << "Formation hot reload enabled: [" << M_formation_dir << ']'
+                      << std::endl;
+        }
     }
 
-    M_goal_kick_opp_formation = createFormation( configpath + GOAL_KICK_OPP_FORMATION_CONF );
-    if ( ! M_goal_kick_opp_formation )
-    {
-        return false;
-    }
+    s_initialized = true;
+    return true;
+}
 
-    M_goal_kick_our_formation = createFormation( configpath + GOAL_KICK_OUR_FORMATION_CONF );
-    if ( ! M_goal_kick_our_formation )
-    {
-        return false;
-    }
+/*-------------------------------------------------------------------*/
+/*!
+  formation keys in the loading order.
+  the first formation determines the goalie's uniform number.
+ */
+const std::vector< Strategy::FormationSlot > &
+Strategy::formation_slots()
+{
+    static const std::vector< FormationSlot > s_slots = {
+        { "before_kick_off", &BEFORE_KICK_OFF_CONF, &Strategy::M_before_kick_off_formation, true },
+        { "after_goal", &AFTER_GOAL_FORMATION_CONF, &Strategy::M_after_goal_formation, true },
+        // taunt sequence R -> T. optional.
+        { "after_goal_r_left", &AFTER_GOAL_FORMATION_CONF_Left, &Strategy::M_after_goal_r_left_formation, false },
+        { "after_goal_r_right", &AFTER_GOAL_FORMATION_CONF_Right, &Strategy::M_after_goal_r_right_formation, false },
+        { "after_goal_t_left", &AFTER_GOAL_FORMATION_CONF_T_Left, &Strategy::M_after_goal_t_left_formation, false },
+        { "after_goal_t_right", &AFTER_GOAL_FORMATION_CONF_T_Right, &Strategy::M_after_goal_t_right_formation, false },
+        { "normal", &NORMAL_FORMATION_CONF, &Strategy::M_normal_formation, true },
+        { "defense", &DEFENSE_FORMATION_CONF, &Strategy::M_defense_formation, true },
+        { "offense", &OFFENSE_FORMATION_CONF, &Strategy::M_offense_formation, true },
+        { "goal_kick_opp", &GOAL_KICK_OPP_FORMATION_CONF, &Strategy::M_goal_kick_opp_formation, true },
+        { "goal_kick_our", &GOAL_KICK_OUR_FORMATION_CONF, &Strategy::M_goal_kick_our_formation, true },
+        { "goalie_catch_opp", &GOALIE_CATCH_OPP_FORMATION_CONF, &Strategy::M_goalie_catch_opp_formation, true },
+        { "goalie_catch_our", &GOALIE_CATCH_OUR_FORMATION_CONF, &Strategy::M_goalie_catch_our_formation, true },
+        { "kickin_our", &KICKIN_OUR_FORMATION_CONF, &Strategy::M_kickin_our_formation, true },
+        { "setplay_opp", &SETPLAY_OPP_FORMATION_CONF, &Strategy::M_setplay_opp_formation, true },
+        { "setplay_our", &SETPLAY_OUR_FORMATION_CONF, &Strategy::M_setplay_our_formation, true },
+        { "indirect_freekick_opp", &INDIRECT_FREEKICK_OPP_FORMATION_CONF, &Strategy::M_indirect_freekick_opp_formation, true },
+        { "indirect_freekick_our", &INDIRECT_FREEKICK_OUR_FORMATION_CONF, &Strategy::M_indirect_freekick_our_formation, true },
+    };
+
+    return s_slots;
+}
 
-    M_goalie_catch_opp_formation = createFormation( configpath + GOALIE_CATCH_OPP_FORMATION_CONF );
-    if ( ! M_goalie_catch_opp_formation )
-    {
-        return false;
-    }
+/*-------------------------------------------------------------------*/
+/*!
 
-    M_goalie_catch_our_formation = createFormation( configpath + GOALIE_CATCH_OUR_FORMATION_CONF );
-    if ( ! M_goalie_catch_our_formation )
+ */
+void
+Strategy::reloadFormations( const WorldModel & wm )
+{
+    std::set< std::string > changed_files;
+    if ( ! M_formation_watcher.poll( changed_files ) )
     {
-        return false;
+        return;
     }
 
-    M_kickin_our_formation = createFormation( configpath + KICKIN_OUR_FORMATION_CONF );
-    if ( ! M_kickin_our_formation )
+    bool reload_all = false;
+    if ( changed_files.count( FormationManifest::FILE_NAME ) > 0 )
     {
-        std::cerr << "Failed to read kickin our formation" << std::endl;
-        return false;
+        FormationManifest manifest;
+        if ( manifest.read( M_formation_dir + FormationManifest::FILE_NAME ) )
+        {
+            M_formation_manifest = manifest;
+            reload_all = true;
+        }
+        else
+        {
+            std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+                      << wm.time()
+                      << " (reloadFormations) illegal manifest. keep the current formations."
+                      << std::endl;
+        }
     }
 
-    M_setplay_opp_formation = createFormation( configpath + SETPLAY_OPP_FORMATION_CONF );
-    if ( ! M_setplay_opp_formation )
+    for ( const FormationSlot & slot : formation_slots() )
     {
-        std::cerr << "Failed to read setplay opp formation" << std::endl;
-        return false;
-    }
+        const std::string & file_name = M_formation_manifest.fileName( slot.key_, *slot.default_name_ );
+        if ( ! reload_all
+             && changed_files.count( file_name ) == 0 )
+        {
+            continue;
+        }
 
-    M_setplay_our_formation = createFormation( configpath + SETPLAY_OUR_FORMATION_CONF );
-    if ( ! M_setplay_our_formation )
-    {
-        std::cerr << "Failed to read setplay our formation" << std::endl;
-        return false;
-    }
+        Formation::Ptr f = createFormation( M_formation_dir + file_name );
+        if ( ! f )
+        {
+            // keep the current formation. the file may be rewritten again.
+            continue;
+        }
 
-    M_indirect_freekick_opp_formation = createFormation( configpath + INDIRECT_FREEKICK_OPP_FORMATION_CONF );
-    if ( ! M_indirect_freekick_opp_formation )
-    {
-        std::cerr << "Failed to read indirect freekick opp formation" << std::endl;
-        return false;
-    }
+        this->*slot.formation_ = f;
 
-    M_indirect_freekick_our_formation = createFormation( configpath + INDIRECT_FREEKICK_OUR_FORMATION_CONF );
-    if ( ! M_indirect_freekick_our_formation )
-    {
-        std::cerr << "Failed to read indirect freekick our formation" << std::endl;
-        return false;
+        std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+                  << wm.time()
+                  << " reloaded " << slot.key_ << " formation [" << file_name << ']'
+                  << std::endl;
+        dlog.addText( Logger::TEAM,
+                      __FILE__":(reloadFormations) %s <- %s",
+                      slot.key_, file_name.c_str() );
     }
-
-
-    s_initialized = true;
-    return true;
 }
 
 /*-------------------------------------------------------------------*/
@@ -431,6 +443,35 @@ Strategy::update( const WorldModel & wm )
     }
     s_update_time = wm.time();
 
+    // formations are swapped only between set plays
+    if ( M_formation_watcher.isOpen()
+         && wm.gameMode().type() != GameMode::PlayOn )
+    {
+        reloadFormations( wm );
+    }
+
+    if ( wm.gameMode().type() == GameMode::PlayOn
+         && TeamSharedMemory::instance().enabled() )
+    {
+        // reuse the result computed by another co-located teammate process
+        if ( TeamSharedMemory::instance().fetchStrategy( wm,
+                                                         &M_current_situation,
+                                                         M_positions,
+                                                         M_position_types ) )
+        {
+            return;
+        }
+
+        updateSituation( wm );
+        updatePosition( wm );
+
+        TeamSharedMemory::instance().publishStrategy( wm,
+                                                      M_current_situation,
+                                                      M_positions,
+                                                      M_position_types );
+        return;
+    }
+
     updateSituation( wm );
     updatePosition( wm );
 }
@@ -720,7 +761,6 @@ Strategy::updatePosition( const WorldModel & wm )
     // G2d: Voronoi diagram
 			bool newvel = false;
 
-                        VoronoiDiagram vd;
                         // const ServerParam & SP = ServerParam::i();
 
                         std::vector<Vector2D> vd_cont;
@@ -755,23 +795,36 @@ Strategy::updatePosition( const WorldModel & wm )
                                 y2.x = y2.x - 4.0;
                         }
 
+                        // the opponent only diagram is shared with the field evaluator.
+                        // a separate diagram is built only when extra sites are needed.
+                        FieldAnalyzer::instance().update( wm );
+
+                        const VoronoiDiagram * shared_vd = &FieldAnalyzer::i().opponentsVoronoiDiagram();
+                        VoronoiDiagram offside_vd;
+
+                        if (newvel || y1.x < 37.0)
+                        {
                         for ( auto o = wm.opponentsFromSelf().begin();
                                 o != wm.opponentsFromSelf().end();
                                 ++o )
                         {
                                 if (newvel)
-                                           vd.addPoint((*o)->pos() + (*o)->vel());
+                                           offside_vd.addPoint((*o)->pos() + (*o)->vel());
                                 else
-                                           vd.addPoint((*o)->pos());
+                                           offside_vd.addPoint((*o)->pos());
                         }
 
                         if (y1.x < 37.0)
                         {
-                                   vd.addPoint(y1);
-                                   vd.addPoint(y2);
+                                   offside_vd.addPoint(y1);
+                                   offside_vd.addPoint(y2);
+                        }
+
+                                offside_vd.compute();
+                                shared_vd = &offside_vd;
                         }
 
-                                vd.compute();
+                        const VoronoiDiagram & vd = *shared_vd;
 
 
                         Line2D offsideLine (y1, y2);
@@ -33,6 +33,7 @@
 #define STRATEGY_H
 
 #include "soccer_role.h"
+#include "formation_manifest.h"
 
 #include <rcsc/formation/formation.h>
 #include <rcsc/geom/vector_2d.h>
@@ -139,6 +140,12 @@ private:
 
 
 
+    // formation files
+    std::string M_formation_dir;
+    FormationManifest M_formation_manifest;
+    bool M_formation_hot_reload;
+    FormationWatcher M_formation_watcher;
+
     int M_goalie_unum;
 
 
@@ -152,6 +159,14 @@ private:
     std::vector< PositionType > M_position_types;
     std::vector< rcsc::Vector2D > M_positions;
 
+    //! formation member bound to a manifest key
+    struct FormationSlot {
+        const char * key_;
+        const std::string * default_name_;
+        rcsc::Formation::Ptr Strategy::*formation_;
+        bool required_;
+    };
+
     // private for singleton
     Strategy();
 
@@ -216,6 +231,12 @@ private:
 
     rcsc::Formation::Ptr createFormation( const std::string & filepath );
 
+    static
+    const std::vector< FormationSlot > & formation_slots();
+
+    // reload the formations modified after the last call
+    void reloadFormations( const rcsc::WorldModel & wm );
+
     rcsc::Formation::Ptr getFormation( const rcsc::WorldModel & wm ) const;
 
 public:
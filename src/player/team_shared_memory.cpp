@@ -0,0 +1,685 @@
+// -*-c++-*-
+
+/*!
+  \file team_shared_memory.cpp
+  \brief shared memory exchange of team level results Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "team_shared_memory.h"
+
+#include <rcsc/player/world_model.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/common/logger.h>
+#include <rcsc/game_mode.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+using namespace rcsc;
+
+static_assert( ATOMIC_INT_LOCK_FREE == 2,
+               "lock free atomic int is required for the shared segment." );
+
+namespace {
+
+//! increment when the segment layout is changed
+const std::uint32_t SEGMENT_VERSION = 3;
+
+//! published results older than this are ignored [ns]
+const std::int64_t MAX_AGE_NS = 500 * 1000 * 1000;
+
+//! allowed difference of the ball estimates
+const double BALL_DIST_THR = 0.5;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief identifies the situation in which a result was computed.
+ */
+struct SharedKey {
+    std::int64_t stamp_ns_; //!< CLOCK_MONOTONIC is shared by all processes
+    std::int32_t cycle_;
+    std::int32_t stopped_;
+    std::int32_t game_mode_;
+    std::int32_t publisher_;
+    double ball_x_;
+    double ball_y_;
+};
+
+struct StrategyPayload {
+    std::int32_t situation_;
+    std::int32_t position_type_[TeamSharedMemory::MAX_SLOT];
+    double pos_x_[TeamSharedMemory::MAX_SLOT];
+    double pos_y_[TeamSharedMemory::MAX_SLOT];
+};
+
+struct BlockPayload {
+    std::int32_t blocker_unum_;
+    double x_;
+    double y_;
+};
+
+struct PasserTreePayload {
+    std::int32_t holder_;
+    std::int32_t size_;
+    std::int32_t sender_[TeamSharedMemory::MAX_PASS];
+    std::int32_t receiver_[TeamSharedMemory::MAX_PASS];
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief single writer slot protected by a sequence lock.
+  odd sequence number means that the writer is updating the slot.
+ */
+template < typename Payload >
+struct SharedSlot {
+    std::atomic< std::uint32_t > seq_;
+    SharedKey key_;
+    Payload data_;
+};
+
+/*-------------------------------------------------------------------*/
+std::int64_t
+monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return static_cast< std::int64_t >( ts.tv_sec ) * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+/*-------------------------------------------------------------------*/
+SharedKey
+create_key( const WorldModel & wm,
+            const Vector2D & ball_point )
+{
+    SharedKey key;
+    key.stamp_ns_ = monotonic_ns();
+    key.cycle_ = wm.time().cycle();
+    key.stopped_ = wm.time().stopped();
+    key.game_mode_ = static_cast< std::int32_t >( wm.gameMode().type() );
+    key.publisher_ = wm.self().unum();
+    key.ball_x_ = ball_point.x;
+    key.ball_y_ = ball_point.y;
+    return key;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+is_consistent( const SharedKey & mine,
+               const SharedKey & other )
+{
+    if ( other.cycle_ != mine.cycle_
+         || other.stopped_ != mine.stopped_
+         || other.game_mode_ != mine.game_mode_ )
+    {
+        return false;
+    }
+
+    // a result left by the previous match can have the same game time
+    if ( mine.stamp_ns_ - other.stamp_ns_ > MAX_AGE_NS )
+    {
+        return false;
+    }
+
+    const double dx = other.ball_x_ - mine.ball_x_;
+    const double dy = other.ball_y_ - mine.ball_y_;
+    return dx * dx + dy * dy < BALL_DIST_THR * BALL_DIST_THR;
+}
+
+/*-------------------------------------------------------------------*/
+template < typename Payload >
+void
+write_slot( SharedSlot< Payload > & slot,
+            const SharedKey & key,
+            const Payload & data )
+{
+    const std::uint32_t seq = slot.seq_.load( std::memory_order_relaxed );
+    slot.seq_.store( seq + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    std::memcpy( &slot.key_, &key, sizeof( SharedKey ) );
+    std::memcpy( &slot.data_, &data, sizeof( Payload ) );
+
+    slot.seq_.store( seq + 2, std::memory_order_release );
+}
+
+/*-------------------------------------------------------------------*/
+template < typename Payload >
+bool
+read_slot( const SharedSlot< Payload > & slot,
+           SharedKey * key,
+           Payload * data )
+{
+    const std::uint32_t seq0 = slot.seq_.load( std::memory_order_acquire );
+    if ( seq0 == 0 // never written
+         || ( seq0 & 1 ) != 0 ) // being written
+    {
+        return false;
+    }
+
+    std::memcpy( key, &slot.key_, sizeof( SharedKey ) );
+    std::memcpy( data, &slot.data_, sizeof( Payload ) );
+
+    std::atomic_thread_fence( std::memory_order_acquire );
+    return slot.seq_.load( std::memory_order_relaxed ) == seq0;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+process_alive( const std::int32_t pid )
+{
+    return pid > 0
+        && ( kill( pid, 0 ) == 0 || errno == EPERM );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief remove the name only if it still refers to the opened segment.
+  another process may already have replaced a stale segment.
+ */
+void
+unlink_if_same( const std::string & name,
+                const int fd )
+{
+    struct stat opened;
+    if ( fstat( fd, &opened ) != 0 )
+    {
+        return;
+    }
+
+    const int current_fd = shm_open( name.c_str(), O_RDONLY, 0 );
+    if ( current_fd < 0 )
+    {
+        return;
+    }
+
+    struct stat current;
+    const bool same = ( fstat( current_fd, &current ) == 0
+                        && current.st_dev == opened.st_dev
+                        && current.st_ino == opened.st_ino );
+    ::close( current_fd );
+
+    if ( same )
+    {
+        shm_unlink( name.c_str() );
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief memory layout of the shared segment.
+ */
+struct TeamSharedSegment {
+    std::atomic< std::uint32_t > version_; //!< must be the first member in all versions
+    std::atomic< std::int32_t > owner_pid_[TeamSharedMemory::MAX_SLOT];
+    SharedSlot< StrategyPayload > strategy_[TeamSharedMemory::MAX_SLOT];
+    SharedSlot< BlockPayload > block_[TeamSharedMemory::MAX_SLOT];
+    SharedSlot< PasserTreePayload > passer_tree_[TeamSharedMemory::MAX_SLOT];
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TeamSharedMemory::TeamSharedMemory()
+    : M_fd( -1 ),
+      M_segment( nullptr ),
+      M_slot( -1 ),
+      M_reuse_count( 0 ),
+      M_publish_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TeamSharedMemory::~TeamSharedMemory()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TeamSharedMemory &
+TeamSharedMemory::instance()
+{
+    static TeamSharedMemory s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TeamSharedMemory::open( const WorldModel & wm )
+{
+    if ( M_segment )
+    {
+        return true;
+    }
+
+    if ( M_base_name.empty()
+         || wm.ourSide() == NEUTRAL
+         || wm.self().unum() < 1
+         || MAX_SLOT < wm.self().unum() )
+    {
+        return false;
+    }
+
+    // both teams of a self-play match share the base name
+    M_name = '/' + M_base_name + ( wm.ourSide() == LEFT ? "-l" : "-r" );
+    for ( std::string::size_type i = 1; i < M_name.length(); ++i )
+    {
+        if ( M_name[i] == '/' ) M_name[i] = '_';
+    }
+
+    int result = attach( wm );
+    if ( result == 0 )
+    {
+        // a segment left by an older build. replace it by a new one.
+        std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+                  << "(TeamSharedMemory::open) recreate incompatible segment ["
+                  << M_name << ']' << std::endl;
+        unlink_if_same( M_name, M_fd );
+        detach();
+        result = attach( wm );
+    }
+
+    if ( result <= 0 )
+    {
+        detach();
+        M_base_name.clear();
+        return false;
+    }
+
+    M_slot = wm.self().unum() - 1;
+    M_segment->owner_pid_[M_slot].store( static_cast< std::int32_t >( getpid() ) );
+
+    std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+              << "shared team memory [" << M_name << "]" << std::endl;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \return 1 if attached, 0 if the existing segment has another version,
+  -1 if failed.
+ */
+int
+TeamSharedMemory::attach( const WorldModel & wm )
+{
+    M_fd = shm_open( M_name.c_str(), O_RDWR | O_CREAT, 0600 );
+    if ( M_fd < 0
+         || ftruncate( M_fd, sizeof( TeamSharedSegment ) ) != 0 )
+    {
+        std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+                  << "(TeamSharedMemory::open) could not open [" << M_name << "]: "
+                  << std::strerror( errno ) << std::endl;
+        return -1;
+    }
+
+    void * ptr = mmap( nullptr, sizeof( TeamSharedSegment ),
+                       PROT_READ | PROT_WRITE, MAP_SHARED, M_fd, 0 );
+    if ( ptr == MAP_FAILED )
+    {
+        std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+                  << "(TeamSharedMemory::open) mmap failed: "
+                  << std::strerror( errno ) << std::endl;
+        return -1;
+    }
+
+    // the new segment is zero filled.
+    M_segment = static_cast< TeamSharedSegment * >( ptr );
+
+    std::uint32_t version = 0;
+    if ( ! M_segment->version_.compare_exchange_strong( version, SEGMENT_VERSION )
+         && version != SEGMENT_VERSION )
+    {
+        std::cerr << wm.teamName() << ':' << wm.self().unum() << ": "
+                  << "(TeamSharedMemory::open) incompatible segment [" << M_name
+                  << "] version=" << version << std::endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamSharedMemory::detach()
+{
+    if ( M_segment )
+    {
+        munmap( M_segment, sizeof( TeamSharedSegment ) );
+        M_segment = nullptr;
+    }
+
+    if ( M_fd >= 0 )
+    {
+        ::close( M_fd );
+        M_fd = -1;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamSharedMemory::close()
+{
+    if ( M_segment
+         && M_slot >= 0 )
+    {
+        M_segment->owner_pid_[M_slot].store( 0 );
+        M_slot = -1;
+
+        // the pids of crashed processes are left in the table
+        bool in_use = false;
+        for ( int i = 0; i < MAX_SLOT; ++i )
+        {
+            if ( process_alive( M_segment->owner_pid_[i].load() ) )
+            {
+                in_use = true;
+                break;
+            }
+        }
+
+        if ( ! in_use )
+        {
+            unlink_if_same( M_name, M_fd );
+        }
+
+        std::cerr << "(TeamSharedMemory) reused=" << M_reuse_count
+                  << " published=" << M_publish_count
+                  << ( in_use ? "" : " removed" ) << std::endl;
+    }
+
+    detach();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamSharedMemory::publishStrategy( const WorldModel & wm,
+                                   const SituationType situation,
+                                   const std::vector< Vector2D > & positions,
+                                   const std::vector< PositionType > & position_types )
+{
+    if ( ! open( wm )
+         || positions.size() != static_cast< size_t >( MAX_SLOT )
+         || position_types.size() != static_cast< size_t >( MAX_SLOT ) )
+    {
+        return;
+    }
+
+    StrategyPayload data;
+    data.situation_ = static_cast< std::int32_t >( situation );
+    for ( int i = 0; i < MAX_SLOT; ++i )
+    {
+        data.position_type_[i] = static_cast< std::int32_t >( position_types[i] );
+        data.pos_x_[i] = positions[i].x;
+        data.pos_y_[i] = positions[i].y;
+    }
+
+    write_slot( M_segment->strategy_[wm.self().unum() - 1],
+                create_key( wm, wm.ball().pos() ),
+                data );
+    ++M_publish_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TeamSharedMemory::fetchStrategy( const WorldModel & wm,
+                                 SituationType * situation,
+                                 std::vector< Vector2D > & positions,
+                                 std::vector< PositionType > & position_types )
+{
+    if ( ! open( wm ) )
+    {
+        return false;
+    }
+
+    const SharedKey mine = create_key( wm, wm.ball().pos() );
+
+    for ( int i = 0; i < MAX_SLOT; ++i )
+    {
+        if ( i == wm.self().unum() - 1 )
+        {
+            continue;
+        }
+
+        SharedKey key;
+        StrategyPayload data;
+        if ( ! read_slot( M_segment->strategy_[i], &key, &data )
+             || ! is_consistent( mine, key ) )
+        {
+            continue;
+        }
+
+        *situation = static_cast< SituationType >( data.situation_ );
+        positions.resize( MAX_SLOT );
+        position_types.resize( MAX_SLOT );
+        for ( int j = 0; j < MAX_SLOT; ++j )
+        {
+            positions[j].assign( data.pos_x_[j], data.pos_y_[j] );
+            position_types[j] = static_cast< PositionType >( data.position_type_[j] );
+        }
+
+        ++M_reuse_count;
+        dlog.addText( Logger::TEAM,
+                      __FILE__":(fetchStrategy) reuse the result of %d",
+                      key.publisher_ );
+        return true;
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamSharedMemory::publishBlock( const WorldModel & wm,
+                                const int blocker_unum,
+                                const Vector2D & block_point )
+{
+    if ( ! open( wm ) )
+    {
+        return;
+    }
+
+    const int opp_min = wm.interceptTable().opponentStep();
+
+    BlockPayload data;
+    data.blocker_unum_ = blocker_unum;
+    data.x_ = block_point.x;
+    data.y_ = block_point.y;
+
+    write_slot( M_segment->block_[wm.self().unum() - 1],
+                create_key( wm, wm.ball().inertiaPoint( opp_min ) ),
+                data );
+    ++M_publish_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TeamSharedMemory::fetchBlock( const WorldModel & wm,
+                              int * blocker_unum,
+                              Vector2D * block_point )
+{
+    if ( ! open( wm ) )
+    {
+        return false;
+    }
+
+    const int opp_min = wm.interceptTable().opponentStep();
+    const SharedKey mine = create_key( wm, wm.ball().inertiaPoint( opp_min ) );
+
+    for ( int i = 0; i < MAX_SLOT; ++i )
+    {
+        if ( i == wm.self().unum() - 1 )
+        {
+            continue;
+        }
+
+        SharedKey key;
+        BlockPayload data;
+        if ( ! read_slot( M_segment->block_[i], &key, &data )
+             || ! is_consistent( mine, key ) )
+        {
+            continue;
+        }
+
+        *blocker_unum = data.blocker_unum_;
+        block_point->assign( data.x_, data.y_ );
+
+        ++M_reuse_count;
+        dlog.addText( Logger::BLOCK,
+                      __FILE__":(fetchBlock) reuse the result of %d. blocker=%d",
+                      key.publisher_, data.blocker_unum_ );
+        return true;
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamSharedMemory::publishPasserTree( const WorldModel & wm,
+                                     const int holder,
+                                     const Vector2D & trap_pos,
+                                     const std::vector< std::pair< int, int > > & passes )
+{
+    if ( ! open( wm )
+         || passes.size() > static_cast< size_t >( MAX_PASS ) )
+    {
+        return;
+    }
+
+    PasserTreePayload data;
+    std::memset( &data, 0, sizeof( PasserTreePayload ) );
+    data.holder_ = holder;
+    data.size_ = static_cast< std::int32_t >( passes.size() );
+    for ( size_t i = 0; i < passes.size(); ++i )
+    {
+        data.sender_[i] = passes[i].first;
+        data.receiver_[i] = passes[i].second;
+    }
+
+    write_slot( M_segment->passer_tree_[wm.self().unum() - 1],
+                create_key( wm, trap_pos ),
+                data );
+    ++M_publish_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TeamSharedMemory::fetchPasserTree( const WorldModel & wm,
+                                   const int holder,
+                                   const Vector2D & trap_pos,
+                                   std::vector< std::pair< int, int > > & passes )
+{
+    if ( ! open( wm ) )
+    {
+        return false;
+    }
+
+    const SharedKey mine = create_key( wm, trap_pos );
+
+    for ( int i = 0; i < MAX_SLOT; ++i )
+    {
+        if ( i == wm.self().unum() - 1 )
+        {
+            continue;
+        }
+
+        SharedKey key;
+        PasserTreePayload data;
+        if ( ! read_slot( M_segment->passer_tree_[i], &key, &data )
+             || ! is_consistent( mine, key )
+             || data.holder_ != holder
+             || data.size_ < 0
+             || MAX_PASS < data.size_ )
+        {
+            continue;
+        }
+
+        passes.clear();
+        for ( int j = 0; j < data.size_; ++j )
+        {
+            passes.push_back( std::make_pair( static_cast< int >( data.sender_[j] ),
+                                              static_cast< int >( data.receiver_[j] ) ) );
+        }
+
+        ++M_reuse_count;
+        dlog.addText( Logger::POSITIONING,
+                      __FILE__":(fetchPasserTree) reuse the result of %d. holder=%d size=%d",
+                      key.publisher_, data.holder_, data.size_ );
+        return true;
+    }
+
+    return false;
+}
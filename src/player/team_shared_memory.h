@@ -0,0 +1,173 @@
+// -*-c++-*-
+
+/*!
+  \file team_shared_memory.h
+  \brief shared memory exchange of team level results Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef TEAM_SHARED_MEMORY_H
+#define TEAM_SHARED_MEMORY_H
+
+#include "strategy.h"
+
+#include <rcsc/geom/vector_2d.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rcsc {
+class WorldModel;
+}
+
+struct TeamSharedSegment;
+
+/*!
+  \class TeamSharedMemory
+  \brief opt-in cache of per-cycle team level results shared by the
+  player processes running on the same host.
+
+  Each process publishes the results it computed into its own slot.
+  Other processes reuse them only when the publisher's cycle, game mode
+  and ball estimate agree with their own world model. Perception is not
+  shared; only the derived team level analyses are reused.
+
+  This is intended for local test matches. It must not be enabled in
+  official games, where inter-process communication is not allowed.
+ */
+class TeamSharedMemory {
+public:
+    //! the number of shared slots (one for each uniform number)
+    static const int MAX_SLOT = 11;
+    //! the maximum number of passes in a shared passer tree
+    static const int MAX_PASS = 8;
+
+private:
+    std::string M_base_name;
+    std::string M_name;
+
+    int M_fd;
+    TeamSharedSegment * M_segment;
+    //! slot index of this process in the segment
+    int M_slot;
+
+    int M_reuse_count;
+    int M_publish_count;
+
+    TeamSharedMemory();
+
+    // not used
+    TeamSharedMemory( const TeamSharedMemory & );
+    const TeamSharedMemory & operator=( const TeamSharedMemory & );
+public:
+
+    ~TeamSharedMemory();
+
+    static
+    TeamSharedMemory & instance();
+
+    /*!
+      \brief enable the exchange. the segment is opened after the team side is known.
+      \param base_name segment name. it must be unique for each match on the host.
+     */
+    void setName( const std::string & base_name )
+      {
+          M_base_name = base_name;
+      }
+
+    bool enabled() const
+      {
+          return ! M_base_name.empty();
+      }
+
+    bool isOpen() const
+      {
+          return M_segment != nullptr;
+      }
+
+    /*!
+      \brief detach from the segment. the segment is removed when no
+      other live process is attached.
+     */
+    void close();
+
+    //
+    // Strategy::updateSituation and Strategy::updatePosition
+    //
+
+    void publishStrategy( const rcsc::WorldModel & wm,
+                          const SituationType situation,
+                          const std::vector< rcsc::Vector2D > & positions,
+                          const std::vector< PositionType > & position_types );
+
+    bool fetchStrategy( const rcsc::WorldModel & wm,
+                        SituationType * situation,
+                        std::vector< rcsc::Vector2D > & positions,
+                        std::vector< PositionType > & position_types );
+
+    //
+    // Bhv_BasicBlock block assignment
+    //
+
+    void publishBlock( const rcsc::WorldModel & wm,
+                       const int blocker_unum,
+                       const rcsc::Vector2D & block_point );
+
+    bool fetchBlock( const rcsc::WorldModel & wm,
+                     int * blocker_unum,
+                     rcsc::Vector2D * block_point );
+
+    //
+    // Bhv_Unmark passer tree
+    //
+
+    /*!
+      \brief publish the passes predicted from the ball holder
+      \param holder the uniform number of the ball holder
+      \param trap_pos the ball position when the holder gets it
+      \param passes (sender, receiver) pairs
+     */
+    void publishPasserTree( const rcsc::WorldModel & wm,
+                            const int holder,
+                            const rcsc::Vector2D & trap_pos,
+                            const std::vector< std::pair< int, int > > & passes );
+
+    bool fetchPasserTree( const rcsc::WorldModel & wm,
+                          const int holder,
+                          const rcsc::Vector2D & trap_pos,
+                          std::vector< std::pair< int, int > > & passes );
+
+private:
+
+    bool open( const rcsc::WorldModel & wm );
+
+    int attach( const rcsc::WorldModel & wm );
+
+    void detach();
+};
+
+#endif
@@ -0,0 +1,375 @@
+// -*-c++-*-
+
+/*!
+  \file fast_geometry_test.cpp
+  \brief accuracy and screening test of FastGeometry
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "../planner/fast_geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+namespace {
+
+int g_failure_count = 0;
+
+#define CHECK( expr ) \
+    do { \
+        if ( ! ( expr ) ) \
+        { \
+            std::cerr << __FILE__ << ':' << __LINE__ \
+                      << " check failed: " #expr << std::endl; \
+            ++g_failure_count; \
+        } \
+    } while ( 0 )
+
+//! the same value as in strict_check_pass_generator.cpp
+const int MAX_SCREEN_STEP = 64;
+
+const double BALL_DECAY = 0.94;
+const double CATCHABLE_AREA = 1.2;
+const double PENALTY_AREA_X = 36.0;
+const double PENALTY_AREA_HALF_WIDTH = 20.16;
+
+/*!
+  \brief an opponent and a pass, in the double precision values used by
+  StrictCheckPassGenerator
+ */
+struct Scenario {
+    double px, py, pvx, pvy;
+    double decay;
+    double speed_max;
+    int pos_count;
+    double kickable_area;
+    bool goalie;
+    double bonus_distance;
+
+    double ball_x, ball_y;
+    double ball_speed;
+    double ball_dir; // degree
+    int max_cycle;
+
+    bool no_bonus; //!< the through pass condition of predictOpponentReachStep()
+    bool near_receive_point; //!< receive_point.x < 25.0
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief double precision version of the reach check in
+  StrictCheckPassGenerator::predictOpponentReachStep() up to the dash
+  distance check. the following checks (dash cycles, turn, risk) only
+  reject more cycles, so an opponent accepted there is accepted here.
+ */
+bool
+exact_may_reach( const Scenario & s )
+{
+    const double rad = s.ball_dir * M_PI / 180.0;
+    const double dir_x = std::cos( rad );
+    const double dir_y = std::sin( rad );
+
+    // FieldAnalyzer::estimate_min_reach_cycle()
+    const double rel_x = s.px - s.ball_x;
+    const double rel_y = s.py - s.ball_y;
+    const double along = rel_x * dir_x + rel_y * dir_y;
+    const double side = -rel_x * dir_y + rel_y * dir_x;
+    if ( along < -1.0 )
+    {
+        return false;
+    }
+    const int min_cycle = std::max( 1, static_cast< int >( std::floor( std::fabs( side ) / s.speed_max ) ) );
+
+    for ( int cycle = min_cycle; cycle <= s.max_cycle; ++cycle )
+    {
+        // inertia_n_step_point()
+        const double ball_gain = ( 1.0 - std::pow( BALL_DECAY, cycle ) ) / ( 1.0 - BALL_DECAY );
+        const double bx = s.ball_x + s.ball_speed * dir_x * ball_gain;
+        const double by = s.ball_y + s.ball_speed * dir_y * ball_gain;
+
+        const double control_area = ( s.goalie
+                                      && bx > PENALTY_AREA_X
+                                      && std::fabs( by ) < PENALTY_AREA_HALF_WIDTH
+                                      ? CATCHABLE_AREA
+                                      : s.kickable_area );
+
+        // PlayerType::inertiaPoint()
+        const double gain = ( 1.0 - std::pow( s.decay, cycle ) ) / ( 1.0 - s.decay );
+        const double target_dist = std::hypot( s.px + s.pvx * gain - bx,
+                                               s.py + s.pvy * gain - by );
+
+        double dash_dist = target_dist;
+        if ( ! s.no_bonus )
+        {
+            dash_dist -= s.bonus_distance;
+        }
+
+        if ( dash_dist - control_area - 0.15 < 0.001 )
+        {
+            return true;
+        }
+
+        if ( s.no_bonus )
+        {
+            dash_dist -= control_area;
+        }
+        else if ( s.near_receive_point )
+        {
+            dash_dist -= control_area + 0.5;
+        }
+        else
+        {
+            dash_dist -= control_area + 0.2;
+        }
+
+        if ( dash_dist <= s.speed_max * ( cycle + std::min( s.pos_count, 5 ) ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief float32 screening in the same way as
+  StrictCheckPassGenerator::updateOpponents() and predictOpponentsReachStep()
+ */
+bool
+screen_may_reach( const Scenario & s )
+{
+    const double control_area = ( s.goalie
+                                  ? std::max( CATCHABLE_AREA, s.kickable_area )
+                                  : s.kickable_area );
+    const float reach_buf = static_cast< float >( std::max( 0.0, s.bonus_distance )
+                                                  + control_area
+                                                  + 0.5 );
+
+    float ball_vx, ball_vy;
+    FastGeometry::polar( static_cast< float >( s.ball_speed ),
+                         static_cast< float >( s.ball_dir ),
+                         &ball_vx, &ball_vy );
+    float ball_x[MAX_SCREEN_STEP + 1];
+    float ball_y[MAX_SCREEN_STEP + 1];
+    FastGeometry::inertia_path( static_cast< float >( s.ball_x ),
+                                static_cast< float >( s.ball_y ),
+                                ball_vx, ball_vy,
+                                static_cast< float >( BALL_DECAY ),
+                                s.max_cycle,
+                                ball_x, ball_y );
+
+    float dir_x, dir_y;
+    FastGeometry::sincos_deg( static_cast< float >( s.ball_dir ), &dir_y, &dir_x );
+
+    return FastGeometry::may_reach_path( static_cast< float >( s.px ),
+                                         static_cast< float >( s.py ),
+                                         static_cast< float >( s.pvx ),
+                                         static_cast< float >( s.pvy ),
+                                         static_cast< float >( s.decay ),
+                                         static_cast< float >( s.speed_max ),
+                                         static_cast< float >( std::min( s.pos_count, 5 ) ),
+                                         reach_buf,
+                                         ball_x, ball_y,
+                                         dir_x, dir_y,
+                                         s.max_cycle );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create a random opponent and pass.
+  if boundary is true, the opponent is put around the reach distance of
+  a random cycle, where the float32 errors matter.
+ */
+Scenario
+create_scenario( std::mt19937 & rng,
+                 const bool boundary )
+{
+    std::uniform_real_distribution< double > u( 0.0, 1.0 );
+
+    Scenario s;
+    s.decay = 0.35 + 0.15 * u( rng );
+    s.speed_max = 0.95 + 0.25 * u( rng );
+    s.pos_count = static_cast< int >( 10 * u( rng ) );
+    s.kickable_area = 0.7 + 0.4 * u( rng );
+    s.goalie = ( u( rng ) < 0.2 );
+    s.bonus_distance = -0.5 + 2.0 * u( rng );
+    s.pvx = -0.6 + 1.2 * u( rng );
+    s.pvy = -0.6 + 1.2 * u( rng );
+
+    s.ball_x = -52.5 + 105.0 * u( rng );
+    s.ball_y = -34.0 + 68.0 * u( rng );
+    s.ball_speed = 0.5 + 2.5 * u( rng );
+    s.ball_dir = -180.0 + 360.0 * u( rng );
+    s.max_cycle = 1 + static_cast< int >( ( MAX_SCREEN_STEP - 1 ) * u( rng ) );
+
+    s.no_bonus = ( u( rng ) < 0.3 );
+    s.near_receive_point = ( u( rng ) < 0.5 );
+
+    if ( ! boundary )
+    {
+        s.px = -60.0 + 120.0 * u( rng );
+        s.py = -40.0 + 80.0 * u( rng );
+        return s;
+    }
+
+    // the reach distance of the screening at a random cycle
+    const int cycle = 1 + static_cast< int >( ( s.max_cycle - 1 ) * u( rng ) );
+    const double rad = s.ball_dir * M_PI / 180.0;
+    const double ball_gain = ( 1.0 - std::pow( BALL_DECAY, cycle ) ) / ( 1.0 - BALL_DECAY );
+    const double bx = s.ball_x + s.ball_speed * std::cos( rad ) * ball_gain;
+    const double by = s.ball_y + s.ball_speed * std::sin( rad ) * ball_gain;
+    const double control_area = ( s.goalie
+                                  ? std::max( CATCHABLE_AREA, s.kickable_area )
+                                  : s.kickable_area );
+    const double reach = s.speed_max * ( cycle + std::min( s.pos_count, 5 ) )
+        + std::max( 0.0, s.bonus_distance ) + control_area + 0.5;
+    const double dist = reach * ( 1.0 + 0.002 * ( u( rng ) - 0.5 ) );
+    const double angle = 2.0 * M_PI * u( rng );
+    const double gain = ( 1.0 - std::pow( s.decay, cycle ) ) / ( 1.0 - s.decay );
+    s.px = bx + dist * std::cos( angle ) - s.pvx * gain;
+    s.py = by + dist * std::sin( angle ) - s.pvy * gain;
+    return s;
+}
+
+/*-------------------------------------------------------------------*/
+void
+test_accuracy()
+{
+    // the bounds must not be loosened
+    CHECK( FastGeometry::ATAN2_MAX_ERROR_DEG <= 2.0e-4f );
+    CHECK( FastGeometry::SINCOS_MAX_ERROR <= 1.0e-6f );
+
+    CHECK( FastGeometry::check_accuracy( std::cout ) );
+
+    // atan2 over all directions, including the far and the tiny vectors
+    double atan2_error = 0.0;
+    for ( int i = -360000; i <= 360000; ++i )
+    {
+        const double deg = i * 0.0005;
+        for ( const double r : { 1.0e-3, 1.0, 150.0 } )
+        {
+            const double x = r * std::cos( deg * M_PI / 180.0 );
+            const double y = r * std::sin( deg * M_PI / 180.0 );
+            const double exact = std::atan2( static_cast< float >( y ), static_cast< float >( x ) ) * 180.0 / M_PI;
+            double err = std::fabs( exact - FastGeometry::atan2_deg( static_cast< float >( y ),
+                                                                     static_cast< float >( x ) ) );
+            if ( err > 180.0 ) err = 360.0 - err;
+            atan2_error = std::max( atan2_error, err );
+        }
+    }
+    std::cout << "fast_geometry_test: atan2 error over all directions=" << atan2_error << "[deg]" << std::endl;
+    CHECK( atan2_error <= FastGeometry::ATAN2_MAX_ERROR_DEG );
+    CHECK( FastGeometry::atan2_deg( 0.0f, 0.0f ) == 0.0f );
+
+    // sincos at the quadrant boundaries and the ends of the range
+    double sincos_error = 0.0;
+    for ( int q = -8; q <= 8; ++q )
+    {
+        for ( const double d : { -1.0e-3, 0.0, 1.0e-3, 44.999, 45.0, 45.001 } )
+        {
+            const double deg = q * 90.0 + d;
+            if ( std::fabs( deg ) > 720.0 ) continue;
+            float s, c;
+            FastGeometry::sincos_deg( static_cast< float >( deg ), &s, &c );
+            const double rad = static_cast< float >( deg ) * M_PI / 180.0;
+            sincos_error = std::max( sincos_error,
+                                     std::max( std::fabs( s - std::sin( rad ) ),
+                                               std::fabs( c - std::cos( rad ) ) ) );
+        }
+    }
+    CHECK( sincos_error <= FastGeometry::SINCOS_MAX_ERROR );
+}
+
+/*-------------------------------------------------------------------*/
+void
+test_screening( std::mt19937 & rng )
+{
+    int exact_count = 0;
+    int screened_count = 0;
+    int false_reject_count = 0;
+
+    for ( int i = 0; i < 400000; ++i )
+    {
+        const Scenario s = create_scenario( rng, ( i % 2 ) == 1 );
+        const bool exact = exact_may_reach( s );
+        const bool screen = screen_may_reach( s );
+
+        if ( exact ) ++exact_count;
+        if ( ! screen ) ++screened_count;
+
+        // the screening never rejects an opponent the exact check accepts
+        if ( exact && ! screen )
+        {
+            ++false_reject_count;
+            if ( false_reject_count <= 5 )
+            {
+                std::cerr << "screened out: pos=(" << s.px << ' ' << s.py << ")"
+                          << " ball=(" << s.ball_x << ' ' << s.ball_y << ")"
+                          << " speed=" << s.ball_speed << " dir=" << s.ball_dir
+                          << " max_cycle=" << s.max_cycle << std::endl;
+            }
+        }
+    }
+
+    std::cout << "fast_geometry_test: exact accepted=" << exact_count
+              << " screened out=" << screened_count
+              << " wrongly screened out=" << false_reject_count << std::endl;
+
+    CHECK( false_reject_count == 0 );
+    // both branches must be exercised
+    CHECK( exact_count > 0 );
+    CHECK( screened_count > 0 );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main()
+{
+    std::mt19937 rng( 20230301 );
+
+    test_accuracy();
+    test_screening( rng );
+
+    if ( g_failure_count > 0 )
+    {
+        std::cerr << "fast_geometry_test: " << g_failure_count << " failure(s)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "fast_geometry_test: ok" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+// -*-c++-*-
+
+/*!
+  \file multi_kick_speculation_test.cpp
+  \brief test which kicks of a multi-kick action reuse the chain
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "../planner/multi_kick_speculation.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+int g_failure_count = 0;
+
+#define CHECK( expr ) \
+    do { \
+        if ( ! ( expr ) ) \
+        { \
+            std::cerr << __FILE__ << ':' << __LINE__ \
+                      << " check failed: " #expr << std::endl; \
+            ++g_failure_count; \
+        } \
+    } while ( 0 )
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief execute an action of kick_count kicks in the same way as
+  ActionChainHolder and return the kicks planned by the adopted chain.
+ */
+std::vector< int >
+adopted_kicks( const int kick_count )
+{
+    std::vector< int > result;
+
+    // kick 1 is planned by the search
+    int adopted_count = 0;
+    for ( int kick = 1; kick < kick_count; ++kick )
+    {
+        // prepareSpeculation() after the kick
+        if ( ! keep_multi_kick_chain( adopted_count, kick_count ) )
+        {
+            break;
+        }
+
+        // adoptSpeculation() at the next kick
+        ++adopted_count;
+        result.push_back( kick + 1 );
+    }
+
+    return result;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main()
+{
+    // single and double kicks are always searched
+    CHECK( adopted_kicks( 1 ).empty() );
+    CHECK( adopted_kicks( 2 ).empty() );
+
+    for ( int kick_count = 3; kick_count <= 8; ++kick_count )
+    {
+        // only the intermediate kicks are adopted
+        std::vector< int > expected;
+        for ( int kick = 2; kick < kick_count; ++kick )
+        {
+            expected.push_back( kick );
+        }
+        CHECK( adopted_kicks( kick_count ) == expected );
+    }
+
+    // the release kick is never adopted, whatever the adopted count is
+    for ( int kick_count = 1; kick_count <= 8; ++kick_count )
+    {
+        CHECK( ! keep_multi_kick_chain( kick_count - 2, kick_count ) );
+        CHECK( ! keep_multi_kick_chain( kick_count - 1, kick_count ) );
+    }
+
+    if ( g_failure_count > 0 )
+    {
+        std::cerr << "multi_kick_speculation_test: " << g_failure_count << " failure(s)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "multi_kick_speculation_test: ok" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,197 @@
+// -*-c++-*-
+
+/*!
+  \file packed_say_codec_bench.cpp
+  \brief size and speed benchmark of PackedSayCodec against the librcsc messages
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "../packed_say_message.h"
+
+#include <rcsc/player/say_message_builder.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace rcsc;
+
+namespace {
+
+const int SAMPLE_SIZE = 100000;
+
+struct Sample {
+    Vector2D ball_pos_;
+    Vector2D ball_vel_;
+    int number_[3];
+    Vector2D pos_[3];
+};
+
+/*-------------------------------------------------------------------*/
+std::vector< Sample >
+create_samples()
+{
+    std::mt19937 rng( 20230301 );
+    std::uniform_real_distribution< double > x( -52.5, 52.5 );
+    std::uniform_real_distribution< double > y( -34.0, 34.0 );
+    std::uniform_real_distribution< double > v( -2.7, 2.7 );
+    std::uniform_int_distribution< int > n( 1, 22 );
+
+    std::vector< Sample > samples( SAMPLE_SIZE );
+    for ( Sample & s : samples )
+    {
+        s.ball_pos_.assign( x( rng ), y( rng ) );
+        s.ball_vel_.assign( v( rng ), v( rng ) );
+        for ( int i = 0; i < 3; ++i )
+        {
+            s.number_[i] = n( rng );
+            s.pos_[i].assign( x( rng ), y( rng ) );
+        }
+    }
+    return samples;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief encode all samples and print the size and the speed.
+  \param objects the number of objects in one message
+ */
+void
+run( const char * name,
+     const int objects,
+     const std::vector< Sample > & samples,
+     const std::function< bool ( const Sample &, std::string & ) > & encode )
+{
+    std::string msg;
+    std::size_t total_len = 0;
+    bool ok = true;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( const Sample & s : samples )
+    {
+        msg.clear();
+        ok &= encode( s, msg );
+        total_len += msg.length();
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    const double chars = static_cast< double >( total_len ) / samples.size();
+    const double nsec = std::chrono::duration< double, std::nano >( end - start ).count() / samples.size();
+
+    std::printf( "%-28s %5.1f chars %6.1f bits/object %8.1f ns/msg%s\n",
+                 name,
+                 chars,
+                 chars * std::log2( static_cast< double >( PackedSayCodec::charset().size() ) ) / objects,
+                 nsec,
+                 ok ? "" : " (encode error)" );
+}
+
+/*-------------------------------------------------------------------*/
+std::vector< double >
+packed_values( const Sample & s,
+               const bool with_ball,
+               const int players )
+{
+    std::vector< double > values;
+    if ( with_ball )
+    {
+        values.push_back( s.ball_pos_.x );
+        values.push_back( s.ball_pos_.y );
+        values.push_back( s.ball_vel_.x );
+        values.push_back( s.ball_vel_.y );
+    }
+    for ( int i = 0; i < players; ++i )
+    {
+        values.push_back( s.number_[i] );
+        values.push_back( s.pos_[i].x );
+        values.push_back( s.pos_[i].y );
+    }
+    return values;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main()
+{
+    const std::vector< Sample > samples = create_samples();
+
+    std::printf( "%d messages per case. sizes include the header character.\n",
+                 SAMPLE_SIZE );
+
+    run( "BallPlayerMessage", 2, samples,
+         []( const Sample & s, std::string & to )
+         {
+             return BallPlayerMessage( s.ball_pos_, s.ball_vel_,
+                                       s.number_[0], s.pos_[0], AngleDeg( 0.0 ) ).appendTo( to );
+         } );
+    run( "PackedSayMessage BALL_PLAYER", 2, samples,
+         []( const Sample & s, std::string & to )
+         {
+             return PackedSayMessage( PackedSayCodec::BALL_PLAYER,
+                                      packed_values( s, true, 1 ) ).appendTo( to );
+         } );
+
+    run( "TwoPlayerMessage", 2, samples,
+         []( const Sample & s, std::string & to )
+         {
+             return TwoPlayerMessage( s.number_[0], s.pos_[0],
+                                      s.number_[1], s.pos_[1] ).appendTo( to );
+         } );
+    run( "PackedSayMessage TWO_PLAYERS", 2, samples,
+         []( const Sample & s, std::string & to )
+         {
+             return PackedSayMessage( PackedSayCodec::TWO_PLAYERS,
+                                      packed_values( s, false, 2 ) ).appendTo( to );
+         } );
+
+    run( "ThreePlayerMessage", 3, samples,
+         []( const Sample & s, std::string & to )
+         {
+             return ThreePlayerMessage( s.number_[0], s.pos_[0],
+                                        s.number_[1], s.pos_[1],
+                                        s.number_[2], s.pos_[2] ).appendTo( to );
+         } );
+    run( "PackedSayMessage THREE_PLAYERS", 3, samples,
+         []( const Sample & s, std::string & to )
+         {
+             return PackedSayMessage( PackedSayCodec::THREE_PLAYERS,
+                                      packed_values( s, false, 3 ) ).appendTo( to );
+         } );
+
+    return 0;
+}
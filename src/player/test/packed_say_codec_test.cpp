@@ -0,0 +1,208 @@
+// -*-c++-*-
+
+/*!
+  \file packed_say_codec_test.cpp
+  \brief round trip test of PackedSayCodec
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "../packed_say_codec.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failure_count = 0;
+
+#define CHECK( expr ) \
+    do { \
+        if ( ! ( expr ) ) \
+        { \
+            std::cerr << __FILE__ << ':' << __LINE__ \
+                      << " check failed: " #expr << std::endl; \
+            ++g_failure_count; \
+        } \
+    } while ( 0 )
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief encode the values, decode the result and compare both.
+ */
+void
+check_round_trip( const PackedSayCodec::Layout layout,
+                  const std::vector< double > & values )
+{
+    const std::vector< PackedSayCodec::Field > & fields = PackedSayCodec::fields( layout );
+
+    std::string msg;
+    CHECK( PackedSayCodec::encode( layout, values, msg ) );
+    CHECK( static_cast< int >( msg.length() ) == PackedSayCodec::length( layout ) );
+    CHECK( msg.find_first_not_of( PackedSayCodec::charset() ) == std::string::npos );
+
+    // the decoder must stop at the end of the message
+    msg += "trailer";
+
+    PackedSayCodec::Layout decoded_layout = PackedSayCodec::LAYOUT_SIZE;
+    std::vector< double > decoded;
+    const int n_read = PackedSayCodec::decode( msg.c_str(), &decoded_layout, &decoded );
+
+    CHECK( n_read == PackedSayCodec::length( layout ) );
+    CHECK( decoded_layout == layout );
+    CHECK( decoded.size() == fields.size() );
+    if ( decoded.size() != fields.size() )
+    {
+        return;
+    }
+
+    for ( std::size_t i = 0; i < fields.size(); ++i )
+    {
+        const PackedSayCodec::Field & f = fields[i];
+        const double expected = std::min( std::max( f.min_, values[i] ), f.max_ );
+        if ( std::fabs( decoded[i] - expected ) > f.step_ * 0.5 + 1.0e-9 )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " layout=" << layout << ' ' << f.name_
+                      << " value=" << values[i] << " decoded=" << decoded[i]
+                      << std::endl;
+            ++g_failure_count;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+void
+test_random( const PackedSayCodec::Layout layout,
+             std::mt19937 & rng )
+{
+    const std::vector< PackedSayCodec::Field > & fields = PackedSayCodec::fields( layout );
+
+    for ( int n = 0; n < 10000; ++n )
+    {
+        std::vector< double > values;
+        for ( const PackedSayCodec::Field & f : fields )
+        {
+            // include out of range values to check clamping
+            std::uniform_real_distribution< double > dist( f.min_ - f.step_ * 2.0,
+                                                           f.max_ + f.step_ * 2.0 );
+            values.push_back( dist( rng ) );
+        }
+        check_round_trip( layout, values );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+void
+test_bounds( const PackedSayCodec::Layout layout )
+{
+    const std::vector< PackedSayCodec::Field > & fields = PackedSayCodec::fields( layout );
+
+    std::vector< double > min_values;
+    std::vector< double > max_values;
+    for ( const PackedSayCodec::Field & f : fields )
+    {
+        min_values.push_back( f.min_ );
+        max_values.push_back( f.max_ );
+    }
+
+    check_round_trip( layout, min_values );
+    check_round_trip( layout, max_values );
+}
+
+/*-------------------------------------------------------------------*/
+void
+test_illegal_input()
+{
+    PackedSayCodec::Layout layout;
+    std::vector< double > values;
+
+    CHECK( PackedSayCodec::decode( "", &layout, &values ) == -1 );
+    CHECK( PackedSayCodec::decode( "!", &layout, &values ) == -1 );
+
+    std::string msg;
+    CHECK( ! PackedSayCodec::encode( PackedSayCodec::TWO_PLAYERS,
+                                     std::vector< double >( 2 ),
+                                     msg ) );
+    CHECK( msg.empty() );
+
+    std::vector< double > two_players;
+    for ( const PackedSayCodec::Field & f : PackedSayCodec::fields( PackedSayCodec::TWO_PLAYERS ) )
+    {
+        two_players.push_back( f.min_ );
+    }
+    CHECK( PackedSayCodec::encode( PackedSayCodec::TWO_PLAYERS, two_players, msg ) );
+
+    // truncated message
+    const std::string truncated = msg.substr( 0, msg.length() - 1 );
+    CHECK( PackedSayCodec::decode( truncated.c_str(), &layout, &values ) == -1 );
+
+    // character out of the alphabet in the tail
+    std::string broken = msg;
+    broken[1] = ' ';
+    CHECK( PackedSayCodec::decode( broken.c_str(), &layout, &values ) == -1 );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+int
+main()
+{
+    std::mt19937 rng( 20230301 );
+
+    for ( int i = 0; i < PackedSayCodec::LAYOUT_SIZE; ++i )
+    {
+        const PackedSayCodec::Layout layout = static_cast< PackedSayCodec::Layout >( i );
+
+        // the tail characters must be able to hold the information
+        CHECK( PackedSayCodec::bits( layout )
+               <= ( std::log2( PackedSayCodec::charset().size() / PackedSayCodec::LAYOUT_SIZE )
+                    + std::log2( PackedSayCodec::charset().size() ) * ( PackedSayCodec::length( layout ) - 1 ) ) );
+
+        test_bounds( layout );
+        test_random( layout, rng );
+    }
+
+    test_illegal_input();
+
+    if ( g_failure_count > 0 )
+    {
+        std::cerr << "packed_say_codec_test: " << g_failure_count << " failure(s)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "packed_say_codec_test: ok" << std::endl;
+    return EXIT_SUCCESS;
+}
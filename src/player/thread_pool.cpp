@@ -0,0 +1,460 @@
+// -*-c++-*-
+
+/*!
+  \file thread_pool.cpp
+  \brief work stealing thread pool of the player process Source File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+//! the index of the task queue owned by the current thread
+thread_local int s_queue_index = 0;
+
+/*-------------------------------------------------------------------*/
+double
+to_msec( const long nsec )
+{
+    return nsec * 1.0e-6;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool::TaskGroup::TaskGroup( const char * name,
+                                  ThreadPool & pool )
+    : M_pool( pool ),
+      M_name( name ),
+      M_remaining( 0 ),
+      M_task_nsec( 0 ),
+      M_task_count( 0 ),
+      M_start( std::chrono::steady_clock::now() )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool::TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::TaskGroup::run( std::function< void() > task )
+{
+    ++M_task_count;
+    M_remaining.fetch_add( 1 );
+
+    Task t;
+    t.func_ = std::move( task );
+    t.group_ = this;
+
+    if ( M_pool.workerSize() == 0 )
+    {
+        // no worker. execute it here in the submission order.
+        M_pool.execute( t );
+        return;
+    }
+
+    M_pool.push( std::move( t ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::TaskGroup::wait()
+{
+    while ( M_remaining.load( std::memory_order_acquire ) > 0 )
+    {
+        Task t;
+        if ( M_pool.pop( &t ) )
+        {
+            M_pool.execute( t );
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if ( M_task_count > 0 )
+    {
+        const long wall_nsec
+            = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now()
+                                                                      - M_start ).count();
+        M_pool.addStat( M_name, M_task_count,
+                        to_msec( wall_nsec ),
+                        to_msec( M_task_nsec.load() ) );
+        M_task_count = 0;
+        M_task_nsec = 0;
+    }
+    M_start = std::chrono::steady_clock::now();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::TaskGroup::finishTask( const long nsec )
+{
+    M_task_nsec.fetch_add( nsec, std::memory_order_relaxed );
+    M_remaining.fetch_sub( 1, std::memory_order_release );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool::ThreadPool()
+    : M_stop( false ),
+      M_pending( 0 )
+{
+    M_queues.emplace_back( new Queue() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool &
+ThreadPool::instance()
+{
+    static ThreadPool s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ThreadPool::auto_thread_count( const int processes_per_host )
+{
+    const int hardware = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) );
+    int allowed = hardware;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO( &mask );
+    if ( sched_getaffinity( 0, sizeof( mask ), &mask ) == 0 )
+    {
+        allowed = std::max( 1, CPU_COUNT( &mask ) );
+    }
+#endif
+
+    if ( allowed < hardware )
+    {
+        // pinned to the CPUs of its own. the client thread uses one of them.
+        return allowed - 1;
+    }
+
+    return std::max( 0, allowed / std::max( 1, processes_per_host ) - 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ThreadPool::start( const int n_threads )
+{
+    if ( ! M_threads.empty() )
+    {
+        return true;
+    }
+
+    if ( n_threads <= 0 )
+    {
+        return false;
+    }
+
+    M_stop = false;
+    for ( int i = 0; i < n_threads; ++i )
+    {
+        M_queues.emplace_back( new Queue() );
+    }
+
+    for ( int i = 0; i < n_threads; ++i )
+    {
+        M_threads.emplace_back( &ThreadPool::workerMain, this, i + 1 );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::stop()
+{
+    if ( M_threads.empty() )
+    {
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_sleep_mutex );
+        M_stop = true;
+    }
+    M_wakeup.notify_all();
+
+    for ( std::thread & t : M_threads )
+    {
+        t.join();
+    }
+    M_threads.clear();
+    M_queues.resize( 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::parallelFor( const char * name,
+                         const int begin,
+                         const int end,
+                         const int grain,
+                         const std::function< void( int, int ) > & body )
+{
+    if ( begin >= end )
+    {
+        return;
+    }
+
+    const int size = end - begin;
+    const int max_chunk = ( workerSize() + 1 ) * 4;
+    const int chunk_count = ( workerSize() == 0
+                              ? 1
+                              : std::min( max_chunk, ( size + std::max( 1, grain ) - 1 ) / std::max( 1, grain ) ) );
+    const int chunk_size = ( size + chunk_count - 1 ) / chunk_count;
+
+    TaskGroup group( name, *this );
+    for ( int b = begin; b < end; b += chunk_size )
+    {
+        const int e = std::min( end, b + chunk_size );
+        group.run( [&body, b, e]() { body( b, e ); } );
+    }
+    group.wait();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::map< std::string, ThreadPool::Stat >
+ThreadPool::statistics()
+{
+    std::lock_guard< std::mutex > lock( M_stat_mutex );
+    return M_stats;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+ThreadPool::printStatistics( std::ostream & os )
+{
+    const std::map< std::string, Stat > stats = statistics();
+
+    os << "ThreadPool: workers=" << workerSize() << '\n';
+    for ( const std::map< std::string, Stat >::value_type & v : stats )
+    {
+        const Stat & s = v.second;
+        os << "  " << v.first
+           << " groups=" << s.group_count_
+           << " tasks=" << s.task_count_
+           << " wall=" << s.wall_msec_ << "[ms]"
+           << " (avg " << s.wall_msec_ / std::max( 1L, s.group_count_ )
+           << " max " << s.max_wall_msec_ << ")"
+           << " task=" << s.task_msec_ << "[ms]"
+           << '\n';
+    }
+    return os << std::flush;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::workerMain( const int index )
+{
+    s_queue_index = index;
+
+    while ( ! M_stop )
+    {
+        Task t;
+        if ( pop( &t ) )
+        {
+            execute( t );
+            continue;
+        }
+
+        std::unique_lock< std::mutex > lock( M_sleep_mutex );
+        M_wakeup.wait( lock, [this]() { return M_stop || M_pending.load() > 0; } );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::push( Task && task )
+{
+    // the threads out of the pool share the first queue
+    const int index = ( s_queue_index < static_cast< int >( M_queues.size() )
+                        ? s_queue_index
+                        : 0 );
+    {
+        Queue & q = *M_queues[index];
+        std::lock_guard< std::mutex > lock( q.mutex_ );
+        q.tasks_.push_back( std::move( task ) );
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_sleep_mutex );
+        M_pending.fetch_add( 1 );
+    }
+    M_wakeup.notify_one();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ThreadPool::pop( Task * task )
+{
+    if ( M_pending.load() <= 0 )
+    {
+        return false;
+    }
+
+    const int size = static_cast< int >( M_queues.size() );
+    const int self = ( s_queue_index < size ? s_queue_index : 0 );
+
+    for ( int i = 0; i < size; ++i )
+    {
+        const int index = ( self + i ) % size;
+        Queue & q = *M_queues[index];
+        std::lock_guard< std::mutex > lock( q.mutex_ );
+        if ( q.tasks_.empty() )
+        {
+            continue;
+        }
+
+        if ( i == 0 )
+        {
+            // own tasks from the newest one
+            *task = std::move( q.tasks_.back() );
+            q.tasks_.pop_back();
+        }
+        else
+        {
+            // steal the oldest one
+            *task = std::move( q.tasks_.front() );
+            q.tasks_.pop_front();
+        }
+        M_pending.fetch_sub( 1 );
+        return true;
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::execute( Task & task )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    task.func_();
+    const long nsec
+        = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now()
+                                                                  - start ).count();
+    task.group_->finishTask( nsec );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::addStat( const char * name,
+                     const long task_count,
+                     const double wall_msec,
+                     const double task_msec )
+{
+    std::lock_guard< std::mutex > lock( M_stat_mutex );
+    Stat & s = M_stats[name];
+    s.group_count_ += 1;
+    s.task_count_ += task_count;
+    s.wall_msec_ += wall_msec;
+    s.task_msec_ += task_msec;
+    s.max_wall_msec_ = std::max( s.max_wall_msec_, wall_msec );
+}
@@ -0,0 +1,244 @@
+// -*-c++-*-
+
+/*!
+  \file thread_pool.h
+  \brief work stealing thread pool of the player process Header File
+*/
+
+/*
+ *Copyright:
+
+ RoboTech
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*!
+  \class ThreadPool
+  \brief persistent work stealing thread pool shared by all modules of a player.
+
+  Each thread, including the client thread that submits the tasks, has
+  its own task deque. A thread pops its own tasks from the back and
+  steals the tasks of the other threads from the front. A thread waiting
+  for a TaskGroup executes the pending tasks instead of blocking, so
+  fork-join calls may be nested.
+
+  Without any worker thread (the default) every task is executed on the
+  client thread in the submission order.
+
+  Tasks must not write to the shared state of the player, e.g. dlog,
+  debugClient() or the singletons updated in actionImpl(). They may read
+  the world model. Results should be written to the slots owned by the
+  task and merged by the caller after wait().
+ */
+class ThreadPool {
+public:
+
+    /*!
+      \brief the timing counters of the task groups of the same name
+     */
+    struct Stat {
+        long group_count_; //!< the number of finished task groups
+        long task_count_; //!< the number of executed tasks
+        double wall_msec_; //!< the sum of the wall time from the first run() to the end of wait()
+        double task_msec_; //!< the sum of the task execution time over all threads
+        double max_wall_msec_; //!< the maximum wall time of one group
+
+        Stat()
+            : group_count_( 0 ),
+              task_count_( 0 ),
+              wall_msec_( 0.0 ),
+              task_msec_( 0.0 ),
+              max_wall_msec_( 0.0 )
+          { }
+    };
+
+    /*!
+      \class TaskGroup
+      \brief a set of tasks forked together and joined by wait()
+     */
+    class TaskGroup {
+    private:
+        ThreadPool & M_pool;
+        const char * M_name;
+        std::atomic< int > M_remaining;
+        std::atomic< long > M_task_nsec;
+        long M_task_count;
+        std::chrono::steady_clock::time_point M_start;
+
+        // not used
+        TaskGroup( const TaskGroup & );
+        TaskGroup & operator=( const TaskGroup & );
+
+    public:
+        /*!
+          \param name the key of the timing counters. must be a literal string.
+         */
+        explicit
+        TaskGroup( const char * name,
+                   ThreadPool & pool = ThreadPool::instance() );
+
+        //! waits for the remaining tasks
+        ~TaskGroup();
+
+        /*!
+          \brief submit a task
+         */
+        void run( std::function< void() > task );
+
+        /*!
+          \brief execute the pending tasks until all tasks of this group finish
+         */
+        void wait();
+
+    private:
+        friend class ThreadPool;
+        void finishTask( const long nsec );
+    };
+
+private:
+
+    struct Task {
+        std::function< void() > func_;
+        TaskGroup * group_;
+    };
+
+    struct Queue {
+        std::mutex mutex_;
+        std::deque< Task > tasks_;
+    };
+
+    //! M_queues[0] is used by the threads out of the pool
+    std::vector< std::unique_ptr< Queue > > M_queues;
+    std::vector< std::thread > M_threads;
+
+    std::atomic< bool > M_stop;
+    std::atomic< int > M_pending;
+    std::mutex M_sleep_mutex;
+    std::condition_variable M_wakeup;
+
+    std::mutex M_stat_mutex;
+    std::map< std::string, Stat > M_stats;
+
+    ThreadPool();
+
+    // not used
+    ThreadPool( const ThreadPool & );
+    ThreadPool & operator=( const ThreadPool & );
+public:
+
+    ~ThreadPool();
+
+    static
+    ThreadPool & instance();
+
+    static
+    const ThreadPool & i()
+      {
+          return instance();
+      }
+
+    /*!
+      \brief get the number of worker threads that fits the CPU affinity of this process.
+      If the process is pinned to a subset of the CPUs, all CPUs of the subset except one
+      are used. Otherwise the CPUs are assumed to be shared by the processes of a team.
+      \param processes_per_host the number of processes sharing the CPUs
+      \return the number of worker threads. 0 if no CPU is left.
+     */
+    static
+    int auto_thread_count( const int processes_per_host );
+
+    /*!
+      \brief start the worker threads. nothing is done if already started.
+      \param n_threads the number of worker threads
+      \return true if the threads are running
+     */
+    bool start( const int n_threads );
+
+    /*!
+      \brief stop and join the worker threads
+     */
+    void stop();
+
+    /*!
+      \brief get the number of worker threads
+     */
+    int workerSize() const
+      {
+          return static_cast< int >( M_threads.size() );
+      }
+
+    /*!
+      \brief split [begin, end) into chunks of grain elements and call body( chunk_begin, chunk_end )
+      for each chunk in parallel. returns after all chunks finish.
+      \param name the key of the timing counters. must be a literal string.
+      \param begin first index
+      \param end last index + 1
+      \param grain the minimum chunk size. the range is not split if it is not larger than grain.
+      \param body the function called for each chunk
+     */
+    void parallelFor( const char * name,
+                      const int begin,
+                      const int end,
+                      const int grain,
+                      const std::function< void( int, int ) > & body );
+
+    /*!
+      \brief get the timing counters of all task groups
+     */
+    std::map< std::string, Stat > statistics();
+
+    /*!
+      \brief write the timing counters
+     */
+    std::ostream & printStatistics( std::ostream & os );
+
+private:
+
+    void workerMain( const int index );
+
+    void push( Task && task );
+    bool pop( Task * task );
+
+    void execute( Task & task );
+
+    void addStat( const char * name,
+                  const long task_count,
+                  const double wall_msec,
+                  const double task_msec );
+};
+
+#endif
@@ -32,6 +32,7 @@
 
 #include "basic_actions/basic_actions.h"
 #include "basic_actions/view_synch.h"
+#include "basic_actions/information_value.h"
 
 #include <rcsc/player/player_agent.h>
 #include <rcsc/player/intercept_table.h>
@@ -207,7 +208,33 @@ View_Tactical::doDefault( PlayerAgent * agent )
 
     dlog.addText( Logger::TEAM,
                   __FILE__": default synch" );
-    return View_Synch().execute( agent );
+    if ( ! View_Synch().execute( agent ) )
+    {
+        return false;
+    }
+
+    //
+    // narrow view is not enough if a relevant player near the agent is too stale
+    //
+    if ( ! wm.self().goalie()
+         && agent->effector().queuedNextViewWidth().type() == ViewWidth::NARROW
+         && ball_dist > 5.0 )
+    {
+        const double stale_value_thr = 16.0; // Magic Number
+
+        InformationValue::instance().update( wm );
+        const double max_value = InformationValue::i().maxSeeValue( agent->effector().queuedNextSelfPos(),
+                                                                    20.0 );
+        if ( max_value > stale_value_thr )
+        {
+            dlog.addText( Logger::TEAM,
+                          __FILE__": stale player value=%.1f normal",
+                          max_value );
+            return agent->doChangeView( ViewWidth::NORMAL );
+        }
+    }
+
+    return true;
 
 }
 
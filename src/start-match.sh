@@ -0,0 +1,336 @@
+#!/bin/sh
+
+#
+# runs local test matches faster than real time.
+#
+# rcssserver is started in synchronous mode with a fixed random seed, so
+# each cycle advances as soon as all clients have sent (done) and the
+# server side noise is reproducible. librcsc clients answer the server's
+# (think) messages automatically, no player option is required.
+#
+# the left and right teams are directories that contain start.sh, e.g.
+# two different builds of this team for A/B comparisons.
+#
+# with --cpus, the CPUs are split between the two teams and each player
+# and coach is pinned to one of them by start.sh, so that several matches
+# can run side by side on one host without competing for the same CPUs.
+# --report-misses prints the play_on cycles each player failed to act in,
+# which shows whether the CPUs given to a match are enough.
+#
+
+DIR=`dirname $0`
+
+server="rcssserver"
+left_dir="${DIR}"
+right_dir="${DIR}"
+left_name="Left"
+right_name="Right"
+left_opt=""
+right_opt=""
+port=6000
+seed=1
+games=1
+log_dir="./match-logs"
+half_time=3000
+cpu_list=""
+report_misses="false"
+
+usage()
+{
+  (echo "Usage: $0 [options]"
+   echo "Available options:"
+   echo "      --help                   prints this"
+   echo "  -l, --left DIR               specifies the left team directory (default: ${DIR})"
+   echo "  -r, --right DIR              specifies the right team directory (default: ${DIR})"
+   echo "  --left-name TEAMNAME         specifies the left team name (default: Left)"
+   echo "  --right-name TEAMNAME        specifies the right team name (default: Right)"
+   echo "  --left-opt OPTIONS           passes OPTIONS to the left team's start.sh"
+   echo "  --right-opt OPTIONS          passes OPTIONS to the right team's start.sh"
+   echo "  -p, --port PORT              specifies server port (default: 6000)"
+   echo "  -s, --seed SEED              specifies the random seed of the first game (default: 1)"
+   echo "  -g, --games NUMBER           specifies the number of games. the seed is incremented for each game (default: 1)"
+   echo "  --half-time CYCLES           specifies the length of each half (default: 3000)"
+   echo "  --log-dir DIRECTORY          specifies the game log directory (default: ./match-logs)"
+   echo "  --server PROGRAM             specifies the rcssserver program (default: rcssserver)"
+   echo "  --cpus LIST                  splits the CPUs in LIST (e.g. 0-11) between the two teams"
+   echo "  --report-misses              reports the missed play_on cycles of each player after each game") 1>&2
+}
+
+while [ $# -gt 0 ]
+do
+  case $1 in
+
+    --help)
+      usage
+      exit 0
+      ;;
+
+    -l|--left)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      left_dir="${2}"
+      shift 1
+      ;;
+
+    -r|--right)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      right_dir="${2}"
+      shift 1
+      ;;
+
+    --left-name)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      left_name="${2}"
+      shift 1
+      ;;
+
+    --right-name)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      right_name="${2}"
+      shift 1
+      ;;
+
+    --left-opt)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      left_opt="${2}"
+      shift 1
+      ;;
+
+    --right-opt)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      right_opt="${2}"
+      shift 1
+      ;;
+
+    -p|--port)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      port="${2}"
+      shift 1
+      ;;
+
+    -s|--seed)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      seed="${2}"
+      shift 1
+      ;;
+
+    -g|--games)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      games="${2}"
+      shift 1
+      ;;
+
+    --half-time)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      half_time="${2}"
+      shift 1
+      ;;
+
+    --log-dir)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      log_dir="${2}"
+      shift 1
+      ;;
+
+    --server)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      server="${2}"
+      shift 1
+      ;;
+
+    --cpus)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      cpu_list="${2}"
+      shift 1
+      ;;
+
+    --report-misses)
+      report_misses="true"
+      ;;
+
+    *)
+      echo 1>&2
+      echo "invalid option \"${1}\"." 1>&2
+      echo 1>&2
+      usage
+      exit 1
+      ;;
+  esac
+
+  shift 1
+done
+
+if [ X"${left_name}" = X"${right_name}" ]; then
+  echo "the left and right team names must be different." 1>&2
+  exit 1
+fi
+
+if [ ! -x "${left_dir}/start.sh" ]; then
+  echo "${left_dir}/start.sh is not found." 1>&2
+  exit 1
+fi
+
+if [ ! -x "${right_dir}/start.sh" ]; then
+  echo "${right_dir}/start.sh is not found." 1>&2
+  exit 1
+fi
+
+mkdir -p "${log_dir}" || exit 1
+
+left_cpu_opt=""
+right_cpu_opt=""
+if [ X"${cpu_list}" != X'' ]; then
+  cpus=`echo "${cpu_list}" | tr ',' '\n' | while read r; do
+    case "${r}" in
+      *-*) seq "${r%-*}" "${r#*-}" ;;
+      *) echo "${r}" ;;
+    esac
+  done`
+  cpu_count=`echo "${cpus}" | wc -l`
+  left_count=`expr \( ${cpu_count} + 1 \) / 2`
+  left_cpus=`echo "${cpus}" | head -n ${left_count} | paste -s -d, -`
+  right_cpus=`echo "${cpus}" | tail -n +\`expr ${left_count} + 1\` | paste -s -d, -`
+  if [ X"${right_cpus}" = X'' ]; then
+    right_cpus="${left_cpus}"
+  fi
+  left_cpu_opt="--cpus ${left_cpus}"
+  right_cpu_opt="--cpus ${right_cpus}"
+  echo "left cpus=${left_cpus} right cpus=${right_cpus}"
+fi
+
+#
+# prints the missed play_on cycles of each telemetry file in the directory,
+# counted in the same way as scripts/telemetry/analyze_telemetry.py.
+#
+print_misses()
+{
+  for f in "${1}"/*.telemetry; do
+    [ -f "${f}" ] || continue
+    awk -v name="`basename "${f}" .telemetry`" -v last=-1 '
+      /^#/ { next }
+      NF == 8 {
+        if ( $2 == "0" && $3 == "1" ) {
+          if ( last >= 0 && $1 > last + 1 ) missed += $1 - last - 1
+          last = $1
+        } else {
+          last = -1
+        }
+      }
+      END { printf "%s=%d ", name, missed }' "${f}"
+  done
+}
+
+coach_port=`expr ${port} + 1`
+olcoach_port=`expr ${port} + 2`
+
+left_win=0
+right_win=0
+draw=0
+
+game=1
+while [ $game -le $games ] ; do
+  game_seed=`expr ${seed} + ${game} - 1`
+  game_log_dir="${log_dir}/seed-${game_seed}"
+  mkdir -p "${game_log_dir}" || exit 1
+
+  serveropt="server::port=${port} server::coach_port=${coach_port} server::olcoach_port=${olcoach_port}"
+  serveropt="${serveropt} server::synch_mode=true server::auto_mode=true"
+  serveropt="${serveropt} server::random_seed=${game_seed}"
+  serveropt="${serveropt} server::half_time=${half_time} server::nr_extra_halfs=0 server::penalty_shoot_outs=false"
+  serveropt="${serveropt} server::connect_wait=1000 server::kick_off_wait=100 server::game_over_wait=10"
+  serveropt="${serveropt} server::game_log_dir=${game_log_dir} server::text_log_dir=${game_log_dir}"
+  serveropt="${serveropt} server::keepaway_log_dir=${game_log_dir}"
+
+  ${server} ${serveropt} > "${game_log_dir}/server.out" 2>&1 &
+  server_pid=$!
+  sleep 1
+
+  left_misses_opt=""
+  right_misses_opt=""
+  if [ "${report_misses}" = "true" ]; then
+    # start.sh runs in the team directory
+    abs_game_log_dir=`cd "${game_log_dir}" && pwd`
+    left_misses_opt="--telemetry-dir ${abs_game_log_dir}/telemetry-left"
+    right_misses_opt="--telemetry-dir ${abs_game_log_dir}/telemetry-right"
+  fi
+
+  # start.sh --wait returns after its players and coach have exited.
+  # the left team connects first and gets the left side.
+  (cd "${left_dir}" && ./start.sh --wait -t ${left_name} -p ${port} -P ${olcoach_port} ${left_cpu_opt} ${left_misses_opt} ${left_opt} > /dev/null 2>&1) &
+  left_pid=$!
+  sleep 1
+  (cd "${right_dir}" && ./start.sh --wait -t ${right_name} -p ${port} -P ${olcoach_port} ${right_cpu_opt} ${right_misses_opt} ${right_opt} > /dev/null 2>&1) &
+  right_pid=$!
+
+  wait ${server_pid}
+
+  # wait for the clients to exit. they write the rest of the telemetry
+  # files when they exit.
+  wait ${left_pid} ${right_pid}
+
+  if [ "${report_misses}" = "true" ]; then
+    echo "game ${game} missed cycles: `print_misses "${game_log_dir}/telemetry-left"`"
+    echo "game ${game} missed cycles: `print_misses "${game_log_dir}/telemetry-right"`"
+  fi
+
+  # rcssserver names the game log YYYYMMDDhhmmss-LEFTNAME_SCORE-vs-RIGHTNAME_SCORE.rcg
+  rcg=`ls "${game_log_dir}"/*.rcg 2> /dev/null | head -n 1`
+  if [ X"${rcg}" = X'' ]; then
+    echo "game ${game} seed=${game_seed}: no game log." 1>&2
+  else
+    result=`basename "${rcg}" .rcg | sed -e 's/^[0-9]*-//'`
+    left_score=`echo "${result}" | sed -e 's/^.*_\([0-9]*\)-vs-.*$/\1/'`
+    right_score=`echo "${result}" | sed -e 's/^.*-vs-.*_\([0-9]*\)$/\1/'`
+    echo "game ${game} seed=${game_seed}: ${result}"
+
+    if [ ${left_score} -gt ${right_score} ]; then
+      left_win=`expr ${left_win} + 1`
+    elif [ ${left_score} -lt ${right_score} ]; then
+      right_win=`expr ${right_win} + 1`
+    else
+      draw=`expr ${draw} + 1`
+    fi
+  fi
+
+  game=`expr $game + 1`
+done
+
+echo "left win=${left_win} draw=${draw} right win=${right_win}"
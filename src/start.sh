@@ -60,6 +60,15 @@ coachdebug=""
 offline_logging=""
 offline_mode=""
 fullstateopt=""
+formationopt=""
+use_team_shm="false"
+data_extractor_dir=""
+telemetry_dir=""
+speculativeopt=""
+worker_threads=""
+cpu_list=""
+numa_node=""
+wait_clients="false"
 
 usage()
 {
@@ -74,6 +83,18 @@ usage()
    echo "  -u, --unum UNUM              specifies the uniform number of players"
    echo "  -C, --without-coach          specifies not to run the coach"
    echo "  -f, --formation DIR          specifies the formation directory"
+   echo "  --formation-hot-reload       reloads modified formation files during set plays"
+   echo "  --team-shm                   shares team level results between players on this host"
+   echo "                               (local test matches only)"
+   echo "  --data-extractor-dir DIR     writes the pass decisions for the unmark model training into DIR"
+   echo "  --telemetry-dir DIR          writes one planner record per decision cycle into DIR"
+   echo "  --speculative-planning       reuses the action chain during multi-kick actions"
+   echo "  --worker-threads NUMBER      specifies the worker threads of each player (-1: from the CPU affinity)"
+   echo "  --cpus LIST                  pins the players and the coach to the CPUs in LIST (e.g. 0-5 or 0,2,4)"
+   echo "                               one CPU per process in the launch order, reused cyclically"
+   echo "  --numa-node NODE             binds all processes to the CPUs and the memory of NUMA node NODE"
+   echo "  --launch-interval SECONDS    waits SECONDS between the field players (default: 0)"
+   echo "  --wait                       returns after all players and the coach have exited"
    echo "  --team-graphic FILE          specifies the team graphic xpm file"
    echo "  --offline-logging            writes offline client log (default: off)"
    echo "  --offline-client-mode        starts as an offline client (default: off)"
@@ -167,6 +188,76 @@ do
       shift 1
       ;;
 
+    --formation-hot-reload)
+      formationopt="--formation-hot-reload"
+      ;;
+
+    --team-shm)
+      use_team_shm="true"
+      ;;
+
+    --data-extractor-dir)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      data_extractor_dir="${2}"
+      shift 1
+      ;;
+
+    --telemetry-dir)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      telemetry_dir="${2}"
+      shift 1
+      ;;
+
+    --speculative-planning)
+      speculativeopt="--speculative-planning"
+      ;;
+
+    --worker-threads)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      worker_threads="${2}"
+      shift 1
+      ;;
+
+    --cpus)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      cpu_list="${2}"
+      shift 1
+      ;;
+
+    --numa-node)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      numa_node="${2}"
+      shift 1
+      ;;
+
+    --launch-interval)
+      if [ $# -lt 2 ]; then
+        usage
+        exit 1
+      fi
+      sleeptime="${2}"
+      shift 1
+      ;;
+
+    --wait)
+      wait_clients="true"
+      ;;
+
     --team-graphic)
       if [ $# -lt 2 ]; then
         usage
@@ -302,6 +393,47 @@ if  [ X"${offline_logging}" != X'' ]; then
   fi
 fi
 
+if [ X"${cpu_list}" != X'' ]; then
+  if [ X"${numa_node}" != X'' ]; then
+    echo "'--cpus' and '--numa-node' cannot be used simultaneously." 1>&2
+    exit 1
+  fi
+  if ! command -v taskset > /dev/null 2>&1; then
+    echo "taskset is not found. '--cpus' requires util-linux." 1>&2
+    exit 1
+  fi
+  # expand the ranges into a space separated list
+  cpu_list=`echo "${cpu_list}" | tr ',' '\n' | while read r; do
+    case "${r}" in
+      *-*) seq "${r%-*}" "${r#*-}" ;;
+      *) echo "${r}" ;;
+    esac
+  done | tr '\n' ' '`
+fi
+
+if [ X"${numa_node}" != X'' ]; then
+  if ! command -v numactl > /dev/null 2>&1; then
+    echo "numactl is not found. '--numa-node' requires numactl." 1>&2
+    exit 1
+  fi
+fi
+
+#
+# prints the command prefix that places the process of the given index.
+# the goalie is 0, the field players are 1-10 and the coach is ${number}.
+#
+pin_prefix()
+{
+  index=`expr "$@"`
+  if [ X"${numa_node}" != X'' ]; then
+    echo "numactl --cpunodebind=${numa_node} --membind=${numa_node}"
+  elif [ X"${cpu_list}" != X'' ]; then
+    set -- ${cpu_list}
+    shift `expr ${index} % $#`
+    echo "taskset -c ${1}"
+  fi
+}
+
 if [ X"${coach_port}" = X'' ]; then
   coach_port=`expr ${port} + 2`
 fi
@@ -317,6 +449,22 @@ fi
 opt="--player-config ${player_conf} --config_dir ${config_dir}"
 opt="${opt} -h ${host} -p ${port} -t ${teamname}"
 opt="${opt} ${fullstateopt}"
+opt="${opt} ${formationopt}"
+opt="${opt} ${speculativeopt}"
+if [ X"${worker_threads}" != X'' ]; then
+  opt="${opt} --worker-threads ${worker_threads}"
+fi
+if [ "${use_team_shm}" = "true" ]; then
+  opt="${opt} --team-shm ${teamname}-${port}"
+fi
+if [ X"${data_extractor_dir}" != X'' ]; then
+  mkdir -p "${data_extractor_dir}" || exit 1
+  opt="${opt} --data-extractor-dir ${data_extractor_dir}"
+fi
+if [ X"${telemetry_dir}" != X'' ]; then
+  mkdir -p "${telemetry_dir}" || exit 1
+  opt="${opt} --telemetry-dir ${telemetry_dir}"
+fi
 opt="${opt} --debug_server_host ${debug_server_host}"
 opt="${opt} --debug_server_port ${debug_server_port}"
 opt="${opt} ${offline_logging}"
@@ -329,14 +477,14 @@ if [ $number -gt 0 ]; then
   if  [ X"${offline_mode}" != X'' ]; then
     offline_number="--offline_client_number 1"
     if [ $unum -eq 0 ]; then
-      $player ${opt} -g ${offline_number} &
+      `pin_prefix 0` $player ${opt} -g ${offline_number} &
       $sleepprog $goaliesleep
     elif [ $unum -eq 1 ]; then
-      $player ${opt} -g ${offline_number} &
+      `pin_prefix 0` $player ${opt} -g ${offline_number} &
       $sleepprog $goaliesleep
     fi
   else
-    $player ${opt} -g &
+    `pin_prefix 0` $player ${opt} -g &
     $sleepprog $goaliesleep
   fi
 fi
@@ -347,14 +495,14 @@ while [ $i -le ${number} ] ; do
   if  [ X"${offline_mode}" != X'' ]; then
     offline_number="--offline_client_number ${i}"
     if [ $unum -eq 0 ]; then
-      $player ${opt} ${offline_number} &
+      `pin_prefix ${i} - 1` $player ${opt} ${offline_number} &
       $sleepprog $sleeptime
     elif [ $unum -eq $i ]; then
-      $player ${opt} ${offline_number} &
+      `pin_prefix ${i} - 1` $player ${opt} ${offline_number} &
       $sleepprog $sleeptime
     fi
   else
-    $player ${opt} &
+    `pin_prefix ${i} - 1` $player ${opt} &
     $sleepprog $sleeptime
   fi
 
@@ -374,11 +522,15 @@ if [ "${usecoach}" = "true" ]; then
   if  [ X"${offline_mode}" != X'' ]; then
     offline_mode="--offline_client_mode"
     if [ $unum -eq 0 ]; then
-      $coach ${coachopt} ${offline_mode} &
+      `pin_prefix ${number}` $coach ${coachopt} ${offline_mode} &
     elif [ $unum -eq 12 ]; then
-      $coach ${coachopt} ${offline_mode} &
+      `pin_prefix ${number}` $coach ${coachopt} ${offline_mode} &
     fi
   else
-    $coach ${coachopt} &
+    `pin_prefix ${number}` $coach ${coachopt} &
   fi
 fi
+
+if [ "${wait_clients}" = "true" ]; then
+  wait
+fi
@@ -41,6 +41,9 @@
 #include <rcsc/param/cmd_line_parser.h>
 #include <rcsc/random.h>
 
+#include <iostream>
+#include <algorithm>
+
 using namespace rcsc;
 
 /*-------------------------------------------------------------------*/
@@ -48,7 +51,14 @@ using namespace rcsc;
 
  */
 SampleTrainer::SampleTrainer()
-    : TrainerAgent()
+    : TrainerAgent(),
+      M_keepaway_episodes( 0 ),
+      M_keepaway_result_dir(),
+      M_episode_count( 0 ),
+      M_episode_start_cycle( -1 ),
+      M_episode_length_sum( 0 ),
+      M_episode_length_min( 0 ),
+      M_episode_length_max( 0 )
 {
 
 }
@@ -82,6 +92,15 @@ SampleTrainer::initImpl( CmdLineParser & cmd_parser )
     cmd_parser.parse( my_params );
 #endif
 
+    ParamMap keepaway_params( "Keepaway benchmark options" );
+    keepaway_params.add()
+        ( "keepaway-episodes", "", &M_keepaway_episodes,
+          "the number of keepaway episodes. the match is finished after the last episode. 0 means unlimited." )
+        ( "keepaway-benchmark-dir", "", &M_keepaway_result_dir,
+          "write the keepaway episode results into the directory." );
+
+    cmd_parser.parse( keepaway_params );
+
     if ( cmd_parser.failed() )
     {
         std::cerr << "coach: ***WARNING*** detected unsupported options: ";
@@ -98,6 +117,12 @@ SampleTrainer::initImpl( CmdLineParser & cmd_parser )
     // Add your code here.
     //////////////////////////////////////////////////////////////////
 
+    if ( ! M_keepaway_result_dir.empty()
+         && ! openKeepawayResult() )
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -310,11 +335,95 @@ SampleTrainer::doSubstitute()
 void
 SampleTrainer::doKeepaway()
 {
-    if ( world().trainingTime() == world().time() )
+    if ( M_episode_start_cycle < 0 )
+    {
+        if ( world().gameMode().type() == GameMode::PlayOn )
+        {
+            M_episode_start_cycle = world().time().cycle();
+        }
+        return;
+    }
+
+    if ( world().trainingTime() != world().time() )
     {
-        std::cerr << "trainer: "
-                  << world().time()
-                  << " keepaway training time." << std::endl;
+        return;
+    }
+
+    //
+    // the server has reset the episode in this cycle
+    //
+
+    const long length = world().time().cycle() - M_episode_start_cycle;
+
+    ++M_episode_count;
+    M_episode_length_sum += length;
+    M_episode_length_min = ( M_episode_count == 1
+                             ? length
+                             : std::min( M_episode_length_min, length ) );
+    M_episode_length_max = std::max( M_episode_length_max, length );
+
+    std::cerr << "trainer: "
+              << world().time()
+              << " keepaway episode " << M_episode_count
+              << " length=" << length << std::endl;
+
+    if ( M_keepaway_result.is_open() )
+    {
+        M_keepaway_result << M_episode_count << ' '
+                          << M_episode_start_cycle << ' '
+                          << world().time().cycle() << ' '
+                          << length << std::endl;
+    }
+
+    M_episode_start_cycle = world().time().cycle();
+
+    if ( M_keepaway_episodes > 0
+         && M_episode_count >= M_keepaway_episodes )
+    {
+        writeKeepawaySummary();
+        doChangeMode( PM_TimeOver );
+        M_client->setServerAlive( false );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SampleTrainer::openKeepawayResult()
+{
+    const std::string path = M_keepaway_result_dir + "/episodes.txt";
+
+    M_keepaway_result.open( path.c_str() );
+    if ( ! M_keepaway_result.is_open() )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " could not open the keepaway result file [" << path << ']'
+                  << std::endl;
+        return false;
+    }
+
+    M_keepaway_result << "# episode start_cycle end_cycle length" << std::endl;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SampleTrainer::writeKeepawaySummary()
+{
+    if ( ! M_keepaway_result.is_open()
+         || M_episode_count == 0 )
+    {
+        return;
     }
 
+    M_keepaway_result << "# episodes " << M_episode_count
+                      << " mean " << static_cast< double >( M_episode_length_sum ) / M_episode_count
+                      << " min " << M_episode_length_min
+                      << " max " << M_episode_length_max
+                      << std::endl;
 }
@@ -29,10 +29,29 @@
 
 #include <rcsc/trainer/trainer_agent.h>
 
+#include <fstream>
+#include <string>
+
 class SampleTrainer
     : public rcsc::TrainerAgent {
 private:
 
+    //
+    // keepaway benchmark
+    //
+
+    //! the number of episodes to run. 0 means unlimited.
+    int M_keepaway_episodes;
+    //! result directory. the benchmark is disabled if empty.
+    std::string M_keepaway_result_dir;
+    std::ofstream M_keepaway_result;
+
+    int M_episode_count;
+    long M_episode_start_cycle;
+    long M_episode_length_sum;
+    long M_episode_length_min;
+    long M_episode_length_max;
+
 public:
 
     SampleTrainer();
@@ -69,6 +88,9 @@ private:
     void doSubstitute();
     void doKeepaway();
 
+    bool openKeepawayResult();
+    void writeKeepawaySummary();
+
 };
 
 #endif